@@ -17,7 +17,9 @@ layout (binding = 0) uniform UniformObject {
     mat4 projection;
     mat4 view;
     vec3 cameraPos;
-    int lightsCount;
+    uint directionalCount;
+    uvec4 clusterSize;
+    vec4 clusterParams;
 } ubo;
 
 layout (push_constant) uniform PushObject {
@@ -48,7 +50,31 @@ layout (binding = 1) buffer BufferLights {
     Light lights[];
 } bufferLights;
 
-layout (binding = 2) uniform sampler2D textures[];
+// Offset and count pair per cluster, followed by the light indices
+layout (binding = 2) readonly buffer BufferClusters {
+    uint data[];
+} bufferClusters;
+
+layout (binding = 3) uniform sampler2D textures[];
+
+// Finds the froxel of the fragment, must match the grid built on the CPU.
+uint GetClusterIndex(vec3 fragPos) {
+    vec4 viewPos = ubo.view * vec4(fragPos, 1.0);
+    vec4 clipPos = ubo.projection * viewPos;
+    vec2 ndc = clipPos.xy / clipPos.w;
+
+    float depth = -viewPos.z;
+    float slice;
+    if (ubo.clusterParams.z > 0.0) {
+        slice = (depth - ubo.clusterParams.x) * ubo.clusterParams.y;
+    } else {
+        slice = log(max(depth, ubo.clusterParams.x) / ubo.clusterParams.x) * ubo.clusterParams.y;
+    }
+
+    ivec3 cluster = ivec3(floor(vec3((ndc * 0.5 + 0.5) * vec2(ubo.clusterSize.xy), slice)));
+    cluster = clamp(cluster, ivec3(0), ivec3(ubo.clusterSize.xyz) - 1);
+    return (uint(cluster.z) * ubo.clusterSize.y + uint(cluster.y)) * ubo.clusterSize.x + uint(cluster.x);
+}
 
 // Calculates the color when using a directional light.
 vec3 CalcDirLight(Light light, vec3 baseDiffuse, vec3 baseSpecular, vec3 normal, vec3 viewDir) {
@@ -182,13 +208,19 @@ void main() {
     // Directional lighting
     vec3 result = vec3(0.0);
 
-    // Point lights
-    for (uint i = 0; i < ubo.lightsCount; ++i) {
-        Light light = bufferLights.lights[i];
+    for (uint i = 0; i < ubo.directionalCount; ++i) {
+        result += CalcDirLight(bufferLights.lights[i], diffuse, specular, normal, viewDir);
+    }
+
+    // Point and spot lights of the cluster
+    uint cluster = GetClusterIndex(inPosition);
+    uint offset = bufferClusters.data[2 * cluster];
+    uint count = bufferClusters.data[2 * cluster + 1];
+
+    for (uint i = 0; i < count; ++i) {
+        Light light = bufferLights.lights[bufferClusters.data[offset + i]];
         if (dot(light.direction, light.direction) == 0.0) {
             result += CalcPointLight(light, diffuse, specular, normal, inPosition, viewDir);
-        } else if (light.cutOff < 0.0f && light.outerCutOff < 0.0f) {
-            result += CalcDirLight(light, diffuse, specular, normal, viewDir);
         } else {
             result += CalcSpotLight(light, diffuse, specular, normal, inPosition, viewDir);
         }
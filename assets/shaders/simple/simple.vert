@@ -18,7 +18,9 @@ layout (binding = 0) uniform UniformObject {
     mat4 projection;
     mat4 view;
     vec3 cameraPos;
-    uint lightsCount;
+    uint directionalCount;
+    uvec4 clusterSize;
+    vec4 clusterParams;
 } ubo;
 
 layout (push_constant) uniform PushObject {
@@ -0,0 +1,399 @@
+#include "bench_application.h"
+#include "bench_renderer.h"
+#include "micro_benchmarks.h"
+
+#include "fusion/core/engine.h"
+#include "fusion/graphics/graphics.h"
+#include "fusion/scene/components.h"
+#include "fusion/scene/scene_manager.h"
+#include "fusion/filesystem/file_system.h"
+
+#include <random>
+
+using namespace fe;
+
+struct FrameStatistics {
+    float mean{ 0.0f };
+    float min{ 0.0f };
+    float p50{ 0.0f };
+    float p95{ 0.0f };
+    float p99{ 0.0f };
+    float max{ 0.0f };
+
+    template<typename Archive>
+    void serialize(Archive& archive) {
+        archive(cereal::make_nvp("mean", mean));
+        archive(cereal::make_nvp("min", min));
+        archive(cereal::make_nvp("p50", p50));
+        archive(cereal::make_nvp("p95", p95));
+        archive(cereal::make_nvp("p99", p99));
+        archive(cereal::make_nvp("max", max));
+    }
+};
+
+static FrameStatistics CalculateStatistics(std::vector<float> values) {
+    FrameStatistics statistics;
+    if (values.empty())
+        return statistics;
+
+    std::sort(values.begin(), values.end());
+
+    // Nearest rank percentile
+    auto percentile = [&values](float p) {
+        auto rank = static_cast<size_t>(std::ceil(p * static_cast<float>(values.size())));
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    };
+
+    float sum = 0.0f;
+    for (auto value : values) {
+        sum += value;
+    }
+
+    statistics.mean = sum / static_cast<float>(values.size());
+    statistics.min = values.front();
+    statistics.p50 = percentile(0.50f);
+    statistics.p95 = percentile(0.95f);
+    statistics.p99 = percentile(0.99f);
+    statistics.max = values.back();
+    return statistics;
+}
+
+static std::unique_ptr<Mesh> CreateCube() {
+    // Follows the model layout
+    struct CubeVertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec3 tangent;
+        glm::vec3 bitangent;
+        glm::vec2 uv;
+    };
+    FE_ASSERT(sizeof(CubeVertex) == Model::GetLayout().getStride());
+
+    static const std::array<std::pair<glm::vec3, glm::vec3>, 6> faces = {{
+        { vec3::right, vec3::back },
+        { vec3::left, vec3::forward },
+        { vec3::up, vec3::right },
+        { vec3::down, vec3::right },
+        { vec3::forward, vec3::right },
+        { vec3::back, vec3::left },
+    }};
+
+    std::vector<CubeVertex> vertices;
+    std::vector<uint16_t> indices;
+    vertices.reserve(faces.size() * 4);
+    indices.reserve(faces.size() * 6);
+
+    for (const auto& [normal, tangent] : faces) {
+        // Corners go counter-clockwise around the normal
+        auto bitangent = glm::cross(normal, tangent);
+        auto first = static_cast<uint16_t>(vertices.size());
+
+        for (const auto& uv : { glm::vec2{0.0f, 0.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}, glm::vec2{0.0f, 1.0f} }) {
+            auto position = normal * 0.5f + tangent * (uv.x - 0.5f) + bitangent * (uv.y - 0.5f);
+            vertices.push_back({ position, normal, tangent, bitangent, uv });
+        }
+
+        for (uint16_t index : { 0, 1, 2, 2, 3, 0 }) {
+            indices.push_back(static_cast<uint16_t>(first + index));
+        }
+    }
+
+    std::vector<uint8_t> bytes(vertices.size() * sizeof(CubeVertex));
+    std::memcpy(bytes.data(), vertices.data(), bytes.size());
+
+    auto mesh = std::make_unique<Mesh>();
+    mesh->setVertices(bytes, sizeof(CubeVertex));
+    mesh->setIndices(indices);
+    return mesh;
+}
+
+BenchApplication::BenchApplication(std::string_view name) : DefaultApplication{name} {
+
+}
+
+BenchApplication::~BenchApplication() {
+
+}
+
+void BenchApplication::onStart() {
+    DefaultApplication::onStart();
+
+    Graphics::Get()->setRenderer(std::make_unique<BenchRenderer>());
+
+    warmupFrames = getCount("--warmup", warmupFrames);
+    benchFrames = std::max(getCount("--frames", benchFrames), 1U);
+
+    // Micro benchmarks measure a single system and quit without rendering
+    if (auto benchmark = getParameter("--benchmark")) {
+        runBenchmark(*benchmark);
+        Engine::Get()->requestClose();
+        return;
+    }
+
+    // Assets of a scene file are resolved through the project
+    auto project = getParameter("--project");
+    if (project)
+        openProject(*project);
+
+    if (auto scenePath = getParameter("--scene")) {
+        auto scene = std::make_unique<Scene>(fs::path{*scenePath}.stem().string());
+        scene->deserialise(*scenePath);
+        SceneManager::Get()->setScene(std::move(scene));
+    } else if (!project) {
+        auto scene = std::make_unique<Scene>("Stress Scene");
+        generateScene(*scene);
+        SceneManager::Get()->setScene(std::move(scene));
+    }
+
+    auto scene = SceneManager::Get()->getScene();
+    if (!scene) {
+        FE_LOG_ERROR("Benchmark has no scene to render");
+        Engine::Get()->requestClose();
+        return;
+    }
+
+    auto& registry = scene->getRegistry();
+
+    // Camera path orbits around the meshes
+    auto meshView = registry.view<const TransformComponent, const MeshComponent>();
+    if (meshView.begin() != meshView.end()) {
+        glm::vec3 min{ FLT_MAX };
+        glm::vec3 max{ -FLT_MAX };
+        for (const auto& [entity, transform, mesh] : meshView.each()) {
+            glm::vec3 position{ transform.getWorldMatrix()[3] };
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+        sceneCenter = (min + max) * 0.5f;
+        sceneRadius = std::max(glm::length(max - min) * 0.5f, 1.0f);
+    }
+
+    // Scene camera is replaced, so every run follows the same path
+    registry.clear<CameraComponent>();
+
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    float width = static_cast<float>(commandLineParser.getValue<int>("width", 1280));
+    float height = static_cast<float>(commandLineParser.getValue<int>("height", 720));
+
+    auto cameraEntity = registry.create();
+    registry.emplace<TransformComponent>(cameraEntity);
+    auto& camera = registry.emplace<CameraComponent>(cameraEntity);
+    camera.setAspectRatio(width / height);
+
+    FE_LOG_INFO("Benchmark: {} warmup and {} measured frames of '{}'", warmupFrames, benchFrames, scene->getName());
+
+    FrameTimings::SetEnabled(true);
+}
+
+void BenchApplication::onUpdate() {
+    auto now = DateTime::Now();
+
+    // Time accumulated since the last update belongs to the previous frame
+    bool measured = frame > warmupFrames;
+    if (measured)
+        frameTimes.push_back((now - lastFrameTime).asMilliseconds<float>());
+    for (size_t i = 0; i < FrameTimings::PhaseCount; ++i) {
+        auto time = FrameTimings::Exchange(static_cast<FrameTimings::Phase>(i));
+        if (measured)
+            phaseTimes[i].push_back(time);
+    }
+    lastFrameTime = now;
+
+    if (frameTimes.size() == benchFrames) {
+        writeResults();
+        Engine::Get()->requestClose();
+        return;
+    }
+
+    if (auto scene = SceneManager::Get()->getScene())
+        updateCamera(*scene);
+
+    ++frame;
+}
+
+void BenchApplication::generateScene(Scene& scene) {
+    auto meshCount = getCount("--meshes", 1000);
+    auto lightCount = getCount("--lights", 64);
+    auto textCount = getCount("--texts", 0);
+
+    // Same seed gives the same scene on every run
+    std::mt19937 random{ getCount("--seed", 1) };
+    std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+
+    auto& registry = scene.getRegistry();
+
+    std::vector<std::unique_ptr<Mesh>> meshes;
+    meshes.push_back(CreateCube());
+    cube = AssetRegistry::Get()->add(std::make_shared<Model>("Stress Cube", std::move(meshes)));
+
+    const float spacing = 3.0f;
+    auto side = static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<float>(std::max(meshCount, 1U)))));
+    auto offset = glm::vec3{ static_cast<float>(side - 1) * spacing * 0.5f };
+    auto gridPosition = [&](uint32_t index) {
+        glm::uvec3 cell{ index % side, (index / side) % side, index / (side * side) };
+        return glm::vec3{ cell } * spacing - offset;
+    };
+
+    for (uint32_t i = 0; i < meshCount; ++i) {
+        auto entity = registry.create();
+        auto rotation = glm::angleAxis(unit(random) * glm::two_pi<float>(), glm::normalize(glm::vec3{ unit(random), unit(random), unit(random) } + 0.01f));
+        registry.emplace<TransformComponent>(entity, gridPosition(i), rotation, vec3::one);
+        registry.emplace<MeshComponent>(entity, cube, 0U);
+        auto& material = registry.emplace<MaterialComponent>(entity);
+        material.baseColor = { unit(random), unit(random), unit(random) };
+    }
+
+    for (uint32_t i = 0; i < lightCount; ++i) {
+        auto entity = registry.create();
+        glm::vec3 position{ unit(random), unit(random), unit(random) };
+        registry.emplace<TransformComponent>(entity, (position - 0.5f) * offset * 2.0f, quat::identity, vec3::one);
+        auto& light = registry.emplace<LightComponent>(entity);
+        light.radius = spacing * 4.0f;
+        light.diffuse = { unit(random), unit(random), unit(random) };
+    }
+
+    if (textCount > 0) {
+        // Fonts are assets, so they need a project
+        AssetHandle<Font> font;
+        if (auto fontUuid = getParameter("--font")) {
+            if (auto uuid = uuids::uuid::from_string(*fontUuid))
+                font = AssetRegistry::Get()->resolve<Font>(*uuid);
+        }
+
+        if (!font) {
+            FE_LOG_WARNING("Benchmark texts need a font, pass --project and --font=<uuid>");
+        } else {
+            for (uint32_t i = 0; i < textCount; ++i) {
+                auto entity = registry.create();
+                registry.emplace<TransformComponent>(entity, gridPosition(i) + vec3::up * spacing * 0.5f, quat::identity, vec3::one);
+                auto& text = registry.emplace<TextComponent>(entity);
+                text.text = fmt::format("Entity {}", i);
+                text.font = font;
+            }
+        }
+    }
+
+    FE_LOG_INFO("Generated stress scene: {} meshes, {} lights, {} texts", meshCount, lightCount, textCount);
+}
+
+void BenchApplication::updateCamera(Scene& scene) {
+    auto& registry = scene.getRegistry();
+    auto view = registry.view<TransformComponent, CameraComponent>();
+    if (view.begin() == view.end())
+        return;
+
+    // Path only depends on the frame number, not on the frame time
+    float t = static_cast<float>(frame) / static_cast<float>(warmupFrames + benchFrames);
+    float angle = glm::two_pi<float>() * t;
+    float distance = sceneRadius * 1.25f;
+    glm::vec3 eyePoint{ glm::cos(angle) * distance, sceneRadius * (0.25f + 0.25f * glm::sin(angle * 2.0f)), glm::sin(angle) * distance };
+
+    auto& transform = view.get<TransformComponent>(view.front());
+    transform.setLocalPosition(sceneCenter + eyePoint);
+    transform.lookAt(sceneCenter, vec3::up);
+}
+
+void BenchApplication::writeResults() const {
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    auto resultPath = getResultPath();
+
+    auto scene = SceneManager::Get()->getScene();
+    const auto& registry = scene->getRegistry();
+
+    auto frameStatistics = CalculateStatistics(frameTimes);
+
+    std::stringstream ss;
+    {
+        // output finishes flushing its contents when it goes out of scope
+        cereal::JSONOutputArchive output{ss};
+        output(cereal::make_nvp("scene", scene->getName()));
+        output(cereal::make_nvp("meshes", static_cast<uint32_t>(registry.view<const MeshComponent>().size())));
+        output(cereal::make_nvp("lights", static_cast<uint32_t>(registry.view<const LightComponent>().size())));
+        output(cereal::make_nvp("texts", static_cast<uint32_t>(registry.view<const TextComponent>().size())));
+        output(cereal::make_nvp("warmupFrames", warmupFrames));
+        output(cereal::make_nvp("frames", benchFrames));
+        output(cereal::make_nvp("threadedRendering", Graphics::Get()->isThreadedRendering()));
+        output(cereal::make_nvp("frameTime", frameStatistics));
+
+        // Recording includes culling and descriptor updates of the subrenders
+        output.setNextName("phases");
+        output.startNode();
+        for (size_t i = 0; i < FrameTimings::PhaseCount; ++i) {
+            auto statistics = CalculateStatistics(phaseTimes[i]);
+            output(cereal::make_nvp(FrameTimings::GetName(static_cast<FrameTimings::Phase>(i)), statistics));
+        }
+        output.finishNode();
+
+        if (commandLineParser.isSet("benchmarkresultframes"))
+            output(cereal::make_nvp("frameTimes", frameTimes));
+    }
+
+    FileSystem::WriteText(resultPath, ss.str());
+
+    FE_LOG_INFO("Benchmark: frame time mean {}ms, p50 {}ms, p95 {}ms, p99 {}ms", frameStatistics.mean, frameStatistics.p50, frameStatistics.p95, frameStatistics.p99);
+    FE_LOG_INFO("Benchmark results written to: '{}'", resultPath);
+}
+
+void BenchApplication::runBenchmark(const std::string& name) {
+    std::stringstream ss;
+
+    if (name == "push") {
+        PushBenchmarkSettings settings;
+        settings.frames = benchFrames;
+        settings.pushes = std::max(getCount("--pushes", settings.pushes), 1U);
+        settings.pushSize = std::max(getCount("--push-size", settings.pushSize), 1U);
+        settings.changedPercent = std::min(getCount("--changed", settings.changedPercent), 100U);
+        settings.seed = getCount("--seed", settings.seed);
+
+        auto result = RunPushBenchmark(settings);
+        {
+            cereal::JSONOutputArchive output{ss};
+            output(cereal::make_nvp("benchmark", name));
+            output(cereal::make_nvp("settings", settings));
+            output(cereal::make_nvp("result", result));
+        }
+
+        FE_LOG_INFO("Benchmark: compare and copy {} pushes/s, shadow buffer {} pushes/s", result.compareCopy.pushesPerSecond, result.shadowBuffer.pushesPerSecond);
+    } else if (name == "scan") {
+        ScanBenchmarkSettings settings;
+        auto directory = getParameter("--scan-dir");
+        settings.directory = directory ? fs::path{*directory} : fs::temp_directory_path() / "fusion-scan-bench";
+        settings.files = getCount("--files", settings.files);
+        settings.runs = std::max(getCount("--runs", settings.runs), 1U);
+
+        auto result = RunScanBenchmark(settings);
+        {
+            cereal::JSONOutputArchive output{ss};
+            output(cereal::make_nvp("benchmark", name));
+            output(cereal::make_nvp("settings", settings));
+            output(cereal::make_nvp("result", result));
+        }
+
+        FE_LOG_INFO("Benchmark: first open serial {}ms, parallel {}ms", result.serial.firstOpen, result.parallel.firstOpen);
+    } else {
+        FE_LOG_ERROR("Unknown benchmark: '{}'", name);
+        return;
+    }
+
+    auto resultPath = getResultPath();
+    FileSystem::WriteText(resultPath, ss.str());
+    FE_LOG_INFO("Benchmark results written to: '{}'", resultPath);
+}
+
+fs::path BenchApplication::getResultPath() const {
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    return commandLineParser.getValue<std::string>("benchmarkresultfile", "fusion-bench.json");
+}
+
+std::optional<std::string> BenchApplication::getParameter(const std::string& name) const {
+    auto parameter = Engine::Get()->getCommandLineArgs().getParameter(name);
+    if (parameter && parameter->empty())
+        return std::nullopt;
+    return parameter;
+}
+
+uint32_t BenchApplication::getCount(const std::string& name, uint32_t defaultValue) const {
+    if (auto parameter = getParameter(name))
+        return static_cast<uint32_t>(std::strtoul(parameter->c_str(), nullptr, 10));
+    return defaultValue;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "fusion/core/default_application.h"
+#include "fusion/core/frame_timings.h"
+#include "fusion/assets/asset_handle.h"
+
+namespace fe {
+    class Model;
+    /**
+     * @brief Renders a scene along a fixed camera path and writes CPU timings of the frames as JSON.
+     * The scene is loaded from a project or a scene file, or generated with the given number of meshes, lights and texts.
+     */
+    class BenchApplication : public DefaultApplication {
+    public:
+        explicit BenchApplication(std::string_view name);
+        ~BenchApplication() override;
+
+    private:
+        void onStart() override;
+        void onUpdate() override;
+
+        void generateScene(Scene& scene);
+        void updateCamera(Scene& scene);
+        void writeResults() const;
+
+        /**
+         * Runs a micro benchmark of the --benchmark option instead of rendering frames.
+         * @param name The benchmark name.
+         */
+        void runBenchmark(const std::string& name);
+        fs::path getResultPath() const;
+
+        std::optional<std::string> getParameter(const std::string& name) const;
+        uint32_t getCount(const std::string& name, uint32_t defaultValue) const;
+
+        AssetHandle<Model> cube; /// Generated mesh of the stress scene, owned by the asset registry.
+        glm::vec3 sceneCenter{ 0.0f };
+        float sceneRadius{ 10.0f };
+
+        uint32_t warmupFrames{ 10 };
+        uint32_t benchFrames{ 300 };
+        uint32_t frame{ 0 };
+        DateTime lastFrameTime;
+        std::vector<float> frameTimes;
+        std::array<std::vector<float>, FrameTimings::PhaseCount> phaseTimes;
+    };
+}
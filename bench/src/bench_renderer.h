@@ -0,0 +1,35 @@
+#pragma once
+
+#include "fusion/graphics/renderer.h"
+#include "fusion/models/mesh_subrender.h"
+#include "fusion/ligthing/light_subrender.h"
+#include "fusion/text/text_subrender.h"
+
+namespace fe {
+    class BenchRenderer : public Renderer {
+    public:
+        BenchRenderer() {
+            std::vector<Attachment> renderpassAttachments = {
+                    {0, "depth", Attachment::Type::Depth},
+                    {1, "swapchain", Attachment::Type::Swapchain},
+            };
+            std::vector<SubpassType> renderpassSubpasses = {
+                    {0, {0, 1}}
+            };
+
+            addRenderStage(std::make_unique<RenderStage>(std::move(renderpassAttachments), std::move(renderpassSubpasses)));
+        }
+        ~BenchRenderer() override = default;
+
+    private:
+        void onStart() override {
+            addSubrender<MeshSubrender>({0, 0});
+            addSubrender<LightSubrender>({0, 0});
+            addSubrender<TextSubrender>({0, 0});
+        }
+
+        void onUpdate() override {
+
+        }
+    };
+}
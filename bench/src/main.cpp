@@ -0,0 +1,26 @@
+#include "platform/pc/pc_engine.h"
+
+#include "bench_application.h"
+
+int main(int args, char** argv) {
+    using namespace fe;
+
+    // Benchmarks run headless unless a window is asked for
+    std::vector<char*> arguments{ argv, argv + args };
+    bool windowed = std::any_of(arguments.begin(), arguments.end(), [](const char* argument) {
+        return std::string_view{argument} == "--windowed";
+    });
+    char headless[] = "--headless";
+    if (!windowed)
+        arguments.push_back(headless);
+
+    // Creates the engine
+    pc::Engine engine{{static_cast<int>(arguments.size()), arguments.data()}};
+
+    // Sets the application to the engine
+    engine.setApp(std::make_unique<BenchApplication>("Fusion Bench"));
+
+    // Runs the game loop
+    auto result = engine.run();
+    return result;
+}
@@ -0,0 +1,223 @@
+#include "micro_benchmarks.h"
+
+#include "fusion/graphics/buffers/uniform_buffer.h"
+#include "fusion/graphics/buffers/shadow_buffer.h"
+#include "fusion/assets/asset_registry.h"
+#include "fusion/core/engine.h"
+#include "fusion/filesystem/file_system.h"
+
+#include <random>
+
+using namespace fe;
+
+/**
+ * Runs a push path over the same changes, the values are updated outside of the measured time.
+ * @param settings The workload.
+ * @param values The uniform values, changed before every frame.
+ * @param push Writes the uniforms of a frame.
+ * @return The timings of the path.
+ */
+template<typename Function>
+static PushTimings MeasurePushes(const PushBenchmarkSettings& settings, std::vector<uint8_t>& values, Function&& push) {
+    std::mt19937 random{ settings.seed };
+    std::uniform_int_distribution<uint32_t> pick{ 0, settings.pushes - 1 };
+    auto changedCount = settings.pushes * settings.changedPercent / 100;
+
+    float time = 0.0f;
+    for (uint32_t frame = 0; frame < settings.frames; ++frame) {
+        for (uint32_t i = 0; i < changedCount; ++i) {
+            auto value = values.data() + static_cast<size_t>(pick(random)) * settings.pushSize;
+            ++*value;
+        }
+
+        auto start = DateTime::Now();
+        push();
+        time += (DateTime::Now() - start).asSeconds<float>();
+    }
+
+    PushTimings timings;
+    timings.time = time;
+    timings.pushesPerSecond = time > 0.0f ? static_cast<float>(settings.frames) * static_cast<float>(settings.pushes) / time : 0.0f;
+    return timings;
+}
+
+PushBenchmarkResult fe::RunPushBenchmark(const PushBenchmarkSettings& settings) {
+    PushBenchmarkResult result;
+    if (settings.pushes == 0 || settings.pushSize == 0)
+        return result;
+
+    auto blockSize = static_cast<size_t>(settings.pushes) * settings.pushSize;
+    std::vector<uint8_t> initial(blockSize);
+    for (auto&& [index, value] : enumerate(initial)) {
+        value = static_cast<uint8_t>(index * 31);
+    }
+
+    {
+        // Path before the shadow copy, every write reads the mapped memory back
+        std::vector<uint8_t> values{ initial };
+        UniformBuffer buffer{ static_cast<VkDeviceSize>(blockSize), values.data() };
+        buffer.map();
+
+        result.compareCopy = MeasurePushes(settings, values, [&] {
+            for (uint32_t i = 0; i < settings.pushes; ++i) {
+                auto offset = static_cast<size_t>(i) * settings.pushSize;
+                if (buffer.compare(values.data() + offset, settings.pushSize, offset) != 0)
+                    buffer.copy(values.data() + offset, settings.pushSize, offset);
+            }
+        });
+
+        buffer.unmap();
+    }
+
+    {
+        std::vector<uint8_t> values{ initial };
+        UniformBuffer buffer{ static_cast<VkDeviceSize>(blockSize), values.data() };
+        buffer.map();
+
+        ShadowBuffer shadow;
+        shadow.resize(blockSize);
+        shadow.write(values.data(), blockSize);
+        shadow.flush(buffer);
+
+        result.shadowBuffer = MeasurePushes(settings, values, [&] {
+            for (uint32_t i = 0; i < settings.pushes; ++i) {
+                auto offset = static_cast<size_t>(i) * settings.pushSize;
+                shadow.write(values.data() + offset, settings.pushSize, offset);
+            }
+            shadow.flush(buffer);
+        });
+
+        buffer.unmap();
+    }
+
+    return result;
+}
+
+static const uint32_t FILES_PER_DIRECTORY = 1000;
+
+static void GenerateTree(const fs::path& root, const std::vector<uuids::uuid>& ids) {
+    for (auto&& [index, uuid] : enumerate(ids)) {
+        fs::path directory{ root / "Assets" / fmt::format("folder_{}", index / FILES_PER_DIRECTORY) };
+        if (index % FILES_PER_DIRECTORY == 0)
+            fs::create_directories(directory);
+
+        fs::path filepath{ directory / fmt::format("texture_{}.png", index) };
+        fs::path metaPath{ filepath };
+        metaPath += ".meta";
+        FileSystem::WriteText(filepath, "");
+        FileSystem::WriteText(metaPath, uuids::to_string(uuid));
+    }
+}
+
+/**
+ * Opens a project the way the registry did before the parallel scan, every file is visited by the iterator in order
+ * and matched with the database one by one.
+ */
+static void SerialImport(const fs::path& root) {
+    AssetDatabase database{ root };
+
+    for (const auto& file : fs::recursive_directory_iterator(root)) {
+        if (!file.is_regular_file() || file.path().extension().string() != ".png")
+            continue;
+
+        const auto& filepath = file.path();
+        fs::path metaPath{ filepath };
+        metaPath += ".meta";
+        fs::path shortPath{ filepath.lexically_relative(root) };
+
+        if (fs::exists(metaPath)) {
+            auto uuid = uuids::uuid::from_string(FileSystem::ReadText(metaPath));
+            if (uuid.has_value()) {
+                auto path = database.getValue(*uuid);
+                if (!path.has_value())
+                    database.put(*uuid, shortPath);
+                else if (*path != shortPath)
+                    database.put(*uuid, shortPath, true);
+                continue;
+            }
+        }
+
+        auto uuid = database.getKey(shortPath);
+        if (uuid.has_value()) {
+            FileSystem::WriteText(metaPath, uuids::to_string(*uuid));
+        } else {
+            uuids::uuid id{ uuid_random_generator() };
+            FileSystem::WriteText(metaPath, uuids::to_string(id));
+            database.put(id, shortPath);
+        }
+    }
+}
+
+template<typename Function>
+static ScanTimings MeasureOpens(const ScanBenchmarkSettings& settings, Function&& open) {
+    ScanTimings timings;
+    for (uint32_t run = 0; run < settings.runs; ++run) {
+        auto start = DateTime::Now();
+        open();
+        auto time = (DateTime::Now() - start).asMilliseconds<float>();
+        if (run == 0)
+            timings.firstOpen = time;
+        else
+            timings.reopens.push_back(time);
+    }
+    return timings;
+}
+
+ScanBenchmarkResult fe::RunScanBenchmark(const ScanBenchmarkSettings& settings) {
+    ScanBenchmarkResult result;
+#if FUSION_VIRTUAL_FS
+    FE_LOG_ERROR("Scan benchmark needs the native file system");
+#else
+    if (settings.files == 0 || settings.runs == 0)
+        return result;
+
+    // Trees go into a new directory, so nothing which existed before is ever deleted
+    std::error_code error;
+    fs::path benchRoot;
+    fs::create_directories(settings.directory, error);
+    for (uint32_t attempt = 0; attempt < 16 && benchRoot.empty(); ++attempt) {
+        fs::path candidate{ settings.directory / fmt::format("fusion-scan-{}", uuids::to_string(uuid_random_generator())) };
+        if (fs::create_directory(candidate, error))
+            benchRoot = std::move(candidate);
+    }
+    if (benchRoot.empty()) {
+        FE_LOG_ERROR("Could not create a directory for the scan benchmark in '{}'", settings.directory);
+        return result;
+    }
+
+    fs::path serialRoot{ benchRoot / "serial" };
+    fs::path parallelRoot{ benchRoot / "parallel" };
+
+    // Both trees get the same uuids, so both paths do the same work
+    std::vector<uuids::uuid> ids(settings.files);
+    for (auto& id : ids) {
+        id = uuid_random_generator();
+    }
+
+    auto start = DateTime::Now();
+    GenerateTree(serialRoot, ids);
+    GenerateTree(parallelRoot, ids);
+    FE_LOG_INFO("Benchmark: generated {} files in {}ms", settings.files * 4, (DateTime::Now() - start).asMilliseconds());
+
+    result.serial = MeasureOpens(settings, [&] {
+        SerialImport(serialRoot);
+    });
+
+    auto& projectSettings = Engine::Get()->getApp()->getProjectSettings();
+    auto projectRoot = projectSettings.projectRoot;
+    projectSettings.projectRoot = parallelRoot;
+
+    result.parallel = MeasureOpens(settings, [] {
+        AssetRegistry::Get()->releaseAll();
+    });
+
+    // Registry, file watcher and database are pointed back to the opened project before the trees are deleted
+    projectSettings.projectRoot = projectRoot;
+    AssetRegistry::Get()->releaseAll();
+
+    fs::remove_all(benchRoot, error);
+    if (error)
+        FE_LOG_WARNING("Could not delete the scan benchmark trees in '{}': {}", benchRoot, error.message());
+#endif
+    return result;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace fe {
+    struct PushTimings {
+        float time{ 0.0f }; /// Seconds spent in the pushes and flushes.
+        float pushesPerSecond{ 0.0f };
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("time", time));
+            archive(cereal::make_nvp("pushesPerSecond", pushesPerSecond));
+        }
+    };
+
+    struct PushBenchmarkSettings {
+        uint32_t frames{ 300 };
+        uint32_t pushes{ 1024 }; /// Uniforms written per frame.
+        uint32_t pushSize{ 64 }; /// Size of a uniform in bytes.
+        uint32_t changedPercent{ 10 }; /// Part of the uniforms which have a new value each frame.
+        uint32_t seed{ 1 };
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("frames", frames));
+            archive(cereal::make_nvp("pushesPerFrame", pushes));
+            archive(cereal::make_nvp("pushSize", pushSize));
+            archive(cereal::make_nvp("changedPercent", changedPercent));
+        }
+    };
+
+    struct PushBenchmarkResult {
+        PushTimings compareCopy; /// Compare against the mapped memory and copy on every write.
+        PushTimings shadowBuffer; /// Compare against the CPU copy and flush the dirty ranges once per frame.
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("compareCopy", compareCopy));
+            archive(cereal::make_nvp("shadowBuffer", shadowBuffer));
+        }
+    };
+
+    struct ScanBenchmarkSettings {
+        fs::path directory; /// Directory which gets a new subdirectory for the generated trees, only that one is deleted.
+        uint32_t files{ 100000 };
+        uint32_t runs{ 3 }; /// First run opens the project with an empty database, the others reopen it.
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("files", files));
+            archive(cereal::make_nvp("runs", runs));
+        }
+    };
+
+    struct ScanTimings {
+        float firstOpen{ 0.0f }; /// Milliseconds of the open with an empty database.
+        std::vector<float> reopens; /// Milliseconds of the opens with a matching database.
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("firstOpen", firstOpen));
+            archive(cereal::make_nvp("reopens", reopens));
+        }
+    };
+
+    struct ScanBenchmarkResult {
+        ScanTimings serial; /// Recursive iteration and a database lookup and write per file.
+        ScanTimings parallel; /// Parallel scan, batched metadata reads and a single transaction of the asset registry.
+
+        template<typename Archive>
+        void serialize(Archive& archive) {
+            archive(cereal::make_nvp("serial", serial));
+            archive(cereal::make_nvp("parallel", parallel));
+        }
+    };
+
+    /**
+     * Writes the uniforms of a host visible uniform buffer the way the uniform handlers do, once through the per-write
+     * compare and copy on the mapped memory and once through the shadow buffer, both see the same changes every frame.
+     * @param settings The workload.
+     * @return The timings of both paths.
+     */
+    PushBenchmarkResult RunPushBenchmark(const PushBenchmarkSettings& settings);
+
+    /**
+     * Generates two equal project trees with metadata and opens them repeatedly, once with the serial import which
+     * resolves every file with its own database transactions and once through the asset registry.
+     * Files stay in the page cache after the generation, so the timings do not include cold disk reads.
+     * @param settings The workload.
+     * @return The timings of both paths.
+     */
+    ScanBenchmarkResult RunScanBenchmark(const ScanBenchmarkSettings& settings);
+}
@@ -47,7 +47,9 @@ namespace fe {
                     {0, {0}}
             };
 
-            addRenderStage(std::make_unique<RenderStage>(std::move(renderpassAttachments2), std::move(renderpassSubpasses2)));
+            auto renderStage2 = std::make_unique<RenderStage>(std::move(renderpassAttachments2), std::move(renderpassSubpasses2));
+            renderStage2->setReads({"scene_image", "game_image"}); // Viewport panels sample them with ImGui
+            addRenderStage(std::move(renderStage2));
         }
         ~EditorRenderer() override = default;
 
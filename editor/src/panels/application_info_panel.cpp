@@ -3,6 +3,8 @@
 #include "fusion/devices/device_manager.h"
 #include "fusion/scene/scene_manager.h"
 #include "fusion/filesystem/file_system.h"
+#include "fusion/graphics/graphics.h"
+#include "fusion/core/perf_counters.h"
 
 using namespace fe;
 
@@ -30,26 +32,39 @@ void ApplicationInfoPanel::onImGui() {
             }*/
 
             if (ImGui::TreeNode("Asset Manager")) {
-                const auto& assets = AssetRegistry::Get()->getAllAssets();
+                auto registry = AssetRegistry::Get();
+                const auto& assets = registry->getAllAssets();
+
+                ImGui::Text("Memory: %.1f MB / %.1f MB", static_cast<double>(registry->getMemoryUsage()) / (1024.0 * 1024.0), static_cast<double>(registry->getMemoryBudget()) / (1024.0 * 1024.0));
 
                 if (!assets.empty()) {
-                    for (const auto& [id, type] : assets) {
+                    for (const auto& [id, storage] : enumerate(assets)) {
+                        if (storage.indices.empty())
+                            continue;
                         std::string table{ "##" + std::to_string(id) };
-                        if (ImGui::BeginTable(table.c_str(), 2, flags)) {
+                        if (ImGui::BeginTable(table.c_str(), 3, flags)) {
                             ImGui::TableSetupColumn("Path", ImGuiTableColumnFlags_WidthStretch);
                             ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed);
+                            ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthFixed);
                             ImGui::TableHeadersRow();
 
-                            for (const auto& [uuid, asset] : type) {
+                            for (const auto& slot : storage.slots) {
+                                const auto& asset = slot.asset;
+                                if (!asset)
+                                    continue;
+
                                 ImGui::TableNextRow();
 
                                 ImGui::TableSetColumnIndex(0);
 
-                                std::string key{ fmt::format("[{}]{} ", uuid, asset->getPath().string().c_str())};
+                                std::string key{ fmt::format("[{}]{} ", slot.uuid, asset->getPath().string().c_str())};
                                 ImGui::TextUnformatted(key.c_str());
 
                                 ImGui::TableSetColumnIndex(1);
                                 ImGui::Text("%ld", asset.use_count());
+
+                                ImGui::TableSetColumnIndex(2);
+                                ImGui::Text("%.1f KB", static_cast<double>(asset->getMemorySize()) / 1024.0);
                             }
                             ImGui::EndTable();
                         }
@@ -266,6 +281,87 @@ void ApplicationInfoPanel::onImGui() {
                 ImGui::TreePop();
             }
 
+            if (ImGui::TreeNode("GPU Profiler")) {
+                if (auto profiler = Graphics::Get()->getGpuProfiler()) {
+                    if (profiler->isSupported()) {
+                        bool enabled = profiler->isEnabled();
+                        if (ImGui::Checkbox("Enabled", &enabled))
+                            profiler->setEnabled(enabled);
+
+                        auto zones = profiler->getZones();
+                        if (enabled && !zones.empty()) {
+                            if (ImGui::BeginTable("##gpu_zones", 3, flags)) {
+                                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                                ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_WidthFixed);
+                                ImGui::TableSetupColumn("Average (ms)", ImGuiTableColumnFlags_WidthFixed);
+                                ImGui::TableHeadersRow();
+
+                                for (const auto& zone : zones) {
+                                    ImGui::TableNextRow();
+
+                                    ImGui::TableSetColumnIndex(0);
+                                    // Zero indent falls back to the default spacing in ImGui
+                                    float indent = static_cast<float>(zone.depth) * ImGui::GetStyle().IndentSpacing;
+                                    if (indent > 0.0f)
+                                        ImGui::Indent(indent);
+                                    ImGui::TextUnformatted(zone.name.c_str());
+                                    if (indent > 0.0f)
+                                        ImGui::Unindent(indent);
+
+                                    ImGui::TableSetColumnIndex(1);
+                                    ImGui::Text("%.3f", zone.last);
+
+                                    ImGui::TableSetColumnIndex(2);
+                                    ImGui::Text("%.3f", zone.average);
+                                }
+                                ImGui::EndTable();
+                            }
+                        }
+                    } else {
+                        ImGui::TextUnformatted("Timestamps are not supported by the graphics queue");
+                    }
+                }
+                ImGui::TreePop();
+            }
+
+            if (ImGui::TreeNode("Performance Counters")) {
+                if (ImGui::BeginTable("##perf_counters", 4, flags)) {
+                    ImGui::TableSetupColumn("Counter", ImGuiTableColumnFlags_WidthStretch);
+                    ImGui::TableSetupColumn("Frame", ImGuiTableColumnFlags_WidthFixed);
+                    ImGui::TableSetupColumn("Average", ImGuiTableColumnFlags_WidthFixed);
+                    ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthFixed);
+                    ImGui::TableHeadersRow();
+
+                    for (size_t i = 0; i < PerfCounters::CounterCount; ++i) {
+                        auto counter = static_cast<PerfCounters::Counter>(i);
+                        auto history = PerfCounters::GetHistory(counter);
+
+                        int64_t total = 0;
+                        int64_t max = 0;
+                        for (auto value : history) {
+                            total += value;
+                            max = std::max(max, value);
+                        }
+
+                        ImGui::TableNextRow();
+
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::TextUnformatted(PerfCounters::GetName(counter));
+
+                        ImGui::TableSetColumnIndex(1);
+                        ImGui::Text("%lld", static_cast<long long>(PerfCounters::Get(counter)));
+
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::Text("%.1f", history.empty() ? 0.0 : static_cast<double>(total) / static_cast<double>(history.size()));
+
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::Text("%lld", static_cast<long long>(max));
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::TreePop();
+            }
+
             /*if (ImGui::TreeNode("Virtual File System")) {
                 auto vfs = VirtualFileSystem::Get();
                 if (!vfs->getMounted().empty()) {
@@ -292,6 +388,15 @@ void ApplicationInfoPanel::onImGui() {
 
             ImGui::Text("FPS : %5.2i", Time::FramesPerSecond());
             ImGui::Text("Frame Time : %5.2f ms", Time::DeltaTime().asMilliseconds());
+
+            auto stats = Time::FrameTimeStats();
+            ImGui::Text("p50 : %5.2f ms  p95 : %5.2f ms  p99 : %5.2f ms  max : %5.2f ms", stats.p50, stats.p95, stats.p99, stats.max);
+            ImGui::Text("Hitches : %u", Time::HitchCount());
+
+            const auto& histogram = Time::FrameTimeHistogram();
+            std::array<float, Time::HistogramSize> buckets;
+            std::copy(histogram.begin(), histogram.end(), buckets.begin());
+            ImGui::PlotHistogram("##frame_histogram", buckets.data(), static_cast<int>(buckets.size()), 0, "Frame Time Histogram (1 ms buckets)", 0.0f, FLT_MAX, ImVec2{ 0.0f, 80.0f });
             //ImGui::NewLine();
             //ImGui::Text("Scene : %s", SceneManager::Get()->getCurrentScene()->getName().c_str());
             ImGui::TreePop();
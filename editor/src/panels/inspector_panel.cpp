@@ -363,8 +363,8 @@ namespace ImGui {
         if (auto filter = mesh.get()) {
             ImGui::NewLine();
             ImGui::Separator();
-            if (mesh.model)
-                ImGuiUtils::PropertyText("Path", mesh.model->getPath().string().c_str());
+            if (auto model = mesh.model.get())
+                ImGuiUtils::PropertyText("Path", model->getPath().string().c_str());
             if (filter->getIndex() != UINT32_MAX)
                 ImGuiUtils::Property("Index", filter->getIndex());
             ImGuiUtils::Property("Vertex Count", filter->getVertexCount());
@@ -392,13 +392,9 @@ namespace ImGui {
 
         ImGuiUtils::PropertyTextbox("Text", text.text);
         {
-            std::shared_ptr<Asset> current = text.font;
+            std::shared_ptr<Asset> current = text.font.getShared();
             if (ImGuiUtils::PropertyAsset<Font>("Font", current, selected, filter)) {
-                if (current) {
-                    text.font = std::dynamic_pointer_cast<Font>(current);
-                } else {
-                    text.font.reset();
-                }
+                text.font = current ? AssetRegistry::Get()->resolve<Font>(current->getUuid()) : AssetHandle<Font>{};
             }
         }
         ImGuiUtils::Property("Color", text.color, 0.0f, 0.0f, 1.0f, ImGuiUtils::PropertyType::Color);
@@ -455,33 +451,21 @@ namespace ImGui {
         ImGuiUtils::Property("Base Color", material.baseColor, 0.0f, 1.0f, 0.01f, ImGuiUtils::PropertyType::Color);
 
         {
-            std::shared_ptr<Asset> current = material.diffuse;
+            std::shared_ptr<Asset> current = material.diffuse.getShared();
             if (ImGuiUtils::PropertyAsset<Texture2d>("Diffuse", current, selected, filter)) {
-                if (current) {
-                    material.diffuse = std::dynamic_pointer_cast<Texture2d>(current);
-                } else {
-                    material.diffuse.reset();
-                }
+                material.diffuse = current ? AssetRegistry::Get()->resolve<Texture2d>(current->getUuid()) : AssetHandle<Texture2d>{};
             }
         }
         {
-            std::shared_ptr<Asset> current = material.specular;
+            std::shared_ptr<Asset> current = material.specular.getShared();
             if (ImGuiUtils::PropertyAsset<Texture2d>("Specular", current, selected, filter)) {
-                if (current) {
-                    material.specular = std::dynamic_pointer_cast<Texture2d>(current);
-                } else {
-                    material.specular.reset();
-                }
+                material.specular = current ? AssetRegistry::Get()->resolve<Texture2d>(current->getUuid()) : AssetHandle<Texture2d>{};
             }
         }
         {
-            std::shared_ptr<Asset> current = material.normal;
+            std::shared_ptr<Asset> current = material.normal.getShared();
             if (ImGuiUtils::PropertyAsset<Texture2d>("Normal", current, selected, filter)) {
-                if (current) {
-                    material.normal = std::dynamic_pointer_cast<Texture2d>(current);
-                } else {
-                    material.normal.reset();
-                }
+                material.normal = current ? AssetRegistry::Get()->resolve<Texture2d>(current->getUuid()) : AssetHandle<Texture2d>{};
             }
         }
 
@@ -621,13 +605,9 @@ namespace ImGui {
         static ImGuiTextFilter filter;
         static std::shared_ptr<Asset> selected;
 
-        std::shared_ptr<Asset> current = skybox.texture;
+        std::shared_ptr<Asset> current = skybox.texture.getShared();
         if (ImGuiUtils::PropertyAsset<TextureCube>("Texture", current, selected, filter)) {
-            if (current) {
-                skybox.texture = std::dynamic_pointer_cast<TextureCube>(current);
-            } else {
-                skybox.texture.reset();
-            }
+            skybox.texture = current ? AssetRegistry::Get()->resolve<TextureCube>(current->getUuid()) : AssetHandle<TextureCube>{};
         }
 
         ImGui::Columns(1);
@@ -27,6 +27,10 @@ void SceneViewPanel::onImGui() {
 
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{0, 0});
 
+    // Stage is culled by the render graph while the view is hidden
+    auto renderStage = Graphics::Get()->getRenderStage(0);
+    renderStage->setEnabled(false);
+
     auto scene = SceneManager::Get()->getScene();
     if (!ImGui::Begin(title.c_str(), &active, flags) || !scene) {
         ImGui::PopStyleVar();
@@ -60,10 +64,11 @@ void SceneViewPanel::onImGui() {
     float aspect = viewportSize.x / viewportSize.y;
     camera->setAspectRatio(aspect);
 
-    auto renderStage = Graphics::Get()->getRenderStage(0);
+    renderStage->setEnabled(active);
     renderStage->setOverrideCamera(camera);
     if (!renderStage->setViewport({glm::vec2{1.0f, 1.0f}, glm::uvec2{viewportSize.x, viewportSize.y}, glm::ivec2{0, 0}})) {
-        ImGuiUtils::Image((Texture2d*)renderStage->getDescriptor("scene_image"), viewportSize, true);
+        if (auto texture = renderStage->getDescriptor("scene_image"))
+            ImGuiUtils::Image((Texture2d*)texture, viewportSize, true);
     }
 
     ImVec2& minBound = viewportPos;
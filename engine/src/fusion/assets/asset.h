@@ -1,10 +1,25 @@
 #pragma once
 
+#include <atomic>
+
 namespace fe {
+    class UploadBatch;
+
+    enum class AssetState : unsigned char { Unloaded, Loading, Ready, Failed };
+
+    /**
+     * @brief Decides if an asset keeps its source data in RAM next to the GPU resources.
+     */
+    enum class AssetRetention : unsigned char {
+        GpuOnly, /// Data is copied back from the GPU when it is read.
+        Keep /// Data is kept for CPU readers, like colliders, BVH building and picking.
+    };
+
     /**
      * @brief A managed resource object.
      */
     class FUSION_API Asset {
+        friend class AssetRegistry;
     public:
         Asset() = default;
         virtual ~Asset() = default;
@@ -17,7 +32,62 @@ namespace fe {
         virtual bool isLoaded() const = 0;
         virtual bool isInternal() const = 0;
 
+        /**
+         * Gets the memory held by the asset, used for the memory budget of the registry.
+         * @return The size in bytes.
+         */
+        virtual uint64_t getMemorySize() const { return 0; }
+
+        /**
+         * Sets if the asset keeps its data in RAM, assets which have no CPU readers ignore it.
+         * Use {@link AssetRegistry#setRetention} for registered assets, so the policy survives an eviction.
+         * Must be called from the main thread.
+         * @param retention The retention policy.
+         */
+        virtual void setRetention(AssetRetention retention) {}
+        virtual AssetRetention getRetention() const { return AssetRetention::GpuOnly; }
+
         virtual void load() = 0;
         virtual void unload() = 0;
+
+        /**
+         * Reads and decodes the source data into memory, called from a worker thread, so it must not touch the GPU.
+         * @return If the data was decoded.
+         */
+        virtual bool decode() { return true; }
+
+        /**
+         * Gets the file the asset is decoded from, the registry reads it asynchronously and passes it to {@link Asset#decodeFrom},
+         * so workers never wait on the disk. Called on the main thread.
+         * @return The full path or empty if the asset reads its sources in {@link Asset#decode}.
+         */
+        virtual fs::path getSourcePath() const { return {}; }
+
+        /**
+         * Decodes the source file read ahead by the registry, called from a worker thread.
+         * @param source The content of the file from {@link Asset#getSourcePath}.
+         * @return If the data was decoded.
+         */
+        virtual bool decodeFrom(gsl::span<const uint8_t> source) { return decode(); }
+
+        /**
+         * Creates the GPU resources from the decoded data and records their copies, called on the main thread.
+         * Assets without an asynchronous path are loaded here synchronously.
+         * @param batch The batch to record the copies into.
+         */
+        virtual void upload(UploadBatch& batch) { load(); }
+
+        /**
+         * Gets the loading state, resources of an asset can only be used once it is ready.
+         * @return The loading state.
+         */
+        AssetState getState() const { return state.load(std::memory_order_acquire); }
+        bool isReady() const { return getState() == AssetState::Ready; }
+
+    protected:
+        void setState(AssetState value) { state.store(value, std::memory_order_release); }
+
+    private:
+        std::atomic<AssetState> state{ AssetState::Unloaded };
     };
-}
\ No newline at end of file
+}
@@ -33,6 +33,7 @@ std::optional<uuids::uuid> AssetDatabase::getKey(const fs::path& filepath) {
         return std::nullopt;
     }
 
+    std::unique_lock<std::mutex> lock(mutex);
     mdb::Transaction txn{env, MDB_RDONLY};
     mdb_dbi_open(txn, nullptr, 0, &dbi);
 
@@ -61,6 +62,7 @@ std::optional<fs::path> AssetDatabase::getValue(uuids::uuid uuid) {
         return std::nullopt;
     }
 
+    std::unique_lock<std::mutex> lock(mutex);
     mdb::Transaction txn{env, MDB_RDONLY};
     mdb_dbi_open(txn, nullptr, 0, &dbi);
 
@@ -83,6 +85,7 @@ bool AssetDatabase::put(uuids::uuid uuid, const fs::path& filepath, bool overwri
         return false;
     }
 
+    std::unique_lock<std::mutex> lock(mutex);
     mdb::Transaction txn{env};
     mdb_dbi_open(txn, nullptr, 0, &dbi);
 
@@ -101,6 +104,78 @@ bool AssetDatabase::put(uuids::uuid uuid, const fs::path& filepath, bool overwri
     return true;
 }
 
+size_t AssetDatabase::reconcile(std::vector<AssetEntry>& entries) {
+    std::unique_lock<std::mutex> lock(mutex);
+    mdb::Transaction txn{env};
+    mdb_dbi_open(txn, nullptr, 0, &dbi);
+
+    // Stored entries are swept once instead of a lookup per file
+    std::unordered_map<uuids::uuid, std::string> paths;
+    std::unordered_map<std::string, uuids::uuid> keys;
+    {
+        mdb::Cursor cursor{txn, dbi};
+
+        MDB_val key{ 0, nullptr };
+        MDB_val value{ 0, nullptr };
+
+        while (mdb_cursor_get(cursor, &key, &value, MDB_NEXT) == 0) {
+            if (key.mv_size != 16)
+                continue;
+            gsl::span<uint8_t, 16> bytes{ static_cast<uint8_t*>(key.mv_data), key.mv_size };
+            uuids::uuid uuid{ bytes };
+            std::string path{ static_cast<char*>(value.mv_data), value.mv_size };
+            keys.emplace(path, uuid);
+            paths.emplace(uuid, std::move(path));
+        }
+    }
+
+    size_t changes = 0;
+    auto store = [&](const uuids::uuid& uuid, const std::string& path) {
+        auto bytes = uuid.as_bytes();
+        MDB_val key{ bytes.size(), (void*) bytes.data() };
+        MDB_val value{ path.size(), (void*) path.data() };
+
+        MDB_RESULT(mdb_put(txn, dbi, &key, &value, 0));
+
+        auto& stored = paths[uuid];
+        if (auto it = keys.find(stored); it != keys.end() && it->second == uuid)
+            keys.erase(it);
+        stored = path;
+        keys[path] = uuid;
+        ++changes;
+    };
+
+    for (auto& entry : entries) {
+        auto path = entry.path.generic_string();
+
+        if (!entry.uuid.is_nil()) {
+            if (auto it = paths.find(entry.uuid); it == paths.end() || it->second != path)
+                store(entry.uuid, path);
+            continue;
+        }
+
+        if (auto it = keys.find(path); it != keys.end()) {
+            entry.uuid = it->second;
+        } else {
+            uuids::uuid id{ uuid_random_generator() };
+            while (paths.find(id) != paths.end()) {
+                id = { uuid_random_generator() };
+            }
+            entry.uuid = id;
+            store(id, path);
+        }
+        entry.recovered = true;
+    }
+
+    if (changes != 0) {
+        const int rc = mdb_txn_commit(txn);
+        txn.clear();
+        MDB_RESULT(rc);
+    }
+
+    return changes;
+}
+
 namespace fe::mdb {
     Transaction::Transaction(MDB_env* env, uint32_t flags, MDB_txn* parent) {
         MDB_RESULT(mdb_txn_begin(env, nullptr, flags, &txn));
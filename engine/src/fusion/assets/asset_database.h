@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 extern "C" {
     typedef struct MDB_env MDB_env;
     typedef struct MDB_txn MDB_txn;
@@ -11,6 +13,12 @@ namespace fe {
     // Define available file changes
     enum class FileStatus : unsigned char { Created, Modified, Erased };
 
+    struct AssetEntry {
+        fs::path path; /// Path relative to the project root.
+        uuids::uuid uuid; /// Uuid from the metadata, nil if it is missing or invalid.
+        bool recovered{ false }; /// Uuid was taken from the database or generated, so the metadata has to be written.
+    };
+
     class FUSION_API AssetDatabase {
     public:
         explicit AssetDatabase(fs::path path);
@@ -21,10 +29,19 @@ namespace fe {
 
         bool put(uuids::uuid key, const fs::path& value, bool overwrite = false);
 
+        /**
+         * Matches the files of the project with the stored entries in one write transaction, the stored entries are read once with a cursor.
+         * Files without a uuid get the stored uuid of their path or a new one.
+         * @param entries The files of the project, the uuids are resolved in place.
+         * @return The number of changed entries.
+         */
+        size_t reconcile(std::vector<AssetEntry>& entries);
+
     private:
         MDB_env* env{ nullptr };
         MDB_dbi dbi{ 0 };
         fs::path databaseDirectory;
+        std::mutex mutex; /// Assets are resolved from the loading workers too.
     };
 
     namespace mdb {
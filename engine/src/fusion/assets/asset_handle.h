@@ -0,0 +1,39 @@
+#pragma once
+
+namespace fe {
+    /**
+     * @brief Typed reference to a slot of the asset registry, a handle is resolved from a uuid once and then checked
+     * by an array index and a generation, so it is cheap to copy and store in components.
+     * A handle outlives the asset, once the slot is released the generation no longer matches and the handle resolves to null.
+     */
+    template<typename T>
+    struct AssetHandle {
+        uint32_t index{ 0 };
+        uint32_t generation{ 0 }; /// Zero for the null handle, slots start with the first generation.
+
+        /**
+         * Gets the asset from the registry.
+         * @return The asset or nullptr if the handle is null, released or the asset was evicted.
+         */
+        T* get() const;
+        T* operator->() const { return get(); }
+
+        /**
+         * Gets the asset from the registry for holders which have to keep it alive.
+         * @return The asset or nullptr.
+         */
+        std::shared_ptr<T> getShared() const;
+
+        /**
+         * Gets the uuid of the asset in the slot.
+         * @return The uuid or nil if the handle is null or released.
+         */
+        uuids::uuid getUuid() const;
+
+        void reset() { index = 0; generation = 0; }
+
+        explicit operator bool() const { return generation != 0; }
+        bool operator==(const AssetHandle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+        bool operator!=(const AssetHandle& rhs) const { return !operator==(rhs); }
+    };
+}
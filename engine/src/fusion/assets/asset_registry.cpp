@@ -1,11 +1,19 @@
 #include "asset_registry.h"
 
 #include "fusion/core/engine.h"
+#include "fusion/core/thread_pool.h"
+#include "fusion/core/perf_counters.h"
+#include "fusion/filesystem/file_system.h"
+#include "fusion/graphics/graphics.h"
+#include "fusion/graphics/buffers/upload_batch.h"
 
 using namespace fe;
 
 AssetRegistry* AssetRegistry::Instance = nullptr;
 
+/// Staging memory recorded into the upload batch of a frame, the remaining assets are uploaded in the next frames.
+static constexpr VkDeviceSize UploadBudget = 64 * 1024 * 1024;
+
 AssetRegistry::AssetRegistry() {
     Instance = this;
 }
@@ -15,12 +23,45 @@ AssetRegistry::~AssetRegistry() {
 }
 
 void AssetRegistry::releaseAll() {
-    assets.clear();
+    // Workers read the database which is recreated below
+    finishDecoding();
+    {
+        std::unique_lock<std::mutex> lock(decodedMutex);
+        decoded.clear();
+    }
+
+    // Slots are kept with a new generation, so handles of the previous project resolve to null
+    for (auto& storage : storages) {
+        storage.freeSlots.clear();
+        for (auto&& [index, slot] : enumerate(storage.slots)) {
+            // Recorded frames can still point to the assets
+            if (slot.asset)
+                released.push_back(std::move(slot.asset));
+            slot.asset.reset();
+            slot.create = nullptr;
+            slot.uuid = {};
+            slot.retention = AssetRetention::GpuOnly;
+            if (++slot.generation == 0)
+                slot.generation = 1;
+            storage.freeSlots.push_back(static_cast<uint32_t>(index));
+        }
+        storage.indices.clear();
+    }
 
     // TODO: Move to reload
 
     const auto& path = Engine::Get()->getApp()->getProjectSettings().projectRoot;
 
+    // Environment of the same directory can only be opened once per process
+    assetDatabase.reset();
+#if !FUSION_VIRTUAL_FS
+    fileWatcher.reset();
+#endif
+
+    // Without a project only the assets are released
+    if (path.empty())
+        return;
+
     assetDatabase = std::make_unique<AssetDatabase>(path);
 
 #if !FUSION_VIRTUAL_FS
@@ -32,32 +73,307 @@ void AssetRegistry::releaseAll() {
         ".meta"
     };
 
-    fileWatcher = std::make_unique<FileWatcher>(path, [&](const fs::path& path, FileEvent event) {
+    auto start = DateTime::Now();
+
+    fileWatcher = FileWatcher::Init(path, [&](const fs::path& path, FileEvent event) {
         return onFileChanged(path, event);
     }, std::move(exts));
+
+    importFiles(scannedFiles);
+    FE_LOG_INFO("Project: {} files scanned in {}ms", scannedFiles.size(), (DateTime::Now() - start).asMilliseconds());
+    scannedFiles.clear();
+    scannedFiles.shrink_to_fit();
 #endif
 }
 
 void AssetRegistry::onStart() {
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    if (commandLineParser.isSet("assetbudget"))
+        memoryBudget = static_cast<uint64_t>(commandLineParser.getValue<int>("assetbudget", 1024)) * 1024 * 1024;
 }
 
 void AssetRegistry::onUpdate() {
+    frame = Time::FrameCount();
 #if !FUSION_VIRTUAL_FS
     if (fileWatcher)
         fileWatcher->update();
 #endif
+    updateUploads(false);
 }
 
 void AssetRegistry::onStop() {
+    finishDecoding();
+    decoded.clear();
+    // Batches wait for their fence when released
+    pendingUploads.clear();
+    released.clear();
+}
+
+AssetStorage& AssetRegistry::getStorage(type_index type) {
+    if (type >= storages.size())
+        storages.resize(type + 1);
+    return storages[type];
+}
+
+uint32_t AssetRegistry::takeSlot(AssetStorage& storage) {
+    if (!storage.freeSlots.empty()) {
+        auto index = storage.freeSlots.back();
+        storage.freeSlots.pop_back();
+        return index;
+    }
+    storage.slots.emplace_back();
+    return static_cast<uint32_t>(storage.slots.size() - 1);
+}
+
+uint32_t AssetRegistry::allocate(AssetStorage& storage, const uuids::uuid& uuid, std::function<std::shared_ptr<Asset>()>&& create) {
+    auto index = takeSlot(storage);
+
+    auto& slot = storage.slots[index];
+    slot.create = std::move(create);
+    slot.uuid = uuid;
+    slot.retention = AssetRetention::GpuOnly;
+    storage.indices.emplace(uuid, index);
+
+    reload(slot);
+    return index;
+}
+
+uint32_t AssetRegistry::insert(AssetStorage& storage, std::shared_ptr<Asset>&& asset) {
+    auto uuid = asset->getUuid();
+    if (!uuid.is_nil()) {
+        if (auto it = storage.indices.find(uuid); it != storage.indices.end()) {
+            FE_LOG_WARNING("Asset [{}] is already registered", uuid);
+            return it->second;
+        }
+    }
+
+    auto index = takeSlot(storage);
+
+    auto& slot = storage.slots[index];
+    slot.asset = std::move(asset);
+    slot.uuid = uuid;
+    slot.lastUsed = frame;
+    slot.retention = slot.asset->getRetention();
+
+    // Generated assets usually have no uuid, they are only reachable through the handle
+    if (!uuid.is_nil())
+        storage.indices.emplace(uuid, index);
+
+    return index;
+}
+
+void AssetRegistry::reload(AssetSlot& slot) {
+    slot.asset = slot.create();
+    slot.asset->setRetention(slot.retention);
+    slot.lastUsed = frame;
+    enqueue(slot.asset);
+}
+
+void AssetRegistry::enqueue(const std::shared_ptr<Asset>& asset) {
+    asset->setState(AssetState::Loading);
+    PerfCounters::Add(PerfCounters::Counter::AssetLoads);
+
+    decoding.fetch_add(1, std::memory_order_relaxed);
+
+    auto source = asset->getSourcePath();
+    if (source.empty()) {
+        ThreadPool::Get()->enqueue([this, asset] {
+            decodeAsset(asset, [&asset] { return asset->decode(); });
+        });
+        return;
+    }
+
+    // Source is read by the I/O service, a worker is only taken once the data arrived
+    FileSystem::ReadAsync(source, [this, asset](IoResult&& result) {
+        if (!result) {
+            asset->setState(AssetState::Failed);
+            decoding.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+
+        ThreadPool::Get()->enqueue([this, asset, data = std::move(result.data)] {
+            decodeAsset(asset, [&asset, &data] { return asset->decodeFrom(data); });
+        });
+    });
+}
+
+void AssetRegistry::decodeAsset(const std::shared_ptr<Asset>& asset, const std::function<bool()>& function) {
+    FUSION_PROFILE_SCOPE("Asset Decode");
+    bool result = false;
+    try {
+        result = function();
+    } catch (const std::exception& e) {
+        FE_LOG_ERROR("Failed to decode asset [{}]: {}", asset->getUuid(), e.what());
+    }
+
+    if (result) {
+        std::unique_lock<std::mutex> lock(decodedMutex);
+        decoded.push_back(asset);
+    } else {
+        asset->setState(AssetState::Failed);
+    }
+    decoding.fetch_sub(1, std::memory_order_release);
+}
+
+void AssetRegistry::updateUploads(bool flush) {
+    FUSION_PROFILE_FUNCTION();
+
+    // Assets become ready only after the copies finished, so renderers never sample an image in the middle of its upload
+    for (auto it = pendingUploads.begin(); it != pendingUploads.end();) {
+        if (flush)
+            it->batch->wait();
+        else if (!it->batch->isComplete()) {
+            ++it;
+            continue;
+        }
+
+        for (const auto& asset : it->assets) {
+            asset->setState(asset->isLoaded() ? AssetState::Ready : AssetState::Failed);
+        }
+        it = pendingUploads.erase(it);
+    }
+
+    std::vector<std::shared_ptr<Asset>> uploads;
+    {
+        std::unique_lock<std::mutex> lock(decodedMutex);
+        uploads = std::move(decoded);
+        decoded.clear();
+    }
+
+    if (uploads.empty())
+        return;
+
+    auto batch = std::make_unique<UploadBatch>();
+
+    size_t count = 0;
+    for (const auto& asset : uploads) {
+        if (!flush && batch->getStagedBytes() >= UploadBudget)
+            break;
+        try {
+            asset->upload(*batch);
+        } catch (const std::exception& e) {
+            FE_LOG_ERROR("Failed to upload asset [{}]: {}", asset->getUuid(), e.what());
+        }
+        ++count;
+    }
+
+    // Over the budget, the rest goes into the next frame
+    if (count < uploads.size()) {
+        std::unique_lock<std::mutex> lock(decodedMutex);
+        decoded.insert(decoded.begin(), uploads.begin() + static_cast<ptrdiff_t>(count), uploads.end());
+        uploads.resize(count);
+    }
+
+    batch->submit();
+    pendingUploads.push_back({ std::move(batch), std::move(uploads) });
+
+    if (flush)
+        updateUploads(true);
+}
+
+void AssetRegistry::finishDecoding() {
+    while (decoding.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+
+void AssetRegistry::updateMemory() {
+    FUSION_PROFILE_FUNCTION();
+
+    auto graphics = Graphics::Get();
+
+    // Frames in flight can still sample the resources, so they are released once those finished
+    if (graphics) {
+        for (auto& asset : released) {
+            graphics->retire(std::move(asset));
+        }
+    }
+    released.clear();
+
+    struct Candidate {
+        type_index type;
+        uint32_t index;
+        uint64_t lastUsed;
+        uint64_t size;
+    };
+    std::vector<Candidate> candidates;
+
+    memoryUsage = 0;
+
+    for (auto&& [type, storage] : enumerate(storages)) {
+        if (storage.slots.empty())
+            continue;
+
+        uint64_t usage = 0;
+        for (auto&& [index, slot] : enumerate(storage.slots)) {
+            if (!slot.asset)
+                continue;
+
+            auto size = slot.asset->getMemorySize();
+            usage += size;
+
+            // Only the registry holds the asset, the workers and the upload batches hold it while it is loading
+            if (slot.asset.use_count() > 1)
+                slot.lastUsed = frame;
+            // Handles mark the assets on access, the ones resolved recently are kept
+            else if (slot.lastUsed + EVICTION_DELAY < frame && slot.create && !slot.asset->isInternal())
+                candidates.push_back({ static_cast<type_index>(type), static_cast<uint32_t>(index), slot.lastUsed, size });
+        }
+        memoryUsages[static_cast<type_index>(type)] = usage;
+        memoryUsage += usage;
+    }
+
+    if (memoryBudget == 0 || memoryUsage <= memoryBudget)
+        return;
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+
+    // Leaves headroom, so the next loads do not go over the budget right away
+    uint64_t target = memoryBudget - memoryBudget / 8;
+
+    size_t evicted = 0;
+    for (const auto& candidate : candidates) {
+        if (memoryUsage <= target)
+            break;
+
+        // Slot stays valid, so handles load the asset again on the next access
+        auto& slot = storages[candidate.type].slots[candidate.index];
+
+        if (graphics)
+            graphics->retire(std::move(slot.asset));
+        slot.asset.reset();
+
+        memoryUsages[candidate.type] -= candidate.size;
+        memoryUsage -= candidate.size;
+        ++evicted;
+    }
+
+    FE_LOG_DEBUG("Evicted {} assets, memory usage: {}MB of {}MB", evicted, memoryUsage / (1024 * 1024), memoryBudget / (1024 * 1024));
+}
+
+bool AssetRegistry::wait(const std::shared_ptr<Asset>& asset) {
+    while (asset->getState() == AssetState::Loading) {
+        updateUploads(true);
+        if (asset->getState() == AssetState::Loading)
+            std::this_thread::yield();
+    }
+    return asset->isReady();
 }
 
 #if !FUSION_VIRTUAL_FS
 void AssetRegistry::onFileChanged(const fs::path& path, FileEvent event) {
+    // Files of the initial scan are imported together
+    if (event == FileEvent::Init) {
+        scannedFiles.push_back(path);
+        return;
+    }
+
     if (!fs::is_regular_file(path))
         return;
 
     switch (event) {
-        case FileEvent::Init:
         case FileEvent::Created:
             if (path.extension().string() != ".meta")
                 onFileInit(path);
@@ -71,6 +387,62 @@ void AssetRegistry::onFileChanged(const fs::path& path, FileEvent event) {
     }
 }
 
+void AssetRegistry::importFiles(const std::vector<fs::path>& files) {
+    FUSION_PROFILE_FUNCTION();
+
+    const auto& root = Engine::Get()->getApp()->getProjectSettings().projectRoot;
+
+    // Metadata files are part of the scan, so they are not looked up on the disk
+    std::unordered_set<fs::path, PathHash> scanned{ files.begin(), files.end() };
+
+    std::vector<AssetEntry> entries;
+    std::vector<fs::path> metaPaths;
+    for (const auto& file : files) {
+        if (file.extension().string() == ".meta")
+            continue;
+        fs::path metaPath{ file };
+        metaPath += ".meta";
+        entries.push_back({ file.lexically_relative(root) });
+        metaPaths.push_back(std::move(metaPath));
+    }
+
+    std::vector<IoRequest> requests;
+    std::atomic<size_t> remaining{ 0 };
+    for (auto&& [i, metaPath] : enumerate(metaPaths)) {
+        if (scanned.find(metaPath) == scanned.end())
+            continue;
+        requests.push_back({ metaPath, 0, 0, [&entry = entries[i], &remaining](IoResult&& result) {
+            if (result) {
+                auto uuid = uuids::uuid::from_string(std::string{ reinterpret_cast<const char*>(result.data.data()), result.data.size() });
+                if (uuid.has_value())
+                    entry.uuid = *uuid;
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        }});
+    }
+
+    remaining.store(requests.size(), std::memory_order_relaxed);
+    IoService::Get()->submit(std::move(requests));
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    auto changes = assetDatabase->reconcile(entries);
+
+    std::atomic<size_t> recovered{ 0 };
+    ThreadPool::Get()->parallelFor(entries.size(), 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& entry = entries[i];
+            if (!entry.recovered)
+                continue;
+            FileSystem::WriteText(metaPaths[i], uuids::to_string(entry.uuid));
+            recovered.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    FE_LOG_DEBUG("Imported {} assets, {} database entries changed, {} metadata files written", entries.size(), changes, recovered.load());
+}
+
 void AssetRegistry::onFileInit(const fs::path& filepath) {
     // get full path to metadata
     fs::path metaPath { filepath };
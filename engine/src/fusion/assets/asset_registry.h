@@ -1,16 +1,36 @@
 #pragma once
 
 #include "asset.h"
+#include "asset_handle.h"
 #include "asset_database.h"
 
 #include "fusion/filesystem/file_watcher.h"
 
+#include <mutex>
+
 namespace fe {
     template<typename T>
     class Module;
 
+    struct AssetSlot {
+        std::shared_ptr<Asset> asset; /// Null while the slot is free or after the asset was evicted.
+        std::function<std::shared_ptr<Asset>()> create; /// Creates the asset again after an eviction, null for assets created in memory.
+        uuids::uuid uuid;
+        uint32_t generation{ 1 };
+        uint64_t lastUsed{ 0 }; /// Last frame the asset was resolved or referenced outside of the registry.
+        AssetRetention retention{ AssetRetention::GpuOnly }; /// Applied on every load, so it survives an eviction.
+    };
+
+    struct AssetStorage {
+        std::vector<AssetSlot> slots;
+        std::vector<uint32_t> freeSlots;
+        std::unordered_map<uuids::uuid, uint32_t> indices; /// Slots by the uuid of their asset.
+    };
+
     /**
      * @brief Module used for managing assets.
+     * Assets are stored in dense slot arrays per type, a uuid is resolved into a handle once and the handle
+     * is resolved with an index and a generation check afterwards.
      */
     class FUSION_API AssetRegistry {
         friend class Module<AssetRegistry>;
@@ -23,55 +43,267 @@ namespace fe {
 
         template<typename T, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
         std::shared_ptr<T> get(uuids::uuid uuid) const {
-            if (uuid.is_nil())
+            if (uuid.is_nil() || type_id<T> >= storages.size())
                 return nullptr;
-            if (auto it = assets.find(type_id<T>); it != assets.end()) {
-                if (auto it1 = it->second.find(uuid); it1 != it->second.end()) {
-                    return std::dynamic_pointer_cast<T>(it1->second);
-                }
-            }
+            const auto& storage = storages[type_id<T>];
+            if (auto it = storage.indices.find(uuid); it != storage.indices.end())
+                return std::static_pointer_cast<T>(storage.slots[it->second].asset);
             return nullptr;
         }
 
+        /**
+         * Gets the asset of a handle, evicted assets start loading again. Must be called from the main thread.
+         * @param handle The asset handle.
+         * @return The asset or nullptr if the handle is null or was released.
+         */
+        template<typename T>
+        T* get(AssetHandle<T> handle) {
+            auto slot = getSlot(type_id<T>, handle.index, handle.generation);
+            if (!slot)
+                return nullptr;
+            slot->lastUsed = frame;
+            if (!slot->asset)
+                reload(*slot);
+            return static_cast<T*>(slot->asset.get());
+        }
+
+        template<typename T>
+        std::shared_ptr<T> getShared(AssetHandle<T> handle) {
+            if (get(handle))
+                return std::static_pointer_cast<T>(getSlot(type_id<T>, handle.index, handle.generation)->asset);
+            return nullptr;
+        }
+
+        template<typename T>
+        uuids::uuid getUuid(AssetHandle<T> handle) const {
+            auto slot = getSlot(type_id<T>, handle.index, handle.generation);
+            return slot ? slot->uuid : uuids::uuid{};
+        }
+
+        /**
+         * Resolves a uuid into a handle and starts loading the asset if needed. The handle is returned right away, the data
+         * is decoded on the thread pool and uploaded in batches on the main thread, so the asset can only be used once
+         * {@link Asset#isReady} is true.
+         * @param uuid The asset uuid.
+         * @param args The arguments passed to the asset constructor, only used by the first resolve of the uuid.
+         * @return The asset handle or the null handle for a nil uuid.
+         */
         template<typename T, typename... Args, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
-        std::shared_ptr<T> load(uuids::uuid uuid, Args... args) {
+        AssetHandle<T> resolve(uuids::uuid uuid, Args... args) {
             if (uuid.is_nil())
-                return nullptr;
-            if (auto ref = get<T>(uuid))
-                return ref;
-            auto it = assets[type_id<T>].emplace(uuid, std::make_shared<T>(uuid, std::forward<Args>(args)...));
-            //std::thread t(&Asset::loadResource, it.first->second.get());
-            //t.detach();
-            it.first->second->load();
-            return std::dynamic_pointer_cast<T>(it.first->second);
+                return {};
+            auto& storage = getStorage(type_id<T>);
+            if (auto it = storage.indices.find(uuid); it != storage.indices.end()) {
+                auto& slot = storage.slots[it->second];
+                if (!slot.asset)
+                    reload(slot);
+                return { it->second, slot.generation };
+            }
+            auto index = allocate(storage, uuid, [uuid, args...] {
+                return std::static_pointer_cast<Asset>(std::make_shared<T>(uuid, args...));
+            });
+            return { index, storage.slots[index].generation };
+        }
+
+        /**
+         * Sets if the asset keeps its data in RAM, see {@link Asset#setRetention}. The policy is stored with the slot,
+         * so the asset keeps it after an eviction and for every handle of the uuid. Must be called from the main thread.
+         * @param handle The asset handle.
+         * @param retention The retention policy.
+         */
+        template<typename T>
+        void setRetention(AssetHandle<T> handle, AssetRetention retention) {
+            auto slot = getSlot(type_id<T>, handle.index, handle.generation);
+            if (!slot)
+                return;
+            slot->retention = retention;
+            if (slot->asset)
+                slot->asset->setRetention(retention);
+        }
+
+        template<typename T>
+        AssetRetention getRetention(AssetHandle<T> handle) const {
+            auto slot = getSlot(type_id<T>, handle.index, handle.generation);
+            return slot ? slot->retention : AssetRetention::GpuOnly;
+        }
+
+        /**
+         * Adds an asset which is created in memory, like a generated model. It has no source to be loaded from again,
+         * so it is never evicted and stays in the registry until {@link releaseAll}.
+         * @param asset The asset.
+         * @return The asset handle or the null handle for a null asset.
+         */
+        template<typename T, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
+        AssetHandle<T> add(std::shared_ptr<T> asset) {
+            if (!asset)
+                return {};
+            auto& storage = getStorage(type_id<T>);
+            auto index = insert(storage, std::static_pointer_cast<Asset>(std::move(asset)));
+            return { index, storage.slots[index].generation };
+        }
+
+        /**
+         * Gets an asset or starts loading it, see {@link resolve}. Holders which only need access should keep the handle instead.
+         * @param uuid The asset uuid.
+         * @param args The arguments passed to the asset constructor.
+         * @return The asset.
+         */
+        template<typename T, typename... Args, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
+        std::shared_ptr<T> load(uuids::uuid uuid, Args... args) {
+            return getShared(resolve<T>(uuid, std::forward<Args>(args)...));
         }
 
+        /**
+         * Holds the current thread until the asset finished loading, for callers which need the content right away.
+         * Must be called from the main thread.
+         * @param asset The asset to wait for.
+         * @return If the asset is ready.
+         */
+        bool wait(const std::shared_ptr<Asset>& asset);
+
         const std::unique_ptr<AssetDatabase>& getDatabase() const { return assetDatabase; }
 
+        /**
+         * Sets the memory the loaded assets can hold, over the budget unreferenced assets are evicted, the least recently used first.
+         * Eviction frees memory down to 7/8 of the budget and only takes assets unused for EVICTION_DELAY frames, so assets are not reloaded every other frame.
+         * @param budget The budget in bytes, zero disables eviction.
+         */
+        void setMemoryBudget(uint64_t budget) { memoryBudget = budget; }
+        uint64_t getMemoryBudget() const { return memoryBudget; }
+
+        /**
+         * Gets the memory held by the loaded assets, it is updated once per frame.
+         * @return The size in bytes.
+         */
+        uint64_t getMemoryUsage() const { return memoryUsage; }
+
+        template<typename T, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
+        uint64_t getMemoryUsage() const {
+            if (auto it = memoryUsages.find(type_id<T>); it != memoryUsages.end())
+                return it->second;
+            return 0;
+        }
+        const std::unordered_map<type_index, uint64_t>& getMemoryUsages() const { return memoryUsages; }
+
         template<typename T, typename = std::enable_if_t<std::is_base_of_v<Asset, T>>>
-        std::unordered_map<uuids::uuid, std::shared_ptr<Asset>>& getAssets() { return assets[type_id<T>]; }
-        const std::unordered_map<type_index, std::unordered_map<uuids::uuid, std::shared_ptr<Asset>>>& getAllAssets() const { return assets; }
+        const AssetStorage& getAssets() { return getStorage(type_id<T>); }
+        const std::vector<AssetStorage>& getAllAssets() const { return storages; }
 
         //void loadAll(const fs::path path);
         void releaseAll();
 
+        /**
+         * Evicts the assets over the memory budget and retires the assets of a released project. Called by {@link Graphics}
+         * once the render thread finished the previous frame, so no recording reads the assets while they are released.
+         */
+        void updateMemory();
+
     private:
+        static constexpr uint64_t EVICTION_DELAY = 300; /// Frames an unreferenced asset stays loaded after its last use.
+
         void onStart();
         void onUpdate();
         void onStop();
 
+        AssetStorage& getStorage(type_index type);
+
+        AssetSlot* getSlot(type_index type, uint32_t index, uint32_t generation) {
+            return const_cast<AssetSlot*>(static_cast<const AssetRegistry*>(this)->getSlot(type, index, generation));
+        }
+        const AssetSlot* getSlot(type_index type, uint32_t index, uint32_t generation) const {
+            if (generation == 0 || type >= storages.size())
+                return nullptr;
+            const auto& slots = storages[type].slots;
+            if (index >= slots.size() || slots[index].generation != generation)
+                return nullptr;
+            return &slots[index];
+        }
+
+        /**
+         * Takes a free slot for the asset and starts loading it.
+         * @param storage The storage of the asset type.
+         * @param uuid The asset uuid.
+         * @param create The function which creates the asset.
+         * @return The slot index.
+         */
+        uint32_t allocate(AssetStorage& storage, const uuids::uuid& uuid, std::function<std::shared_ptr<Asset>()>&& create);
+
+        /**
+         * Takes a free slot for an asset created in memory.
+         * @param storage The storage of the asset type.
+         * @param asset The asset.
+         * @return The slot index.
+         */
+        uint32_t insert(AssetStorage& storage, std::shared_ptr<Asset>&& asset);
+        uint32_t takeSlot(AssetStorage& storage);
+
+        /**
+         * Creates an evicted asset again and starts loading it.
+         * @param slot The slot of the asset.
+         */
+        void reload(AssetSlot& slot);
+
+        void enqueue(const std::shared_ptr<Asset>& asset);
+
+        /**
+         * Runs the decode of an asset and queues it for the upload, called from a worker thread.
+         * @param asset The asset to decode.
+         * @param function The decode call.
+         */
+        void decodeAsset(const std::shared_ptr<Asset>& asset, const std::function<bool()>& function);
+        void updateUploads(bool flush);
+        void finishDecoding();
+
 #if !FUSION_VIRTUAL_FS
 
         void onFileChanged(const fs::path& path, FileEvent event);
+
+        /**
+         * Matches the files of the initial scan with the database, the metadata is read in one batch and the database is updated in one transaction.
+         * @param files The scanned files.
+         */
+        void importFiles(const std::vector<fs::path>& files);
         void onFileInit(const fs::path& filepath);
         void onFileModified(const fs::path& filepath);
         void onFileErased(const fs::path& filepath);
 
         std::unique_ptr<FileWatcher> fileWatcher;
+        std::vector<fs::path> scannedFiles; /// Files reported by the initial scan.
 #endif
         std::unique_ptr<AssetDatabase> assetDatabase;
-        std::unordered_map<type_index, std::unordered_map<uuids::uuid, std::shared_ptr<Asset>>> assets;
+        std::vector<AssetStorage> storages; /// Indexed by the type id.
+        uint64_t frame{ 0 };
+
+        struct PendingUpload {
+            std::unique_ptr<UploadBatch> batch;
+            std::vector<std::shared_ptr<Asset>> assets;
+        };
+        std::vector<PendingUpload> pendingUploads; /// Submitted batches which wait for their fence.
+        std::vector<std::shared_ptr<Asset>> decoded; /// Assets decoded by the workers which wait for the upload.
+        std::mutex decodedMutex;
+        std::atomic<uint32_t> decoding{ 0 }; /// Assets which are read or decoded.
+
+        std::vector<std::shared_ptr<Asset>> released; /// Assets of the previous project, retired on the next memory update.
+
+        std::unordered_map<type_index, uint64_t> memoryUsages;
+        uint64_t memoryUsage{ 0 };
+        uint64_t memoryBudget{ 1024ULL * 1024 * 1024 };
 
         static AssetRegistry* Instance;
     };
+
+    template<typename T>
+    T* AssetHandle<T>::get() const {
+        return AssetRegistry::Get()->get(*this);
+    }
+
+    template<typename T>
+    std::shared_ptr<T> AssetHandle<T>::getShared() const {
+        return AssetRegistry::Get()->getShared(*this);
+    }
+
+    template<typename T>
+    uuids::uuid AssetHandle<T>::getUuid() const {
+        return AssetRegistry::Get()->getUuid(*this);
+    }
 }
@@ -8,6 +8,10 @@ Bitmap::Bitmap(const fs::path& filepath) {
     load(filepath);
 }
 
+Bitmap::Bitmap(gsl::span<const uint8_t> buffer, const fs::path& filepath) {
+    load(buffer, filepath);
+}
+
 Bitmap::Bitmap(const glm::uvec2& size, VkFormat format)
         : size{size}
         , format{format}
@@ -21,6 +25,12 @@ Bitmap::Bitmap(std::unique_ptr<uint8_t[]>&& data, const glm::uvec2& size, VkForm
 }
 
 void Bitmap::load(const fs::path& filepath) {
+    FileSystem::ReadBytes(filepath, [this, &filepath](gsl::span<const uint8_t> buffer) {
+        load(buffer, filepath);
+    });
+}
+
+void Bitmap::load(gsl::span<const uint8_t> buffer, const fs::path& filepath) {
 #if FUSION_DEBUG
     auto debugStart = DateTime::Now();
 #endif
@@ -28,7 +38,7 @@ void Bitmap::load(const fs::path& filepath) {
     std::string extension{ FileSystem::GetExtension(filepath) };
     if (auto it = Registry().find(extension); it != Registry().end()) {
         auto& loadFunc = it->second.first;
-        loadFunc(*this, filepath);
+        loadFunc(*this, buffer, filepath);
         path = filepath;
     } else {
         FE_LOG_ERROR("Unknown file extension format: '{}' for the file: '{}'", extension, filepath);
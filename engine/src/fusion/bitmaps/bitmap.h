@@ -9,12 +9,14 @@ namespace fe {
     public:
         Bitmap() = default;
         explicit Bitmap(const fs::path& filepath);
+        Bitmap(gsl::span<const uint8_t> buffer, const fs::path& filepath);
         explicit Bitmap(const glm::uvec2& size, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);
         Bitmap(std::unique_ptr<uint8_t[]>&& data, const glm::uvec2& size, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);
         ~Bitmap() = default;
         NONCOPYABLE(Bitmap); // TEMP
 
         void load(const fs::path& filepath);
+        void load(gsl::span<const uint8_t> buffer, const fs::path& filepath);
         void write(const fs::path& filepath) const;
 
         operator bool() const { return data.operator bool(); }
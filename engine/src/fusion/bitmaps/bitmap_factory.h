@@ -7,7 +7,7 @@ namespace fe {
     template<typename Base>
     class FUSION_API BitmapFactory {
     public:
-        using TLoadMethod = std::function<void(Base&, const fs::path&)>;
+        using TLoadMethod = std::function<void(Base&, gsl::span<const uint8_t>, const fs::path&)>;
         using TWriteMethod = std::function<void(const Base&, const fs::path&)>;
         using TRegistryMap = std::unordered_map<std::string, std::pair<TLoadMethod, TWriteMethod>>;
 
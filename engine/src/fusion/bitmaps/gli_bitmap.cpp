@@ -6,11 +6,8 @@
 
 using namespace fe;
 
-void GliBitmap::Load(Bitmap& bitmap, const fs::path& filepath) {
-    gli::texture texture;
-    FileSystem::ReadBytes(filepath, [&texture](gsl::span<const uint8_t> buffer) {
-        texture = gli::load(reinterpret_cast<const char*>(buffer.data()), buffer.size());
-    });
+void GliBitmap::Load(Bitmap& bitmap, gsl::span<const uint8_t> buffer, const fs::path& filepath) {
+    gli::texture texture = gli::load(reinterpret_cast<const char*>(buffer.data()), buffer.size());
 
     if (texture.empty()) {
         FE_LOG_ERROR("Failed to load bitmap file: '{}'", filepath);
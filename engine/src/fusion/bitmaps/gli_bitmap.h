@@ -6,7 +6,7 @@ namespace fe {
     class FUSION_API GliBitmap : public Bitmap::Registrar<GliBitmap> {
         //inline static const bool Registered = Register(".ktx", ".kmg", ".dds");
     public:
-        static void Load(Bitmap& bitmap, const fs::path& filepath);
+        static void Load(Bitmap& bitmap, gsl::span<const uint8_t> buffer, const fs::path& filepath);
         static void Write(const Bitmap& bitmap, const fs::path& filepath);
     };
 }
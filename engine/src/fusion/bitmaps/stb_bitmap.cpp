@@ -10,7 +10,7 @@
 
 using namespace fe;
 
-void StbBitmap::Load(Bitmap& bitmap, const fs::path& filepath) {
+void StbBitmap::Load(Bitmap& bitmap, gsl::span<const uint8_t> buffer, const fs::path& filepath) {
     std::unique_ptr<uint8_t[]> pixels;
     int width, height, channels;
     int desired_channels = STBI_rgb_alpha;
@@ -18,14 +18,10 @@ void StbBitmap::Load(Bitmap& bitmap, const fs::path& filepath) {
 
     std::string extension{ FileSystem::GetExtension(filepath) };
     if (extension == ".hdr") {
-        FileSystem::ReadBytes(filepath, [&](gsl::span<const uint8_t> buffer) {
-            pixels = std::unique_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(stbi_loadf_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width, &height, &channels, desired_channels)));
-        });
+        pixels = std::unique_ptr<uint8_t[]>(reinterpret_cast<uint8_t*>(stbi_loadf_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width, &height, &channels, desired_channels)));
         hdr = true;
     } else {
-        FileSystem::ReadBytes(filepath, [&](gsl::span<const uint8_t> buffer) {
-            pixels = std::unique_ptr<uint8_t[]>(stbi_load_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width, &height, &channels, desired_channels));
-        });
+        pixels = std::unique_ptr<uint8_t[]>(stbi_load_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width, &height, &channels, desired_channels));
     }
 
     if (!pixels || width == 0 || height == 0) {
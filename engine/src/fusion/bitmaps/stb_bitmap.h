@@ -6,7 +6,7 @@ namespace fe {
     class FUSION_API StbBitmap : public Bitmap::Registrar<StbBitmap> {
         //inline static const bool Registered = Register(".jpeg", ".jpg", ".png", ".bmp", ".hdr", ".psd", ".tga", ".gif", ".pic", ".pgm", ".ppm");
     public:
-        static void Load(Bitmap& bitmap, const fs::path& filepath);
+        static void Load(Bitmap& bitmap, gsl::span<const uint8_t> buffer, const fs::path& filepath);
         static void Write(const Bitmap& bitmap, const fs::path& filepath);
     };
 }
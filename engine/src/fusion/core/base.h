@@ -38,6 +38,30 @@ namespace fe {
     /// https://mikejsavage.co.uk/blog/cpp-tricks-type-id.html
     inline type_index type_id_seq = 0;
     template<typename T> inline const type_index type_id = type_id_seq++;
+
+    /**
+     * Gets the unqualified name of a type, parsed from the signature of the function.
+     * @tparam T The type.
+     * @return The name.
+     */
+    template<typename T>
+    std::string_view type_name() {
+#if defined(_MSC_VER)
+        std::string_view name{ __FUNCSIG__ };
+        auto begin = name.find("type_name<") + 10;
+        auto end = name.rfind(">(void)");
+#else
+        std::string_view name{ __PRETTY_FUNCTION__ };
+        auto begin = name.find("T = ") + 4;
+        auto end = name.find_first_of(";]", begin);
+#endif
+        name = name.substr(begin, end - begin);
+        if (auto scope = name.rfind("::"); scope != std::string_view::npos)
+            name.remove_prefix(scope + 2);
+        else if (auto space = name.rfind(' '); space != std::string_view::npos)
+            name.remove_prefix(space + 1);
+        return name;
+    }
 }
 
 namespace fe {
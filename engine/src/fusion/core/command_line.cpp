@@ -39,6 +39,14 @@ CommandLineParser::CommandLineParser() {
     add("benchmarkresultfile", { "-bf", "--benchfilename" }, true, "Set file name for benchmark results");
     add("benchmarkresultframes", { "-bt", "--benchframetimes" }, false, "Save frame times to benchmark results file");
     add("benchmarkframes", { "-bfs", "--benchmarkframes" }, true, "Only render the given number of frames");
+    add("renderthread", { "-rt", "--renderthread" }, false, "Record and submit frames on a separate render thread");
+    add("headless", { "-hl", "--headless" }, false, "Render into offscreen images without a window");
+    add("dumpframes", { "-df", "--dumpframes" }, true, "Write every rendered offscreen frame into the given directory");
+    add("profile", { "-pf", "--profile" }, true, "Capture the given number of frames with the CPU profiler");
+    add("profilefile", { "-pff", "--profilefile" }, true, "Set file name for the CPU profiler trace");
+    add("hitchtrace", { "-ht", "--hitchtrace" }, true, "Write the CPU profiler trace of every hitched frame into the given directory");
+    add("assetbudget", { "-ab", "--assetbudget" }, true, "Set the memory budget of loaded assets in megabytes, 0 disables eviction");
+    add("pack", { "-pk", "--pack" }, true, "Mount a pack file at its directory, packed files are read before the loose ones");
 }
 
 void CommandLineParser::add(std::string_view name, std::vector<std::string>&& commands, bool hasValue, std::string&& help) {
@@ -86,26 +94,29 @@ void CommandLineParser::printHelp() {
     std::cout << "Press any key to close...";
 }
 
-bool CommandLineParser::isSet(const std::string& name) {
-    return ((options.find(name) != options.end()) && options[name].set);
+bool CommandLineParser::isSet(const std::string& name) const {
+    auto it = options.find(name);
+    return it != options.end() && it->second.set;
 }
 
 template<typename T>
-T CommandLineParser::getValue(const std::string& name, const T& defaultValue) {
+T CommandLineParser::getValue(const std::string& name, const T& defaultValue) const {
     throw std::runtime_error("Unknown value");
 }
 
 template<>
-std::string CommandLineParser::getValue<std::string>(const std::string& name, const std::string& defaultValue) {
-    FE_ASSERT(options.find(name) != options.end());
-    const std::string& value = options[name].value;
+std::string CommandLineParser::getValue<std::string>(const std::string& name, const std::string& defaultValue) const {
+    auto it = options.find(name);
+    FE_ASSERT(it != options.end());
+    const std::string& value = it->second.value;
     return !value.empty() ? value : defaultValue;
 }
 
 template<>
-int CommandLineParser::getValue<int>(const std::string& name, const int& defaultValue) {
-    FE_ASSERT(options.find(name) != options.end());
-    const std::string& value = options[name].value;
+int CommandLineParser::getValue<int>(const std::string& name, const int& defaultValue) const {
+    auto it = options.find(name);
+    FE_ASSERT(it != options.end());
+    const std::string& value = it->second.value;
     if (!value.empty()) {
         int result = std::stoi(value);
         return (result > 0) ? result : defaultValue;
@@ -115,9 +126,10 @@ int CommandLineParser::getValue<int>(const std::string& name, const int& default
 }
 
 template<>
-float CommandLineParser::getValue<float>(const std::string& name, const float& defaultValue) {
-    FE_ASSERT(options.find(name) != options.end());
-    const std::string& value = options[name].value;
+float CommandLineParser::getValue<float>(const std::string& name, const float& defaultValue) const {
+    auto it = options.find(name);
+    FE_ASSERT(it != options.end());
+    const std::string& value = it->second.value;
     if (!value.empty()) {
         float result = std::stof(value);
         return (result > 0) ? result : defaultValue;
@@ -127,9 +139,10 @@ float CommandLineParser::getValue<float>(const std::string& name, const float& d
 }
 
 template<>
-bool CommandLineParser::getValue<bool>(const std::string& name, const bool& defaultValue) {
-    FE_ASSERT(options.find(name) != options.end());
-    const std::string& value = options[name].value;
+bool CommandLineParser::getValue<bool>(const std::string& name, const bool& defaultValue) const {
+    auto it = options.find(name);
+    FE_ASSERT(it != options.end());
+    const std::string& value = it->second.value;
     if (!value.empty()) {
         return String::ConvertBool(value);
     } else {
@@ -22,10 +22,10 @@ namespace fe {
         void parse(const CommandLineArgs& arguments);
 
         void printHelp();
-        bool isSet(const std::string& name);
+        bool isSet(const std::string& name) const;
 
         template<typename T>
-        T getValue(const std::string& name, const T& defaultValue);
+        T getValue(const std::string& name, const T& defaultValue) const;
 
     private:
         struct CommandLineOption {
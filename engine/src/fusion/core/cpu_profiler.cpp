@@ -0,0 +1,261 @@
+#include "cpu_profiler.h"
+
+#include <mutex>
+
+using namespace fe;
+
+static constexpr size_t EventCapacity = 1 << 15;
+
+struct ProfileEvent {
+    const char* name; /// Null for the end of a scope.
+    int64_t timestamp;
+};
+
+/**
+ * Single producer ring, only the owning thread advances the head and only the draining thread advances the tail.
+ */
+struct ThreadEvents {
+    std::array<ProfileEvent, EventCapacity> events;
+    std::atomic<size_t> head{ 0 };
+    std::atomic<size_t> tail{ 0 };
+    uint32_t id{ 0 };
+    std::string name;
+};
+
+struct CapturedEvent {
+    const char* name;
+    int64_t timestamp;
+    uint32_t thread;
+};
+
+std::atomic<bool> CpuProfiler::Enabled{ false };
+
+static const auto Epoch = std::chrono::steady_clock::now();
+static std::mutex ThreadsMutex;
+static std::vector<std::unique_ptr<ThreadEvents>> Threads;
+static std::vector<CapturedEvent> Captured;
+static std::vector<CapturedEvent> LastFrame; /// Events of the previous frame, kept while no capture runs.
+static std::atomic<size_t> Dropped{ 0 };
+static uint32_t CaptureFrames{ 0 }; /// Frames left to capture.
+static fs::path CapturePath;
+static bool FrameOpen{ false };
+
+static thread_local ThreadEvents* LocalEvents{ nullptr };
+static thread_local std::string LocalName;
+static thread_local size_t LocalOpenScopes{ 0 }; /// Recorded scopes of the thread which have a slot reserved for their end.
+static thread_local size_t LocalSkippedScopes{ 0 }; /// Depth of the scopes dropped on a full ring, their nested scopes are dropped too.
+
+static int64_t GetTimestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count();
+}
+
+static ThreadEvents& GetLocalEvents() {
+    if (!LocalEvents) {
+        std::unique_lock<std::mutex> lock(ThreadsMutex);
+        auto& events = Threads.emplace_back(std::make_unique<ThreadEvents>());
+        events->id = static_cast<uint32_t>(Threads.size());
+        events->name = LocalName;
+        LocalEvents = events.get();
+    }
+    return *LocalEvents;
+}
+
+static void Push(const char* name) {
+    auto& buffer = GetLocalEvents();
+    auto head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % EventCapacity] = { name, GetTimestamp() };
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Scopes are dropped as a whole, a begin is only recorded when its end and the ends of the open scopes still fit into the ring,
+ * so the trace stays nested when the drain falls behind.
+ */
+static void PushBegin(const char* name) {
+    if (LocalSkippedScopes == 0) {
+        auto& buffer = GetLocalEvents();
+        auto used = buffer.head.load(std::memory_order_relaxed) - buffer.tail.load(std::memory_order_acquire);
+        if (used + LocalOpenScopes + 2 <= EventCapacity) {
+            ++LocalOpenScopes;
+            Push(name);
+            return;
+        }
+    }
+    ++LocalSkippedScopes;
+    Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void PushEnd() {
+    if (LocalSkippedScopes != 0) {
+        --LocalSkippedScopes;
+        return;
+    }
+    if (LocalOpenScopes == 0)
+        return;
+    --LocalOpenScopes;
+    Push(nullptr);
+}
+
+/**
+ * Moves the recorded events out of the thread rings, must be called with the threads mutex locked.
+ * @param target The events to append to, or nullptr to discard them.
+ */
+static void Drain(std::vector<CapturedEvent>* target) {
+    for (const auto& buffer : Threads) {
+        auto head = buffer->head.load(std::memory_order_acquire);
+        auto tail = buffer->tail.load(std::memory_order_relaxed);
+        if (target) {
+            for (auto i = tail; i != head; ++i) {
+                const auto& event = buffer->events[i % EventCapacity];
+                target->push_back({ event.name, event.timestamp, buffer->id });
+            }
+        }
+        buffer->tail.store(head, std::memory_order_release);
+    }
+}
+
+static std::string Escape(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (auto c : text) {
+        if (c == '"' || c == '\\')
+            result.push_back('\\');
+        result.push_back(c);
+    }
+    return result;
+}
+
+/**
+ * Writes the events, must be called with the threads mutex locked.
+ */
+static bool WriteTrace(const fs::path& filepath, const std::vector<CapturedEvent>& events) {
+    std::ofstream file{ filepath };
+    if (!file) {
+        FE_LOG_ERROR("Failed to open trace file: '{}'", filepath);
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separate = [&] {
+        if (!first)
+            file << ",\n";
+        first = false;
+    };
+
+    for (const auto& buffer : Threads) {
+        if (buffer->name.empty())
+            continue;
+        separate();
+        file << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", buffer->id, Escape(buffer->name));
+    }
+
+    // A capture can start inside of a scope, so scopes are balanced per thread
+    std::vector<std::vector<const char*>> stacks(Threads.size() + 1);
+    int64_t lastTimestamp = 0;
+
+    for (const auto& event : events) {
+        auto& stack = stacks[event.thread];
+        if (event.name) {
+            stack.push_back(event.name);
+            separate();
+            file << fmt::format(R"({{"name":"{}","ph":"B","pid":1,"tid":{},"ts":{:.3f}}})", Escape(event.name), event.thread, static_cast<double>(event.timestamp) / 1000.0);
+        } else {
+            if (stack.empty())
+                continue;
+            stack.pop_back();
+            separate();
+            file << fmt::format(R"({{"ph":"E","pid":1,"tid":{},"ts":{:.3f}}})", event.thread, static_cast<double>(event.timestamp) / 1000.0);
+        }
+        lastTimestamp = std::max(lastTimestamp, event.timestamp);
+    }
+
+    for (const auto& [thread, stack] : enumerate(stacks)) {
+        for (size_t i = 0; i < stack.size(); ++i) {
+            separate();
+            file << fmt::format(R"({{"ph":"E","pid":1,"tid":{},"ts":{:.3f}}})", thread, static_cast<double>(lastTimestamp) / 1000.0);
+        }
+    }
+
+    file << "]}\n";
+
+    FE_LOG_INFO("Trace with {} events written to: '{}'", events.size(), filepath);
+    return true;
+}
+
+void CpuProfiler::SetEnabled(bool flag) {
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    if (flag == Enabled.load(std::memory_order_relaxed))
+        return;
+
+    // Events left from the previous session would be merged into the next frame
+    Drain(nullptr);
+    LastFrame.clear();
+    FrameOpen = false;
+    Enabled.store(flag, std::memory_order_relaxed);
+}
+
+void CpuProfiler::Begin(const char* name) {
+    PushBegin(name);
+}
+
+void CpuProfiler::End() {
+    PushEnd();
+}
+
+void CpuProfiler::SetThreadName(const char* name) {
+    LocalName = name;
+    if (LocalEvents) {
+        std::unique_lock<std::mutex> lock(ThreadsMutex);
+        LocalEvents->name = LocalName;
+    }
+}
+
+void CpuProfiler::EndFrame() {
+    if (!IsEnabled())
+        return;
+
+    if (FrameOpen)
+        End();
+    Begin("Frame");
+    FrameOpen = true;
+
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    bool capturing = CaptureFrames > 0;
+    if (!capturing)
+        LastFrame.clear();
+    Drain(capturing ? &Captured : &LastFrame);
+
+    if (auto dropped = Dropped.exchange(0, std::memory_order_relaxed))
+        FE_LOG_WARNING("CPU profiler dropped {} scopes, ring buffer of a thread is full", dropped);
+
+    if (capturing && --CaptureFrames == 0) {
+        WriteTrace(CapturePath, Captured);
+        Captured.clear();
+    }
+}
+
+void CpuProfiler::Capture(uint32_t frames, const fs::path& filepath) {
+    SetEnabled(true);
+
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    Captured.clear();
+    CaptureFrames = std::max(frames, 1U);
+    CapturePath = filepath;
+}
+
+bool CpuProfiler::IsCapturing() {
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    return CaptureFrames > 0;
+}
+
+bool CpuProfiler::Export(const fs::path& filepath) {
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    return WriteTrace(filepath, Captured);
+}
+
+bool CpuProfiler::ExportLastFrame(const fs::path& filepath) {
+    std::unique_lock<std::mutex> lock(ThreadsMutex);
+    return WriteTrace(filepath, LastFrame);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+
+namespace fe {
+    /**
+     * @brief Built-in profiler which records scope begin and end events with nanosecond timestamps into a lock-free ring buffer per thread.
+     * Recording is disabled by default, so a scope only costs a branch. Events of all threads are drained at the end of every frame
+     * and kept while a capture runs, captures are written in the Chrome trace event format which chrome://tracing and Perfetto open.
+     */
+    class FUSION_API CpuProfiler {
+    public:
+        static bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+        static void SetEnabled(bool flag);
+
+        /**
+         * Records the beginning of a scope on the calling thread.
+         * @param name The scope name, it has to outlive the capture, so string literals are expected.
+         */
+        static void Begin(const char* name);
+
+        /**
+         * Records the end of the last scope opened on the calling thread.
+         */
+        static void End();
+
+        /**
+         * Sets the name the calling thread is shown with in the trace.
+         * @param name The thread name.
+         */
+        static void SetThreadName(const char* name);
+
+        /**
+         * Marks the end of a frame, drains the events of all threads and writes the capture once its frames were recorded.
+         * Must be called from the main thread.
+         */
+        static void EndFrame();
+
+        /**
+         * Enables the profiler and captures the next frames into a trace file.
+         * @param frames The number of frames to capture.
+         * @param filepath The file to write the trace to.
+         */
+        static void Capture(uint32_t frames, const fs::path& filepath);
+        static bool IsCapturing();
+
+        /**
+         * Writes the events captured so far in the Chrome trace event format.
+         * @param filepath The file to write the trace to.
+         * @return If the file was written.
+         */
+        static bool Export(const fs::path& filepath);
+
+        /**
+         * Writes the events of the last finished frame in the Chrome trace event format, they are kept while no capture runs.
+         * @param filepath The file to write the trace to.
+         * @return If the file was written.
+         */
+        static bool ExportLastFrame(const fs::path& filepath);
+
+    private:
+        static std::atomic<bool> Enabled;
+    };
+
+    /**
+     * @brief Records the lifetime of the scope into the CPU profiler.
+     */
+    class FUSION_API CpuProfileScope {
+    public:
+        explicit CpuProfileScope(const char* name) : active{CpuProfiler::IsEnabled()} {
+            if (active)
+                CpuProfiler::Begin(name);
+        }
+        ~CpuProfileScope() {
+            if (active)
+                CpuProfiler::End();
+        }
+        CpuProfileScope(const CpuProfileScope&) = delete;
+        CpuProfileScope& operator=(const CpuProfileScope&) = delete;
+
+    private:
+        bool active;
+    };
+}
@@ -45,6 +45,12 @@ void DefaultApplication::onStart() {
 
     deserialise();
 
+    // Render stages are drawn into offscreen images, so no window is created
+    if (Engine::Get()->getCommandLineParser().isSet("headless")) {
+        FE_LOG_INFO("Running headless");
+        return;
+    }
+
     WindowInfo windowInfo = {};
     windowInfo.size = projectSettings.size;
     windowInfo.title = projectSettings.title;
@@ -1,8 +1,12 @@
 #include "engine.h"
 #include "module.h"
 #include "time.h"
+#include "thread_pool.h"
+#include "cpu_profiler.h"
+#include "perf_counters.h"
 
 #include "fusion/devices/device_manager.h"
+#include "fusion/filesystem/io_service.h"
 
 #include "fusion/bitmaps/gli_bitmap.h"
 #include "fusion/bitmaps/stb_bitmap.h"
@@ -24,12 +28,21 @@ Engine::Engine(CommandLineArgs&& args)
 
     commandLineParser.parse(commandLineArgs);
 
+    FUSION_PROFILE_SETTHREADNAME("Main Thread");
+    if (commandLineParser.isSet("profile"))
+        CpuProfiler::Capture(static_cast<uint32_t>(commandLineParser.getValue<int>("profile", 1)), commandLineParser.getValue<std::string>("profilefile", "fusion-trace.json"));
+
+    threadPool = std::make_unique<ThreadPool>();
+    ioService = IoService::Init();
     devices = DeviceManager::Init();
 }
 
 Engine::~Engine() {
     application.reset();
     moduleHolder.reset();
+    // Fallback service reads on the workers
+    ioService.reset();
+    threadPool.reset();
     devices.reset();
     logger.reset();
     Instance = nullptr;
@@ -77,18 +90,33 @@ void Engine::shutdown() {
 }
 
 void Engine::updateMain() {
-    moduleHolder->updateModules<ModuleBase::Stage::Pre>();
+    {
+        FUSION_PROFILE_SCOPE("Pre Update");
+        moduleHolder->updateModules<ModuleBase::Stage::Pre>();
+    }
 
-    devices->onUpdate();
-    if (application) {
-        if (!application->started) {
-            application->onStart();
-            application->started = true;
+    {
+        FUSION_PROFILE_SCOPE("Application Update");
+        devices->onUpdate();
+        if (application) {
+            if (!application->started) {
+                application->onStart();
+                application->started = true;
+            }
+            application->onUpdate();
         }
-        application->onUpdate();
     }
 
-    moduleHolder->updateModules<ModuleBase::Stage::Post>();
+    {
+        FUSION_PROFILE_SCOPE("Post Update");
+        moduleHolder->updateModules<ModuleBase::Stage::Post>();
+    }
+
+    {
+        FUSION_PROFILE_SCOPE("Render");
+        moduleHolder->updateModules<ModuleBase::Stage::Render>();
+    }
 
-    moduleHolder->updateModules<ModuleBase::Stage::Render>();
+    PerfCounters::EndFrame();
+    FUSION_PROFILE_FRAMEMARKER();
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 namespace fe {
     class DeviceManager;
     class ModuleHolder;
+    class ThreadPool;
+    class IoService;
     class FUSION_API Engine {
     protected:
         /**
@@ -104,6 +106,8 @@ namespace fe {
         Version version;
 
         std::unique_ptr<Log> logger;
+        std::unique_ptr<ThreadPool> threadPool;
+        std::unique_ptr<IoService> ioService;
         std::unique_ptr<DeviceManager> devices;
         std::unique_ptr<Application> application;
         std::unique_ptr<ModuleHolder> moduleHolder;
@@ -0,0 +1,22 @@
+#include "frame_timings.h"
+
+using namespace fe;
+
+std::atomic<bool> FrameTimings::Enabled{ false };
+std::array<std::atomic<int64_t>, FrameTimings::PhaseCount> FrameTimings::Timings{};
+
+float FrameTimings::Exchange(Phase phase) {
+    auto nanoseconds = Timings[static_cast<size_t>(phase)].exchange(0, std::memory_order_relaxed);
+    return static_cast<float>(nanoseconds) / 1000000.0f;
+}
+
+const char* FrameTimings::GetName(Phase phase) {
+    switch (phase) {
+        case Phase::Hierarchy: return "hierarchy";
+        case Phase::Culling: return "culling";
+        case Phase::Descriptors: return "descriptors";
+        case Phase::Recording: return "recording";
+        case Phase::Submit: return "submit";
+        default: return "unknown";
+    }
+}
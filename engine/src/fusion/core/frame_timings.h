@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+
+namespace fe {
+    /**
+     * @brief Accumulates CPU time spent in the phases of a frame, phases can be timed from any thread.
+     * Timing is disabled by default, so a scope only costs a branch until a tool such as the benchmark enables it.
+     */
+    class FUSION_API FrameTimings {
+    public:
+        enum class Phase : uint8_t { Hierarchy, Culling, Descriptors, Recording, Submit, Count };
+        static constexpr size_t PhaseCount = static_cast<size_t>(Phase::Count);
+
+        static bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+        static void SetEnabled(bool flag) { Enabled.store(flag, std::memory_order_relaxed); }
+
+        /**
+         * Adds time to a phase.
+         * @param phase The phase.
+         * @param nanoseconds The time spent in the phase.
+         */
+        static void Add(Phase phase, int64_t nanoseconds) { Timings[static_cast<size_t>(phase)].fetch_add(nanoseconds, std::memory_order_relaxed); }
+
+        /**
+         * Gets the time accumulated by a phase since the last call and resets it.
+         * @param phase The phase.
+         * @return The time in milliseconds.
+         */
+        static float Exchange(Phase phase);
+
+        static const char* GetName(Phase phase);
+
+    private:
+        static std::atomic<bool> Enabled;
+        static std::array<std::atomic<int64_t>, PhaseCount> Timings;
+    };
+
+    /**
+     * @brief Adds the lifetime of the scope to a frame phase.
+     */
+    class FUSION_API ScopedFrameTiming {
+    public:
+        explicit ScopedFrameTiming(FrameTimings::Phase phase) : phase{phase}, enabled{FrameTimings::IsEnabled()} {
+            if (enabled)
+                start = std::chrono::steady_clock::now();
+        }
+        ~ScopedFrameTiming() {
+            if (enabled)
+                FrameTimings::Add(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+        NONCOPYABLE(ScopedFrameTiming);
+
+    private:
+        FrameTimings::Phase phase;
+        bool enabled;
+        std::chrono::steady_clock::time_point start;
+    };
+}
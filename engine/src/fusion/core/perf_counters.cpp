@@ -0,0 +1,79 @@
+#include "perf_counters.h"
+
+using namespace fe;
+
+std::array<std::atomic<int64_t>, PerfCounters::CounterCount> PerfCounters::Totals{};
+std::array<std::array<int64_t, PerfCounters::HistorySize>, PerfCounters::CounterCount> PerfCounters::History{};
+size_t PerfCounters::HistoryHead{ 0 };
+size_t PerfCounters::HistoryCount{ 0 };
+std::mutex PerfCounters::HistoryMutex;
+
+/**
+ * Counters of a single thread, blocks stay registered after the thread exits so nothing counted is lost.
+ */
+struct CounterBlock {
+    std::array<std::atomic<int64_t>, PerfCounters::CounterCount> values{};
+};
+
+static std::mutex BlocksMutex;
+static std::vector<std::unique_ptr<CounterBlock>> Blocks;
+static thread_local CounterBlock* LocalBlock{ nullptr };
+
+void PerfCounters::Add(Counter counter, int64_t value) {
+    if (!LocalBlock) {
+        std::unique_lock<std::mutex> lock(BlocksMutex);
+        LocalBlock = Blocks.emplace_back(std::make_unique<CounterBlock>()).get();
+    }
+    LocalBlock->values[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void PerfCounters::EndFrame() {
+    std::array<int64_t, CounterCount> totals{};
+    {
+        std::unique_lock<std::mutex> lock(BlocksMutex);
+        for (const auto& block : Blocks) {
+            for (size_t i = 0; i < CounterCount; ++i) {
+                totals[i] += block->values[i].exchange(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(HistoryMutex);
+    for (size_t i = 0; i < CounterCount; ++i) {
+        Totals[i].store(totals[i], std::memory_order_relaxed);
+        History[i][HistoryHead] = totals[i];
+    }
+    HistoryHead = (HistoryHead + 1) % HistorySize;
+    HistoryCount = std::min(HistoryCount + 1, HistorySize);
+}
+
+std::vector<int64_t> PerfCounters::GetHistory(Counter counter) {
+    std::unique_lock<std::mutex> lock(HistoryMutex);
+    const auto& history = History[static_cast<size_t>(counter)];
+
+    std::vector<int64_t> result;
+    result.reserve(HistoryCount);
+    for (size_t i = 0; i < HistoryCount; ++i) {
+        result.push_back(history[(HistoryHead + HistorySize - HistoryCount + i) % HistorySize]);
+    }
+    return result;
+}
+
+const char* PerfCounters::GetName(Counter counter) {
+    switch (counter) {
+        case Counter::DrawCalls: return "Draw Calls";
+        case Counter::Triangles: return "Triangles";
+        case Counter::PipelineBinds: return "Pipeline Binds";
+        case Counter::DescriptorWrites: return "Descriptor Writes";
+        case Counter::BufferUploads: return "Buffer Uploads";
+        case Counter::UploadedBytes: return "Uploaded Bytes";
+        case Counter::RenderPasses: return "Render Passes";
+        case Counter::SecondaryBuffers: return "Secondary Buffers";
+        case Counter::CulledObjects: return "Culled Objects";
+        case Counter::TransformUpdates: return "Transform Updates";
+        case Counter::AssetLoads: return "Asset Loads";
+        case Counter::FileReads: return "File Reads";
+        case Counter::FileReadBytes: return "File Read Bytes";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace fe {
+    /**
+     * @brief Registry of per-frame counters such as draw calls and descriptor writes.
+     * Every thread increments its own block of atomics, so counting never contends, the blocks are summed and reset at the end of a frame
+     * and the totals are kept in a history buffer.
+     */
+    class FUSION_API PerfCounters {
+    public:
+        enum class Counter : uint8_t {
+            DrawCalls,
+            Triangles,
+            PipelineBinds,
+            DescriptorWrites,
+            BufferUploads,
+            UploadedBytes,
+            RenderPasses,
+            SecondaryBuffers,
+            CulledObjects,
+            TransformUpdates,
+            AssetLoads,
+            FileReads,
+            FileReadBytes,
+            Count
+        };
+        static constexpr size_t CounterCount = static_cast<size_t>(Counter::Count);
+        static constexpr size_t HistorySize = 240;
+
+        /**
+         * Adds a value to a counter of the current frame, can be called from any thread.
+         * @param counter The counter.
+         * @param value The value to add.
+         */
+        static void Add(Counter counter, int64_t value = 1);
+
+        /**
+         * Sums the counters of all threads into the totals of the finished frame and resets them. Must be called from the main thread.
+         */
+        static void EndFrame();
+
+        /**
+         * Gets the total of a counter in the last finished frame.
+         * @param counter The counter.
+         * @return The total.
+         */
+        static int64_t Get(Counter counter) { return Totals[static_cast<size_t>(counter)].load(std::memory_order_relaxed); }
+
+        /**
+         * Gets the totals of a counter in the last frames.
+         * @param counter The counter.
+         * @return The totals from the oldest to the newest frame.
+         */
+        static std::vector<int64_t> GetHistory(Counter counter);
+
+        static const char* GetName(Counter counter);
+
+    private:
+        static std::array<std::atomic<int64_t>, CounterCount> Totals;
+        static std::array<std::array<int64_t, HistorySize>, CounterCount> History;
+        static size_t HistoryHead;
+        static size_t HistoryCount;
+        static std::mutex HistoryMutex;
+    };
+}
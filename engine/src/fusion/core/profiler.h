@@ -1,6 +1,6 @@
 #pragma once
 
-#if FUSION_PROFILE
+#if FUSION_PROFILE && TRACY_ENABLE
 #ifdef FUSION_PLATFORM_WINDOWS
 #define TRACY_CALLSTACK 1
 #endif
@@ -12,10 +12,14 @@
 #define FUSION_PROFILE_LOCKMARKER(var) LockMark(var)
 #define FUSION_PROFILE_SETTHREADNAME(name) tracy::SetThreadName(name)
 #else
-#define FUSION_PROFILE_SCOPE(name)
-#define FUSION_PROFILE_FUNCTION()
-#define FUSION_PROFILE_FRAMEMARKER()
+// Without Tracy scopes go to the built-in profiler, which only records while it is enabled
+#include "cpu_profiler.h"
+#define FUSION_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FUSION_PROFILE_CONCAT(a, b) FUSION_PROFILE_CONCAT_IMPL(a, b)
+#define FUSION_PROFILE_SCOPE(name) ::fe::CpuProfileScope FUSION_PROFILE_CONCAT(profileScope, __LINE__){name}
+#define FUSION_PROFILE_FUNCTION() FUSION_PROFILE_SCOPE(__FUNCTION__)
+#define FUSION_PROFILE_FRAMEMARKER() ::fe::CpuProfiler::EndFrame()
 #define FUSION_PROFILE_LOCK(type, var, name) type var
 #define FUSION_PROFILE_LOCKMARKER(var)
-#define FUSION_PROFILE_SETTHREADNAME(name)
-#endif
\ No newline at end of file
+#define FUSION_PROFILE_SETTHREADNAME(name) ::fe::CpuProfiler::SetThreadName(name)
+#endif
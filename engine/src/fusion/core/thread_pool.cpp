@@ -0,0 +1,97 @@
+#include "thread_pool.h"
+
+using namespace fe;
+
+ThreadPool* ThreadPool::Instance = nullptr;
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+    Instance = this;
+
+    workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::onWork, this);
+    }
+
+    FE_LOG_INFO("Thread pool started with {} workers", threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    Instance = nullptr;
+}
+
+void ThreadPool::onWork() {
+    FUSION_PROFILE_SETTHREADNAME("Worker");
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        FUSION_PROFILE_SCOPE("Task");
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function) {
+    if (count == 0)
+        return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunks = (count + grainSize - 1) / grainSize;
+
+    if (chunks == 1 || workers.empty()) {
+        function(0, count);
+        return;
+    }
+
+    struct Batch {
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    // Helpers can start after the loop has finished, so the shared state outlives the call
+    auto batch = std::make_shared<Batch>();
+    auto run = [batch, chunks, count, grainSize, &function] {
+        size_t chunk;
+        while ((chunk = batch->next++) < chunks) {
+            size_t begin = chunk * grainSize;
+            function(begin, std::min(begin + grainSize, count));
+            if (++batch->done == chunks) {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(chunks - 1, workers.size());
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (size_t i = 0; i < helpers; ++i) {
+            tasks.emplace(run);
+        }
+    }
+    condition.notify_all();
+
+    run();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&batch, chunks] { return batch->done == chunks; });
+}
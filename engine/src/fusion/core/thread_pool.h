@@ -0,0 +1,65 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <condition_variable>
+
+namespace fe {
+    /**
+     * @brief Fixed set of worker threads which execute queued tasks. The calling thread takes part in parallel loops,
+     * so they can also be started from inside of a task.
+     */
+    class FUSION_API ThreadPool {
+    public:
+        /**
+         * Starts the worker threads.
+         * @param threadCount The number of workers, by default one per core except the calling one.
+         */
+        explicit ThreadPool(uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 2U) - 1);
+        ~ThreadPool();
+        NONCOPYABLE(ThreadPool);
+
+        static ThreadPool* Get() { return Instance; }
+
+        /**
+         * Queues a task to the workers.
+         * @param function The task to run.
+         * @return The future result of the task.
+         */
+        template<typename F>
+        auto enqueue(F&& function) -> std::future<std::invoke_result_t<F>> {
+            using R = std::invoke_result_t<F>;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(function));
+            auto future = task->get_future();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                tasks.emplace([task] { (*task)(); });
+            }
+            condition.notify_one();
+            return future;
+        }
+
+        /**
+         * Splits the range into chunks and runs them on the workers and on the calling thread, returns when every chunk is done.
+         * @param count The number of elements.
+         * @param grainSize The number of elements in a chunk.
+         * @param function The function which is called with the begin and end of a chunk.
+         */
+        void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    private:
+        void onWork();
+
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping{ false };
+
+        static ThreadPool* Instance;
+    };
+}
@@ -1,9 +1,16 @@
 #include "time.h"
+#include "engine.h"
+#include "cpu_profiler.h"
+
+#include <numeric>
 
 using namespace fe;
 
 Time* Time::Instance = nullptr;
 
+/// Frames recorded before the hitch detector trusts the median.
+static const size_t HITCH_WARMUP_FRAMES = 30;
+
 Time::Time() {
     Instance = this;
 }
@@ -14,6 +21,13 @@ Time::~Time() {
 
 void Time::onStart() {
     lastTime = frameTime = DateTime::Now();
+
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    if (commandLineParser.isSet("hitchtrace")) {
+        auto settings = hitchSettings;
+        settings.traceDirectory = commandLineParser.getValue<std::string>("hitchtrace", "hitches");
+        SetHitchSettings(settings);
+    }
 }
 
 void Time::onUpdate() {
@@ -29,8 +43,112 @@ void Time::onUpdate() {
         frameNumber = 0;
         frameTime = currentTime;
     }
+
+    // First delta includes the startup, so it is not a frame
+    if (frameCount > 1) {
+        auto milliseconds = deltaTime.asMilliseconds<float>();
+        detectHitch(milliseconds);
+        recordFrame(milliseconds);
+    }
 }
 
 void Time::onStop() {
 }
 
+Time::FrameStats Time::FrameTimeStats() {
+    auto& time = *Instance;
+    if (time.frameStatsFrame == time.frameCount)
+        return time.frameStats;
+
+    time.frameStatsFrame = time.frameCount;
+    time.frameStats = {};
+
+    auto& sorted = time.sortedTimes;
+    if (time.frameTimes.empty())
+        return time.frameStats;
+
+    sorted.assign(time.frameTimes.begin(), time.frameTimes.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](float p) {
+        auto index = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+        return sorted[std::min(index, sorted.size() - 1)];
+    };
+
+    time.frameStats.p50 = percentile(0.50f);
+    time.frameStats.p95 = percentile(0.95f);
+    time.frameStats.p99 = percentile(0.99f);
+    time.frameStats.max = sorted.back();
+    time.frameStats.average = static_cast<float>(time.frameTimesTotal / static_cast<double>(sorted.size()));
+    time.frameStats.frames = static_cast<uint32_t>(sorted.size());
+    return time.frameStats;
+}
+
+void Time::SetHitchSettings(const HitchSettings& settings) {
+    Instance->hitchSettings = settings;
+    if (!settings.traceDirectory.empty())
+        CpuProfiler::SetEnabled(true);
+}
+
+static size_t GetHistogramBucket(float milliseconds) {
+    return std::min(static_cast<size_t>(std::max(milliseconds, 0.0f) / Time::HistogramBucketWidth), Time::HistogramSize - 1);
+}
+
+void Time::recordFrame(float milliseconds) {
+    frameTimes.push_back(milliseconds);
+    frameTimesTotal += milliseconds;
+    ++histogram[GetHistogramBucket(milliseconds)];
+
+    // Window is kept by time, so the histogram covers the same seconds at any frame rate
+    double window = statsWindow * 1000.0;
+    while (frameTimes.size() > 1 && frameTimesTotal - frameTimes.front() >= window) {
+        auto front = frameTimes.front();
+        frameTimes.pop_front();
+        frameTimesTotal -= front;
+        --histogram[GetHistogramBucket(front)];
+        ++removedFrames;
+    }
+
+    // Running sum drifts over long sessions, summing once per window keeps the cost constant per frame
+    if (removedFrames >= frameTimes.size()) {
+        frameTimesTotal = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0);
+        removedFrames = 0;
+    }
+}
+
+void Time::detectHitch(float milliseconds) {
+    bool hitch = hitchSettings.absoluteThreshold > 0.0f && milliseconds >= hitchSettings.absoluteThreshold;
+
+    // Median comes from the histogram, so the check stays constant time
+    if (!hitch && hitchSettings.relativeThreshold > 0.0f && frameTimes.size() >= HITCH_WARMUP_FRAMES)
+        hitch = milliseconds >= hitchSettings.relativeThreshold * getHistogramMedian();
+
+    if (!hitch)
+        return;
+
+    ++hitchCount;
+    FE_LOG_WARNING("Hitch at frame {}: {:.2f}ms", frameCount, milliseconds);
+
+    if (hitchSettings.traceDirectory.empty() || !CpuProfiler::IsEnabled())
+        return;
+
+    if (lastTraceTime.asMicroseconds() != 0 && (lastTime - lastTraceTime).asSeconds<float>() < hitchSettings.cooldown)
+        return;
+    lastTraceTime = lastTime;
+
+    // Profiler frame marker ran at the end of the hitched frame, so its last frame is the one which took long
+    std::error_code ec;
+    fs::create_directories(hitchSettings.traceDirectory, ec);
+    CpuProfiler::ExportLastFrame(hitchSettings.traceDirectory / fmt::format("hitch_{:06}.json", frameCount));
+}
+
+float Time::getHistogramMedian() const {
+    auto half = (frameTimes.size() + 1) / 2;
+    size_t count = 0;
+    for (size_t i = 0; i < HistogramSize; ++i) {
+        count += histogram[i];
+        if (count >= half)
+            return (static_cast<float>(i) + 0.5f) * HistogramBucketWidth;
+    }
+    return static_cast<float>(HistogramSize) * HistogramBucketWidth;
+}
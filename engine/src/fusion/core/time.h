@@ -2,6 +2,8 @@
 
 #include "fusion/utils/date_time.h"
 
+#include <deque>
+
 namespace fe {
     template<typename T>
     class Module;
@@ -13,6 +15,31 @@ namespace fe {
         ~Time();
 
     public:
+        static constexpr size_t HistogramSize = 100;
+        static constexpr float HistogramBucketWidth = 1.0f; /// Milliseconds per histogram bucket, the last bucket holds every longer frame.
+
+        /**
+         * @brief Frame time percentiles over the statistics window, in milliseconds.
+         */
+        struct FrameStats {
+            float p50{ 0.0f };
+            float p95{ 0.0f };
+            float p99{ 0.0f };
+            float max{ 0.0f };
+            float average{ 0.0f };
+            uint32_t frames{ 0 };
+        };
+
+        /**
+         * @brief Thresholds a frame is reported as a hitch with.
+         */
+        struct HitchSettings {
+            float absoluteThreshold{ 50.0f }; /// Frame time in milliseconds which is always a hitch, zero disables it.
+            float relativeThreshold{ 3.0f }; /// Multiple of the median frame time which is a hitch, zero disables it.
+            float cooldown{ 5.0f }; /// Minimum seconds between two trace dumps.
+            fs::path traceDirectory; /// Directory the CPU profiler trace of a hitched frame is written to, empty disables dumps.
+        };
+
         static Time* Get() { return Instance; }
 
         //! The time at the beginning of this frame (Read Only).
@@ -26,11 +53,30 @@ namespace fe {
         //! The number of frames per second
         static uint32_t FramesPerSecond() { return Instance->framesPerSecond; }
 
+        //! Percentiles of the frame times in the statistics window, computed at most once per frame.
+        static FrameStats FrameTimeStats();
+        //! Number of frames in the statistics window per frame time bucket.
+        static const std::array<uint32_t, HistogramSize>& FrameTimeHistogram() { return Instance->histogram; }
+        //! The number of hitches since the start of the game.
+        static uint32_t HitchCount() { return Instance->hitchCount; }
+
+        //! Sets the length of the statistics window in seconds.
+        static void SetStatsWindow(float seconds) { Instance->statsWindow = seconds; }
+        static float GetStatsWindow() { return Instance->statsWindow; }
+
+        //! Sets the thresholds of the hitch detector, the CPU profiler is enabled when a trace directory is set.
+        static void SetHitchSettings(const HitchSettings& settings);
+        static const HitchSettings& GetHitchSettings() { return Instance->hitchSettings; }
+
     private:
         void onStart();
         void onUpdate();
         void onStop();
 
+        void recordFrame(float milliseconds);
+        void detectHitch(float milliseconds);
+        float getHistogramMedian() const;
+
     private:
         DateTime deltaTime;
         DateTime lastTime;
@@ -39,6 +85,19 @@ namespace fe {
         uint32_t frameNumber{ 0 };
         uint32_t framesPerSecond{ 0 };
 
+        std::deque<float> frameTimes; /// Frame times of the statistics window in milliseconds.
+        double frameTimesTotal{ 0.0 }; /// Running sum of the window, summed again after a window of removals.
+        size_t removedFrames{ 0 }; /// Frames removed from the window since the last full sum.
+        float statsWindow{ 10.0f };
+        std::array<uint32_t, HistogramSize> histogram{};
+        mutable std::vector<float> sortedTimes;
+        mutable FrameStats frameStats;
+        mutable uint64_t frameStatsFrame{ UINT64_MAX }; /// Frame the cached statistics were computed at.
+
+        HitchSettings hitchSettings;
+        uint32_t hitchCount{ 0 };
+        DateTime lastTraceTime;
+
         static Time* Instance;
     };
 }
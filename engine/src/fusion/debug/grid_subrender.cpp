@@ -3,7 +3,8 @@
 #include "fusion/graphics/commands/command_buffer.h"
 #include "fusion/graphics/cameras/camera.h"
 #include "fusion/devices/device_manager.h"
-#include "fusion/scene/scene_manager.h"
+#include "fusion/graphics/graphics.h"
+#include "fusion/graphics/render_snapshot.h"
 
 using namespace fe;
 
@@ -17,11 +18,11 @@ GridSubrender::~GridSubrender() {
 }
 
 void GridSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
-    auto scene = SceneManager::Get()->getScene();
-    if (!scene)
+    const auto& snapshot = Graphics::Get()->getSnapshot();
+    if (!snapshot.hasScene())
         return;
 
-    auto camera = overrideCamera ? overrideCamera : scene->getCamera();
+    auto camera = overrideCamera ? overrideCamera : snapshot.getCamera();
     if (!camera)
         return;
 
@@ -12,6 +12,8 @@ namespace fe {
         ~GridSubrender() override;
 
     private:
+        bool isThreadSafe() const override { return true; }
+
         void onUpdate() override {};
         void onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) override;
 
@@ -1,4 +1,9 @@
 #include "file_system.h"
+#include "pack_file_system.h"
+#include "mapped_file.h"
+
+#include "fusion/core/engine.h"
+#include "fusion/core/thread_pool.h"
 
 #if FUSION_PLATFORM_ANDROID
 #include "platform/android/android_virtual_file_system.h"
@@ -12,7 +17,7 @@ using namespace fe;
 
 FileSystem* FileSystem::Instance = nullptr;
 
-FileSystem::FileSystem() {
+FileSystem::FileSystem() : packs{std::make_unique<PackFileSystem>()} {
     Instance = this;
 #if FUSION_VIRTUAL_FS
     #if FUSION_PLATFORM_ANDROID
@@ -30,7 +35,11 @@ FileSystem::~FileSystem() {
 }
 
 void FileSystem::onStart() {
-
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    if (commandLineParser.isSet("pack")) {
+        fs::path filepath{ commandLineParser.getValue<std::string>("pack", "") };
+        MountPack(filepath, filepath.parent_path());
+    }
 }
 
 void FileSystem::onUpdate() {
@@ -41,48 +50,108 @@ void FileSystem::onStop() {
 
 }
 
+/**
+ * Gets the path to look up in the packs if one of them contains the file, packs are mounted with absolute paths on desktop.
+ */
+static std::optional<fs::path> FindPacked(const PackFileSystem* packs, const fs::path& filepath) {
+    if (!packs || packs->isEmpty())
+        return std::nullopt;
+#if FUSION_VIRTUAL_FS
+    const auto& path = filepath;
+#else
+    auto path = fs::absolute(filepath);
+#endif
+    if (!packs->isExists(path))
+        return std::nullopt;
+    return { path };
+}
+
+void FileSystem::MountPack(const fs::path& filepath, const fs::path& mount) {
+#if FUSION_VIRTUAL_FS
+    Instance->packs->mount(filepath, mount);
+#else
+    Instance->packs->mount(filepath, fs::absolute(mount));
+#endif
+}
+
+void FileSystem::UnmountPack(const fs::path& filepath) {
+    Instance->packs->unmount(filepath);
+}
+
 void FileSystem::ReadBytes(const fs::path& filepath, const std::function<void(gsl::span<const uint8_t>)>& handler) {
+    if (auto packed = FindPacked(Instance ? Instance->packs.get() : nullptr, filepath)) {
+        Instance->packs->readBytes(*packed, handler);
+        return;
+    }
 #if FUSION_VIRTUAL_FS
         Instance->vfs->readBytes(filepath, handler);
 #else
-        std::ifstream is{filepath, std::ios::binary};
+        // Mapped pages are handed out directly, the system reads them ahead as they are parsed
+        MappedFile file{filepath, MappedAccess::Sequential};
+        if (file) {
+            handler(file.getSpan());
+            return;
+        }
+
+        // Empty files cannot be mapped
+        std::ifstream is{filepath, std::ios::binary | std::ios::ate};
 
         if (!is.is_open()) {
             FE_LOG_ERROR("File: '{}' could not be opened", filepath);
             return;
         }
 
-        // Stop eating new lines in binary mode!!!
-        is.unsetf(std::ios::skipws);
-
-        std::streampos size;
-        is.seekg(0, std::ios::end);
-        size = is.tellg();
+        std::vector<uint8_t> buffer(static_cast<size_t>(is.tellg()));
         is.seekg(0, std::ios::beg);
-
-        std::vector<uint8_t> buffer;
-        buffer.reserve(size);
-        buffer.insert(buffer.begin(), std::istream_iterator<uint8_t>(is), std::istream_iterator<uint8_t>());
+        is.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
 
         handler({ buffer.data(), buffer.size() });
 #endif
 }
 
+void FileSystem::ReadAsync(const fs::path& filepath, IoCallback&& callback) {
+    if (auto packed = FindPacked(Instance ? Instance->packs.get() : nullptr, filepath)) {
+        Instance->packs->readAsync(*packed, std::move(callback));
+        return;
+    }
+#if FUSION_VIRTUAL_FS
+        // Virtual sources are no plain files, so they are read on a worker
+        ThreadPool::Get()->enqueue([filepath, callback = std::move(callback)] {
+            IoResult result;
+            result.error = ENOENT;
+            Instance->vfs->readBytes(filepath, [&result](gsl::span<const uint8_t> buffer) {
+                result.data.assign(buffer.begin(), buffer.end());
+                result.error = 0;
+            });
+            callback(std::move(result));
+        });
+#else
+        IoService::Get()->readAsync(filepath, 0, 0, std::move(callback));
+#endif
+}
+
 std::string FileSystem::ReadText(const fs::path& filepath) {
+    if (auto packed = FindPacked(Instance ? Instance->packs.get() : nullptr, filepath))
+        return Instance->packs->readText(*packed);
 #if FUSION_VIRTUAL_FS
         return Instance->vfs->readText(filepath);
 #else
-        std::ifstream is{filepath, std::ios::binary};
+        MappedFile file{filepath, MappedAccess::Sequential};
+        if (file)
+            return { reinterpret_cast<const char*>(file.getData()), file.getSize() };
+
+        // Empty files cannot be mapped
+        std::ifstream is{filepath, std::ios::binary | std::ios::ate};
 
         if (!is.is_open()) {
             FE_LOG_ERROR("File: '{}' could not be opened", filepath);
             return {};
         }
 
-        // Stop eating new lines in binary mode!!!
-        is.unsetf(std::ios::skipws);
-
-        return { std::istream_iterator<int8_t>(is), std::istream_iterator<int8_t>() };
+        std::string text(static_cast<size_t>(is.tellg()), '\0');
+        is.seekg(0, std::ios::beg);
+        is.read(text.data(), static_cast<std::streamsize>(text.size()));
+        return text;
 #endif
 }
 
@@ -111,6 +180,8 @@ std::string FileSystem::GetExtension(const fs::path& filepath) {
 }
 
 bool FileSystem::IsExists(const fs::path& filepath) {
+    if (FindPacked(Instance ? Instance->packs.get() : nullptr, filepath))
+        return true;
 #if FUSION_VIRTUAL_FS
         return Instance->vfs->isExists(filepath);
 #else
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "fusion/filesystem/io_service.h"
+
 namespace fe {
     inline fs::path operator""_p(const char* str, size_t len) { return fs::path{std::string_view{str, len}}; }
 
     class VirtualFileSystem;
+    class PackFileSystem;
 
     template<typename T>
     class Module;
@@ -22,6 +25,13 @@ namespace fe {
          */
         static void ReadBytes(const fs::path& filepath, const std::function<void(gsl::span<const uint8_t>)>& handler);
 
+        /**
+         * Reads a file through the I/O service without holding the current thread, packed files are read from their pack.
+         * @param filepath The path to read.
+         * @param callback The callback with the data read from the file, called from the thread of the service.
+         */
+        static void ReadAsync(const fs::path& filepath, IoCallback&& callback);
+
         /**
          * Opens a text file, reads all the text in the file into a string, and then closes the file.
          * @param filepath The path to read.
@@ -75,6 +85,19 @@ namespace fe {
          */
         static std::vector<fs::path> GetFiles(const fs::path& root, bool recursive = false, std::string_view ext = "");
 
+        /**
+         * Mounts a pack file, packed files are read before the loose ones.
+         * @param filepath The path to the pack file.
+         * @param mount The directory the pack is mounted at, entries are relative to it.
+         */
+        static void MountPack(const fs::path& filepath, const fs::path& mount);
+
+        /**
+         * Unmounts a pack file.
+         * @param filepath The path to the pack file.
+         */
+        static void UnmountPack(const fs::path& filepath);
+
     private:
         void onStart();
         void onUpdate();
@@ -84,6 +107,7 @@ namespace fe {
 #if FUSION_VIRTUAL_FS
         std::unique_ptr<VirtualFileSystem> vfs;
 #endif
+        std::unique_ptr<PackFileSystem> packs;
 
         static FileSystem* Instance;
     };
@@ -0,0 +1,219 @@
+#include "file_watcher.h"
+
+#include "fusion/core/thread_pool.h"
+
+#if FUSION_PLATFORM_LINUX && !FUSION_PLATFORM_ANDROID
+#include "platform/pc/inotify_file_watcher.h"
+#endif
+
+using namespace fe;
+
+FileWatcher::FileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay)
+    : watchDirectory{std::move(watchPath)}
+    , extensions{std::move(exts)}
+    , callback{std::move(changeCallback)}
+    , delay{delay} {
+}
+
+std::unique_ptr<FileWatcher> FileWatcher::Init(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay) {
+    std::unique_ptr<FileWatcher> watcher;
+#if FUSION_PLATFORM_LINUX && !FUSION_PLATFORM_ANDROID
+    auto inotify = std::make_unique<pc::InotifyFileWatcher>(watchPath, changeCallback, exts, delay);
+    if (inotify->isValid())
+        watcher = std::move(inotify);
+#endif
+    if (!watcher)
+        watcher = std::make_unique<PollingFileWatcher>(std::move(watchPath), std::move(changeCallback), std::move(exts), delay);
+
+    FE_LOG_INFO("File watcher: {} on '{}'", watcher->getName(), watcher->watchDirectory);
+
+    // Watches are added before the scan, so files created meanwhile are not missed
+    watcher->scan();
+    watcher->start();
+    return watcher;
+}
+
+void FileWatcher::update() {
+    std::vector<std::pair<fs::path, FileEvent>> changes;
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        if (pending.empty())
+            return;
+
+        auto now = DateTime::Now();
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (now - it->second.time >= delay) {
+                changes.emplace_back(it->first, it->second.event);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto& [path, event] : changes) {
+        callback(path, event);
+    }
+}
+
+void FileWatcher::scan() {
+    FUSION_PROFILE_FUNCTION();
+
+    struct Listing {
+        std::vector<std::pair<fs::path, fs::file_time_type>> files;
+        std::vector<fs::path> directories;
+    };
+
+    // Tree is listed level by level, the directories of a level are listed in parallel
+    std::vector<fs::path> directories{ watchDirectory };
+    while (!directories.empty()) {
+        std::vector<Listing> listings(directories.size());
+        ThreadPool::Get()->parallelFor(directories.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto& listing = listings[i];
+                std::error_code error;
+                for (fs::directory_iterator it{directories[i], error}, last; !error && it != last; it.increment(error)) {
+                    std::error_code fileError;
+                    if (it->is_directory(fileError)) {
+                        if (!it->is_symlink(fileError))
+                            listing.directories.push_back(it->path());
+                        continue;
+                    }
+
+                    const auto& path = it->path();
+                    if (!it->is_regular_file(fileError) || !isWatched(path))
+                        continue;
+
+                    auto time = it->last_write_time(fileError);
+                    if (!fileError)
+                        listing.files.emplace_back(path, time);
+                }
+            }
+        });
+
+        directories.clear();
+        for (auto& listing : listings) {
+            for (auto& [path, time] : listing.files) {
+                auto it = paths.emplace(std::move(path), time).first;
+                callback(it->first, FileEvent::Init);
+            }
+            std::move(listing.directories.begin(), listing.directories.end(), std::back_inserter(directories));
+        }
+    }
+}
+
+void FileWatcher::refresh(const fs::path& path) {
+    std::error_code error;
+    auto it = paths.find(path);
+
+    if (!fs::is_regular_file(path, error)) {
+        if (it != paths.end()) {
+            paths.erase(it);
+            push(path, FileEvent::Erased);
+        }
+        return;
+    }
+
+    if (!isWatched(path))
+        return;
+
+    auto time = fs::last_write_time(path, error);
+    if (error)
+        return;
+
+    if (it == paths.end()) {
+        paths.emplace(path, time);
+        push(path, FileEvent::Created);
+    } else if (it->second != time) {
+        it->second = time;
+        push(path, FileEvent::Modified);
+    }
+}
+
+void FileWatcher::refreshDirectory(const fs::path& directory) {
+    std::vector<fs::path> recorded;
+    for (const auto& [path, time] : paths) {
+        if (IsInside(path, directory))
+            recorded.push_back(path);
+    }
+    for (const auto& path : recorded) {
+        refresh(path);
+    }
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it{directory, error}, end; !error && it != end; it.increment(error)) {
+        refresh(it->path());
+    }
+}
+
+void FileWatcher::push(const fs::path& path, FileEvent event) {
+    std::unique_lock<std::mutex> lock(pendingMutex);
+
+    auto now = DateTime::Now();
+    auto [it, inserted] = pending.try_emplace(path, Change{ event, now });
+    if (inserted)
+        return;
+
+    auto& change = it->second;
+    change.time = now;
+
+    switch (change.event) {
+        case FileEvent::Created:
+            // File which was never reported does not need to be reported as erased
+            if (event == FileEvent::Erased)
+                pending.erase(it);
+            break;
+        case FileEvent::Erased:
+            // Saves which replace the file
+            change.event = event == FileEvent::Created ? FileEvent::Modified : event;
+            break;
+        default:
+            change.event = event;
+            break;
+    }
+}
+
+bool FileWatcher::isWatched(const fs::path& path) const {
+    return extensions.empty() || extensions.find(FileSystem::GetExtension(path)) != extensions.end();
+}
+
+bool FileWatcher::IsInside(const fs::path& path, const fs::path& directory) {
+    const auto& file = path.native();
+    const auto& root = directory.native();
+    return !root.empty() && file.size() > root.size() && file.compare(0, root.size(), root) == 0 && (file[root.size()] == fs::path::preferred_separator || root.back() == fs::path::preferred_separator);
+}
+
+PollingFileWatcher::PollingFileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay, DateTime interval)
+    : FileWatcher{std::move(watchPath), std::move(changeCallback), std::move(exts), delay}
+    , interval{interval} {
+}
+
+PollingFileWatcher::~PollingFileWatcher() {
+    if (!thread.joinable())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_one();
+    thread.join();
+}
+
+void PollingFileWatcher::start() {
+    thread = std::thread{&PollingFileWatcher::onWork, this};
+}
+
+void PollingFileWatcher::onWork() {
+    FUSION_PROFILE_SETTHREADNAME("File Watcher");
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (condition.wait_for(lock, static_cast<std::chrono::microseconds>(interval), [this] { return stopping; }))
+                return;
+        }
+
+        rescan();
+    }
+}
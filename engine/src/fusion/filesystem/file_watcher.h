@@ -1,71 +1,132 @@
+#pragma once
+
 #include "file_system.h"
 
-#pragma once
+#include "fusion/utils/date_time.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace fe {
     // Define available file changes
     enum class FileEvent : unsigned char { Init, Created, Modified, Erased };
 
+    using FileCallback = std::function<void(const fs::path&, FileEvent)>;
+
+    /**
+     * @brief Watches a directory tree for changes of files.
+     * Changes are detected on a thread of the watcher and collected until the file was quiet for the debounce delay,
+     * so a save which touches a file several times is reported once. Callbacks are only called from {@link update}.
+     */
     class FUSION_API FileWatcher {
     public:
-        FileWatcher(fs::path watchPath, std::function<void(const fs::path&, FileEvent)> changeCallback, std::set<std::string> exts = {}, DateTime interval = 1s)
-            : watchDirectory{std::move(watchPath)}
-            , callback{std::move(changeCallback)}
-            , extensions{std::move(exts)}
-            , elapsedUpdate{interval} {
-            for (const auto& entry: fs::recursive_directory_iterator(watchDirectory)) {
-                auto& path = entry.path();
-                if (extensions.empty() || extensions.find(FileSystem::GetExtension(path)) != extensions.end()) {
-                    paths[path] = fs::last_write_time(path);
-                    callback(path, FileEvent::Init);
-                }
-            }
-        }
-
-        void update() {
-            if (elapsedUpdate.getElapsed() != 0) {
-                auto it = paths.begin();
-                while (it != paths.end()) {
-                    if (!fs::exists(it->first)) {
-                        callback(it->first, FileEvent::Erased);
-                        it = paths.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
-
-                // Check if a file was created or modified
-                for (const auto& entry: fs::recursive_directory_iterator(watchDirectory)) {
-                    auto& path = entry.path();
-                    auto lastWriteTime = fs::last_write_time(path);
-
-                    // File creation
-                    auto it2 = paths.find(path);
-                    if (it2 == paths.end()) {
-                        if (extensions.empty() || extensions.find(FileSystem::GetExtension(path)) != extensions.end()) {
-                            paths[path] = lastWriteTime;
-                            callback(path, FileEvent::Created);
-                        }
-                        // File modification
-                    } else {
-                        auto& time = it2->second;
-                        if (time != lastWriteTime) {
-                            time = lastWriteTime;
-                            callback(path, FileEvent::Modified);
-                        }
-                    }
-                }
-            }
-        }
+        /**
+         * @param watchPath The directory to watch.
+         * @param changeCallback The callback of the changes.
+         * @param exts Extensions of the watched files, all files are watched if empty.
+         * @param delay Time a file has to be unchanged before its change is reported.
+         */
+        FileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay);
+        virtual ~FileWatcher() = default;
+        NONCOPYABLE(FileWatcher);
+
+        /**
+         * Creates the best watcher of the platform, inotify on Linux and polling of the tree otherwise.
+         * Every file of the tree is reported with {@link FileEvent::Init} before the function returns.
+         * @param watchPath The directory to watch.
+         * @param changeCallback The callback of the changes.
+         * @param exts Extensions of the watched files, all files are watched if empty.
+         * @param delay Time a file has to be unchanged before its change is reported.
+         * @return The watcher.
+         */
+        static std::unique_ptr<FileWatcher> Init(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts = {}, DateTime delay = 100ms);
+
+        /**
+         * Reports the settled changes to the callback on the calling thread.
+         */
+        void update();
 
         const fs::path& getWatchDirectory() const { return watchDirectory; }
+        virtual const char* getName() const = 0;
+
+    protected:
+        /**
+         * Starts the thread of the watcher, called once the initial scan is done.
+         */
+        virtual void start() = 0;
+
+        /**
+         * Records every file of the tree and reports it with {@link FileEvent::Init}, the tree is listed on the thread pool.
+         */
+        void scan();
+
+        /**
+         * Compares the tree with the recorded files and queues the differences, used to recover lost events.
+         */
+        void rescan() { refreshDirectory(watchDirectory); }
+
+        /**
+         * Compares the file with its record and queues the change.
+         * @param path The path of the file.
+         */
+        void refresh(const fs::path& path);
+
+        /**
+         * Refreshes the recorded files of the directory and every file of its tree, used when a directory was created,
+         * moved or removed as a whole.
+         * @param directory The path of the directory.
+         */
+        void refreshDirectory(const fs::path& directory);
+
+        bool isWatched(const fs::path& path) const;
+
+        static bool IsInside(const fs::path& path, const fs::path& directory);
+
+        fs::path watchDirectory;
 
     private:
-        std::unordered_map<fs::path, fs::file_time_type, PathHash> paths;
+        /**
+         * Merges the change with the pending one of the same file and restarts its delay, called from the watcher thread.
+         * @param path The path of the file.
+         * @param event The change.
+         */
+        void push(const fs::path& path, FileEvent event);
+
+        struct Change {
+            FileEvent event;
+            DateTime time; /// Time of the last change.
+        };
+
+        std::unordered_map<fs::path, fs::file_time_type, PathHash> paths; /// Recorded files, only touched by the watcher thread after the scan.
         std::set<std::string> extensions;
-        std::function<void(const fs::path&, FileEvent)> callback;
-        fs::path watchDirectory;
+        FileCallback callback;
+        DateTime delay;
+
+        std::unordered_map<fs::path, Change, PathHash> pending;
+        std::mutex pendingMutex;
+    };
+
+    /**
+     * @brief Fallback which walks the tree on its thread in an interval.
+     */
+    class FUSION_API PollingFileWatcher final : public FileWatcher {
+    public:
+        PollingFileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay, DateTime interval = 1s);
+        ~PollingFileWatcher() override;
+
+        const char* getName() const override { return "Polling"; }
+
+    protected:
+        void start() override;
+
+    private:
+        void onWork();
 
-        ElapsedTime elapsedUpdate;
+        DateTime interval;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping{ false };
     };
 }
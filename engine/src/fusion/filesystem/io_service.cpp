@@ -0,0 +1,102 @@
+#include "io_service.h"
+
+#include "fusion/core/thread_pool.h"
+#include "fusion/core/perf_counters.h"
+
+#if FUSION_PLATFORM_LINUX && !FUSION_PLATFORM_ANDROID
+#include "platform/pc/uring_io_service.h"
+#endif
+
+using namespace fe;
+
+IoService* IoService::Instance = nullptr;
+
+IoService::IoService() {
+    Instance = this;
+}
+
+IoService::~IoService() {
+    // Backend which failed to start is released after the fallback was created
+    if (Instance == this)
+        Instance = nullptr;
+}
+
+std::unique_ptr<IoService> IoService::Init() {
+    std::unique_ptr<IoService> service;
+#if FUSION_PLATFORM_LINUX && !FUSION_PLATFORM_ANDROID
+    auto uring = std::make_unique<pc::UringIoService>();
+    if (uring->isValid())
+        service = std::move(uring);
+#endif
+    if (!service)
+        service = std::make_unique<ThreadPoolIoService>();
+
+    FE_LOG_INFO("I/O service: {}", service->getName());
+    return service;
+}
+
+void IoService::readAsync(const fs::path& filepath, uint64_t offset, uint64_t size, IoCallback&& callback) {
+    std::vector<IoRequest> requests;
+    requests.push_back({ filepath, offset, size, std::move(callback) });
+    submit(std::move(requests));
+}
+
+std::future<IoResult> IoService::readAsync(const fs::path& filepath, uint64_t offset, uint64_t size) {
+    auto promise = std::make_shared<std::promise<IoResult>>();
+    auto future = promise->get_future();
+    readAsync(filepath, offset, size, [promise](IoResult&& result) {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+void IoService::wait() const {
+    while (pending.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+}
+
+void IoService::complete(IoRequest& request, IoResult&& result) {
+    if (result) {
+        PerfCounters::Add(PerfCounters::Counter::FileReads);
+        PerfCounters::Add(PerfCounters::Counter::FileReadBytes, static_cast<int64_t>(result.data.size()));
+    } else {
+        FE_LOG_ERROR("File: '{}' could not be read: {}", request.path, std::strerror(result.error));
+    }
+
+    if (request.callback)
+        request.callback(std::move(result));
+
+    pending.fetch_sub(1, std::memory_order_release);
+}
+
+ThreadPoolIoService::~ThreadPoolIoService() {
+    // Tasks still refer to the service
+    wait();
+}
+
+void ThreadPoolIoService::submit(std::vector<IoRequest>&& requests) {
+    begin(requests.size());
+
+    for (auto& request : requests) {
+        ThreadPool::Get()->enqueue([this, request = std::move(request)]() mutable {
+            IoResult result;
+
+            std::ifstream is{request.path, std::ios::binary | std::ios::ate};
+            if (is.is_open()) {
+                auto fileSize = static_cast<uint64_t>(is.tellg());
+                auto offset = std::min(request.offset, fileSize);
+                auto size = request.size == 0 ? fileSize - offset : std::min(request.size, fileSize - offset);
+
+                result.data.resize(static_cast<size_t>(size));
+                is.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+                is.read(reinterpret_cast<char*>(result.data.data()), static_cast<std::streamsize>(size));
+                if (!is)
+                    result.error = EIO;
+            } else {
+                result.error = ENOENT;
+            }
+
+            complete(request, std::move(result));
+        });
+    }
+}
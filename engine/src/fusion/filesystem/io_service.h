@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+
+namespace fe {
+    struct IoResult {
+        std::vector<uint8_t> data;
+        int error{ 0 }; /// Error code of the system, zero on the success.
+
+        explicit operator bool() const { return error == 0; }
+    };
+
+    using IoCallback = std::function<void(IoResult&&)>;
+
+    struct IoRequest {
+        fs::path path;
+        uint64_t offset{ 0 };
+        uint64_t size{ 0 }; /// Zero reads until the end of the file.
+        IoCallback callback;
+    };
+
+    /**
+     * @brief Reads files asynchronously, so threads do not wait on the disk.
+     * Callbacks are called from the thread of the service, they should only hand the data over to other work.
+     */
+    class FUSION_API IoService {
+    public:
+        IoService();
+        virtual ~IoService();
+        NONCOPYABLE(IoService);
+
+        /**
+         * Creates the best service of the platform, io_uring on Linux when the kernel allows it and the thread pool otherwise.
+         * @return The service.
+         */
+        static std::unique_ptr<IoService> Init();
+
+        static IoService* Get() { return Instance; }
+
+        /**
+         * Queues the requests as one batch.
+         * @param requests The reads to run.
+         */
+        virtual void submit(std::vector<IoRequest>&& requests) = 0;
+
+        /**
+         * Reads a range of a file.
+         * @param filepath The path to read.
+         * @param offset Offset of the range in bytes.
+         * @param size Size of the range in bytes, zero reads until the end of the file.
+         * @param callback The callback with the read data.
+         */
+        void readAsync(const fs::path& filepath, uint64_t offset, uint64_t size, IoCallback&& callback);
+
+        /**
+         * Reads a range of a file.
+         * @param filepath The path to read.
+         * @param offset Offset of the range in bytes.
+         * @param size Size of the range in bytes, zero reads until the end of the file.
+         * @return The future result with the read data.
+         */
+        std::future<IoResult> readAsync(const fs::path& filepath, uint64_t offset = 0, uint64_t size = 0);
+
+        /**
+         * Holds the current thread until every submitted read completed.
+         */
+        void wait() const;
+
+        virtual const char* getName() const = 0;
+        size_t getPendingCount() const { return pending.load(std::memory_order_acquire); }
+
+    protected:
+        /**
+         * Counts the requests, must be called by the implementations before they are queued.
+         * @param count The number of requests.
+         */
+        void begin(size_t count) { pending.fetch_add(count, std::memory_order_relaxed); }
+
+        /**
+         * Passes the result to the callback of the request.
+         * @param request The finished request.
+         * @param result The result of the read.
+         */
+        void complete(IoRequest& request, IoResult&& result);
+
+    private:
+        std::atomic<size_t> pending{ 0 };
+
+        static IoService* Instance;
+    };
+
+    /**
+     * @brief Fallback which reads the files on the workers of the thread pool.
+     */
+    class FUSION_API ThreadPoolIoService final : public IoService {
+    public:
+        ThreadPoolIoService() = default;
+        ~ThreadPoolIoService() override;
+
+        void submit(std::vector<IoRequest>&& requests) override;
+
+        const char* getName() const override { return "Thread Pool"; }
+    };
+}
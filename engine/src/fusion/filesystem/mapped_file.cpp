@@ -0,0 +1,95 @@
+#include "mapped_file.h"
+
+#if FUSION_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace fe;
+
+MappedFile::MappedFile(const fs::path& filepath, MappedAccess access) {
+#if FUSION_PLATFORM_WINDOWS
+    auto flags = access == MappedAccess::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : access == MappedAccess::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+    auto handle = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return;
+    file = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0)
+        return;
+
+    mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        FE_LOG_ERROR("File: '{}' could not be mapped", filepath);
+        return;
+    }
+
+    data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        FE_LOG_ERROR("File: '{}' could not be mapped", filepath);
+        return;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+
+    struct stat info = {};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        auto address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const uint8_t*>(address);
+            size = static_cast<size_t>(info.st_size);
+
+            switch (access) {
+                case MappedAccess::Normal:
+                    break;
+                case MappedAccess::Sequential:
+                    madvise(address, size, MADV_SEQUENTIAL);
+                    madvise(address, size, MADV_WILLNEED);
+                    break;
+                case MappedAccess::Random:
+                    madvise(address, size, MADV_RANDOM);
+                    break;
+            }
+        } else {
+            FE_LOG_ERROR("File: '{}' could not be mapped", filepath);
+        }
+    }
+
+    // Mapping stays valid after the descriptor is closed
+    close(fd);
+#endif
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+    if (!data || offset >= size)
+        return;
+#if !FUSION_PLATFORM_WINDOWS
+    // Advice ranges have to start on a page
+    static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto begin = offset - offset % pageSize;
+    auto end = std::min(offset + length, size);
+    madvise(const_cast<uint8_t*>(data) + begin, end - begin, MADV_WILLNEED);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if FUSION_PLATFORM_WINDOWS
+    if (data)
+        UnmapViewOfFile(data);
+    if (mapping)
+        CloseHandle(mapping);
+    if (file)
+        CloseHandle(file);
+#else
+    if (data)
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace fe {
+    /// Expected access pattern of a mapping, used to tune the read-ahead of the system.
+    enum class MappedAccess : unsigned char { Normal, Sequential, Random };
+
+    /**
+     * @brief Read-only memory mapping of a whole file, the content is paged in by the system on access.
+     */
+    class FUSION_API MappedFile {
+    public:
+        /**
+         * Maps the file into the address space.
+         * @param filepath The path to the file.
+         * @param access The expected access pattern, sequential mappings are also paged in ahead.
+         */
+        explicit MappedFile(const fs::path& filepath, MappedAccess access = MappedAccess::Normal);
+        ~MappedFile();
+        NONCOPYABLE(MappedFile);
+
+        /**
+         * Gets if the file was mapped, empty files are never mapped.
+         * @return If the mapping is valid.
+         */
+        bool isMapped() const { return data != nullptr; }
+        operator bool() const { return isMapped(); }
+
+        const uint8_t* getData() const { return data; }
+        size_t getSize() const { return size; }
+        gsl::span<const uint8_t> getSpan() const { return { data, size }; }
+
+        /**
+         * Asks the system to page in a range which is about to be read.
+         * @param offset Offset of the range in bytes.
+         * @param length Length of the range in bytes.
+         */
+        void prefetch(size_t offset, size_t length) const;
+
+    private:
+        const uint8_t* data{ nullptr };
+        size_t size{ 0 };
+#if FUSION_PLATFORM_WINDOWS
+        void* file{ nullptr };
+        void* mapping{ nullptr };
+#endif
+    };
+}
@@ -0,0 +1,360 @@
+#include "pack_file.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+using namespace fe;
+
+static_assert(sizeof(PackFormat::Header) == 56, "Pack header layout changed");
+static_assert(sizeof(PackFormat::Entry) == 64, "Pack entry layout changed");
+static_assert(sizeof(PackFormat::Uuid) == 24, "Pack uuid layout changed");
+
+/**
+ * Formats which are compressed already, packing them again costs load time for no gain.
+ */
+static const std::unordered_set<std::string> StoredExtensions = {
+    ".png",
+    ".jpg",
+    ".jpeg",
+    ".ktx",
+    ".ktx2",
+    ".ogg",
+    ".mp3",
+    ".flac",
+    ".zip",
+    ".gz",
+    ".fpak"
+};
+
+uint64_t PackFormat::Hash(std::string_view path) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool Decompress(const PackFormat::Entry& entry, const uint8_t* data, std::vector<uint8_t>& buffer) {
+    buffer.resize(static_cast<size_t>(entry.size));
+    auto result = LZ4_decompress_safe(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(buffer.data()), static_cast<int>(entry.packedSize), static_cast<int>(entry.size));
+    return result >= 0 && static_cast<uint64_t>(result) == entry.size;
+}
+
+PackArchive::PackArchive(const fs::path& filepath) : path{filepath}, file{filepath, MappedAccess::Random} {
+    valid = validate();
+    if (!valid)
+        FE_LOG_ERROR("Pack: '{}' is not valid", path);
+}
+
+bool PackArchive::validate() {
+    if (!file || file.getSize() < sizeof(PackFormat::Header))
+        return false;
+
+    const auto data = file.getData();
+    const auto size = static_cast<uint64_t>(file.getSize());
+
+    PackFormat::Header header;
+    std::memcpy(&header, data, sizeof(PackFormat::Header));
+    if (header.magic != PackFormat::Magic || header.version != PackFormat::Version)
+        return false;
+
+    auto fits = [size](uint64_t offset, uint64_t count, uint64_t stride) {
+        return offset <= size && count <= (size - offset) / stride;
+    };
+
+    if (!fits(header.entriesOffset, header.entryCount, sizeof(PackFormat::Entry)) || header.entriesOffset % alignof(PackFormat::Entry) != 0 ||
+        !fits(header.uuidsOffset, header.uuidCount, sizeof(PackFormat::Uuid)) || header.uuidsOffset % alignof(PackFormat::Uuid) != 0 ||
+        !fits(header.namesOffset, header.namesSize, 1))
+        return false;
+
+    entries = reinterpret_cast<const PackFormat::Entry*>(data + header.entriesOffset);
+    entryCount = static_cast<size_t>(header.entryCount);
+    uuids = reinterpret_cast<const PackFormat::Uuid*>(data + header.uuidsOffset);
+    uuidCount = static_cast<size_t>(header.uuidCount);
+    names = reinterpret_cast<const char*>(data + header.namesOffset);
+
+    for (const auto& entry : getEntries()) {
+        if (!fits(entry.offset, entry.packedSize, 1) || static_cast<uint64_t>(entry.nameOffset) + entry.nameSize > header.namesSize)
+            return false;
+        if (entry.compression != PackCompression::None && entry.compression != PackCompression::LZ4)
+            return false;
+        if (entry.compression == PackCompression::None && entry.size != entry.packedSize)
+            return false;
+    }
+
+    for (size_t i = 0; i < uuidCount; ++i) {
+        if (uuids[i].entry >= entryCount)
+            return false;
+    }
+
+    return true;
+}
+
+const PackFormat::Entry* PackArchive::find(std::string_view name) const {
+    if (!valid)
+        return nullptr;
+
+    auto hash = PackFormat::Hash(name);
+    auto end = entries + entryCount;
+    auto it = std::lower_bound(entries, end, hash, [](const PackFormat::Entry& entry, uint64_t value) {
+        return entry.hash < value;
+    });
+
+    // Different paths can share the hash
+    for (; it != end && it->hash == hash; ++it) {
+        if (getName(*it) == name)
+            return it;
+    }
+
+    return nullptr;
+}
+
+const PackFormat::Entry* PackArchive::find(const uuids::uuid& uuid) const {
+    if (!valid || uuid.is_nil())
+        return nullptr;
+
+    std::array<uint8_t, 16> key;
+    auto bytes = uuid.as_bytes();
+    std::memcpy(key.data(), bytes.data(), key.size());
+
+    auto end = uuids + uuidCount;
+    auto it = std::lower_bound(uuids, end, key, [](const PackFormat::Uuid& value, const std::array<uint8_t, 16>& id) {
+        return value.uuid < id;
+    });
+
+    if (it == end || it->uuid != key)
+        return nullptr;
+
+    return &entries[it->entry];
+}
+
+bool PackArchive::read(const PackFormat::Entry& entry, const std::function<void(gsl::span<const uint8_t>)>& handler) const {
+    const auto data = file.getData() + entry.offset;
+
+    // Pack is mapped for random access, so only the entry is read ahead
+    file.prefetch(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.packedSize));
+
+    switch (entry.compression) {
+        case PackCompression::None:
+            handler({ data, static_cast<size_t>(entry.size) });
+            return true;
+
+        case PackCompression::LZ4: {
+            std::vector<uint8_t> buffer;
+            if (!Decompress(entry, data, buffer)) {
+                FE_LOG_ERROR("Entry: '{}' could not be decompressed from pack: '{}'", getName(entry), path);
+                return false;
+            }
+            handler(buffer);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PackArchive::readAsync(const PackFormat::Entry& entry, IoCallback&& callback) const {
+    // Entry is copied, the callback must not depend on the archive staying mounted
+    IoService::Get()->readAsync(path, entry.offset, entry.packedSize, [entry, name = std::string{getName(entry)}, callback = std::move(callback)](IoResult&& result) {
+        if (result && entry.compression == PackCompression::LZ4) {
+            std::vector<uint8_t> buffer;
+            if (Decompress(entry, result.data.data(), buffer)) {
+                result.data = std::move(buffer);
+            } else {
+                FE_LOG_ERROR("Entry: '{}' could not be decompressed", name);
+                result.data.clear();
+                result.error = EIO;
+            }
+        } else if (result && result.data.size() != entry.packedSize) {
+            result.error = EIO;
+        }
+        callback(std::move(result));
+    });
+}
+
+std::string_view PackArchive::getName(const PackFormat::Entry& entry) const {
+    return { names + entry.nameOffset, entry.nameSize };
+}
+
+PackBuilder::PackBuilder(int level) : level{level} {
+}
+
+void PackBuilder::addDirectory(const fs::path& directory) {
+    auto root = directory.lexically_normal();
+    if (!root.has_filename())
+        root = root.parent_path();
+
+    if (!fs::is_directory(root)) {
+        FE_LOG_ERROR("Directory: '{}' does not exist", root);
+        return;
+    }
+
+    // Sorted, so the same input always produces the same pack
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.is_regular_file() && entry.path().extension().string() != ".meta")
+            paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    auto base = root.parent_path();
+    for (const auto& path : paths) {
+        addFile(path, path.lexically_relative(base).generic_string());
+    }
+}
+
+void PackBuilder::addFile(const fs::path& filepath, std::string name) {
+    sources.push_back({ filepath, std::move(name) });
+}
+
+static bool ReadFile(const fs::path& filepath, std::vector<uint8_t>& buffer) {
+    std::ifstream is{filepath, std::ios::binary | std::ios::ate};
+    if (!is.is_open())
+        return false;
+
+    buffer.resize(static_cast<size_t>(is.tellg()));
+    is.seekg(0, std::ios::beg);
+    is.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(is);
+}
+
+static void WritePadding(std::ofstream& os, uint64_t& position, uint64_t alignment) {
+    static const std::array<char, PackFormat::Alignment> zeros{};
+    auto padding = (alignment - position % alignment) % alignment;
+    os.write(zeros.data(), static_cast<std::streamsize>(padding));
+    position += padding;
+}
+
+bool PackBuilder::write(const fs::path& filepath) const {
+    std::ofstream os{filepath, std::ios::binary};
+    if (!os.is_open()) {
+        FE_LOG_ERROR("File: '{}' could not be opened", filepath);
+        return false;
+    }
+
+    std::vector<PackFormat::Entry> entries;
+    entries.reserve(sources.size());
+    std::string names;
+    std::unordered_set<std::string_view> added;
+
+    // Space of the header, it is filled once the tables are known
+    PackFormat::Header header = {};
+    os.write(reinterpret_cast<const char*>(&header), sizeof(PackFormat::Header));
+
+    uint64_t position = sizeof(PackFormat::Header);
+    uint64_t totalSize = 0;
+    uint64_t totalPackedSize = 0;
+    size_t compressedCount = 0;
+
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> packed;
+
+    for (const auto& source : sources) {
+        if (!added.insert(source.name).second) {
+            FE_LOG_WARNING("Entry: '{}' was added twice, skipping: '{}'", source.name, source.path);
+            continue;
+        }
+
+        if (!ReadFile(source.path, data)) {
+            FE_LOG_ERROR("File: '{}' could not be read", source.path);
+            return false;
+        }
+
+        // Every entry starts on an own page, so it can be mapped directly
+        WritePadding(os, position, PackFormat::Alignment);
+
+        PackFormat::Entry entry = {};
+        entry.hash = PackFormat::Hash(source.name);
+        entry.offset = position;
+        entry.size = data.size();
+        entry.packedSize = data.size();
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameSize = static_cast<uint32_t>(source.name.size());
+        entry.compression = PackCompression::None;
+
+        fs::path metaPath{ source.path };
+        metaPath += ".meta";
+        if (fs::exists(metaPath)) {
+            std::vector<uint8_t> text;
+            if (ReadFile(metaPath, text)) {
+                if (auto uuid = uuids::uuid::from_string(std::string{text.begin(), text.end()})) {
+                    auto bytes = uuid->as_bytes();
+                    std::memcpy(entry.uuid.data(), bytes.data(), entry.uuid.size());
+                }
+            }
+        }
+
+        const uint8_t* output = data.data();
+        if (level > 0 && !data.empty() && data.size() <= LZ4_MAX_INPUT_SIZE && StoredExtensions.find(String::Lowercase(source.path.extension().string())) == StoredExtensions.end()) {
+            packed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(data.size()))));
+            auto result = LZ4_compress_HC(reinterpret_cast<const char*>(data.data()), reinterpret_cast<char*>(packed.data()), static_cast<int>(data.size()), static_cast<int>(packed.size()), level);
+            // Keep only compression which saves more than 1/16 of the size
+            if (result > 0 && static_cast<uint64_t>(result) < data.size() - data.size() / 16) {
+                entry.compression = PackCompression::LZ4;
+                entry.packedSize = static_cast<uint64_t>(result);
+                output = packed.data();
+                ++compressedCount;
+            }
+        }
+
+        os.write(reinterpret_cast<const char*>(output), static_cast<std::streamsize>(entry.packedSize));
+        position += entry.packedSize;
+        totalSize += entry.size;
+        totalPackedSize += entry.packedSize;
+
+        names += source.name;
+        entries.push_back(entry);
+    }
+
+    auto nameOf = [&names](const PackFormat::Entry& entry) {
+        return std::string_view{ names }.substr(entry.nameOffset, entry.nameSize);
+    };
+    std::sort(entries.begin(), entries.end(), [&nameOf](const PackFormat::Entry& a, const PackFormat::Entry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : nameOf(a) < nameOf(b);
+    });
+
+    std::vector<PackFormat::Uuid> uuids;
+    for (const auto& [i, entry] : enumerate(entries)) {
+        if (std::any_of(entry.uuid.begin(), entry.uuid.end(), [](uint8_t byte) { return byte != 0; }))
+            uuids.push_back({ entry.uuid, static_cast<uint64_t>(i) });
+    }
+    std::sort(uuids.begin(), uuids.end(), [](const PackFormat::Uuid& a, const PackFormat::Uuid& b) {
+        return a.uuid < b.uuid;
+    });
+    for (size_t i = 1; i < uuids.size(); ++i) {
+        if (uuids[i].uuid == uuids[i - 1].uuid)
+            FE_LOG_WARNING("Entries: '{}' and '{}' share the same uuid", nameOf(entries[uuids[i - 1].entry]), nameOf(entries[uuids[i].entry]));
+    }
+
+    header.magic = PackFormat::Magic;
+    header.version = PackFormat::Version;
+
+    WritePadding(os, position, alignof(PackFormat::Entry));
+    header.entryCount = entries.size();
+    header.entriesOffset = position;
+    os.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackFormat::Entry)));
+    position += entries.size() * sizeof(PackFormat::Entry);
+
+    header.uuidCount = uuids.size();
+    header.uuidsOffset = position;
+    os.write(reinterpret_cast<const char*>(uuids.data()), static_cast<std::streamsize>(uuids.size() * sizeof(PackFormat::Uuid)));
+    position += uuids.size() * sizeof(PackFormat::Uuid);
+
+    header.namesOffset = position;
+    header.namesSize = names.size();
+    os.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    // Header is written last, so a pack which failed to build is never valid
+    os.seekp(0, std::ios::beg);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(PackFormat::Header));
+
+    if (!os) {
+        FE_LOG_ERROR("File: '{}' could not be written", filepath);
+        return false;
+    }
+
+    FE_LOG_INFO("Pack: '{}' written with {} entries, {} compressed, {} -> {} bytes", filepath, entries.size(), compressedCount, totalSize, totalPackedSize);
+    return true;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "fusion/filesystem/mapped_file.h"
+#include "fusion/filesystem/io_service.h"
+
+namespace fe {
+    enum class PackCompression : uint32_t { None, LZ4 };
+
+    /**
+     * @brief Layout of a Fusion pack file.
+     * The header is followed by the entry data, each entry starts on an own page, so uncompressed entries can be handed out
+     * straight from the mapping. The tables are stored at the end of the file: entries sorted by the hash of their path,
+     * uuids of the entries with metadata sorted by value and the blob with all entry paths.
+     */
+    struct PackFormat {
+        static constexpr uint32_t Magic = 0x4B415046; /// 'FPAK'
+        static constexpr uint32_t Version = 1;
+        static constexpr uint64_t Alignment = 4096;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t entryCount;
+            uint64_t entriesOffset;
+            uint64_t uuidCount;
+            uint64_t uuidsOffset;
+            uint64_t namesOffset;
+            uint64_t namesSize;
+        };
+
+        struct Entry {
+            uint64_t hash; /// Hash of the path.
+            uint64_t offset; /// Offset of the data from the beginning of the file.
+            uint64_t size; /// Size of the original data.
+            uint64_t packedSize; /// Size of the stored data.
+            uint32_t nameOffset; /// Offset of the path in the name blob.
+            uint32_t nameSize;
+            PackCompression compression;
+            uint32_t reserved;
+            std::array<uint8_t, 16> uuid; /// Nil if the file had no metadata.
+        };
+
+        struct Uuid {
+            std::array<uint8_t, 16> uuid;
+            uint64_t entry; /// Index of the entry with the uuid.
+        };
+
+        /**
+         * Hashes the path of an entry, paths are stored in the generic format relative to the pack root.
+         * @param path The entry path.
+         * @return The 64-bit hash.
+         */
+        static uint64_t Hash(std::string_view path);
+    };
+
+    /**
+     * @brief Read access to a mapped pack file, lookups are binary searches in the sorted index.
+     */
+    class FUSION_API PackArchive {
+    public:
+        /**
+         * Maps the pack and validates its tables.
+         * @param filepath The path to the pack file.
+         */
+        explicit PackArchive(const fs::path& filepath);
+        ~PackArchive() = default;
+        NONCOPYABLE(PackArchive);
+
+        bool isValid() const { return valid; }
+        const fs::path& getPath() const { return path; }
+
+        /**
+         * Finds the entry of a path.
+         * @param name The path relative to the pack root in the generic format.
+         * @return The entry or nullptr if the pack does not contain the path.
+         */
+        const PackFormat::Entry* find(std::string_view name) const;
+
+        /**
+         * Finds the entry of an asset by the uuid from its metadata.
+         * @param uuid The uuid of the asset.
+         * @return The entry or nullptr if the pack does not contain the asset.
+         */
+        const PackFormat::Entry* find(const uuids::uuid& uuid) const;
+
+        /**
+         * Reads the data of an entry, uncompressed entries are passed straight from the mapping without a copy.
+         * @param entry The entry to read.
+         * @param handler The lambda with the data of the entry.
+         * @return True on the success, false otherwise.
+         */
+        bool read(const PackFormat::Entry& entry, const std::function<void(gsl::span<const uint8_t>)>& handler) const;
+
+        /**
+         * Reads the data of an entry through the I/O service instead of the mapping, so no thread waits on page faults.
+         * Compressed entries are decompressed before the callback.
+         * @param entry The entry to read.
+         * @param callback The callback with the data of the entry.
+         */
+        void readAsync(const PackFormat::Entry& entry, IoCallback&& callback) const;
+
+        std::string_view getName(const PackFormat::Entry& entry) const;
+        gsl::span<const PackFormat::Entry> getEntries() const { return { entries, entryCount }; }
+
+    private:
+        bool validate();
+
+        fs::path path;
+        MappedFile file;
+        const PackFormat::Entry* entries{ nullptr };
+        size_t entryCount{ 0 };
+        const PackFormat::Uuid* uuids{ nullptr };
+        size_t uuidCount{ 0 };
+        const char* names{ nullptr };
+        bool valid{ false };
+    };
+
+    /**
+     * @brief Collects files and writes them into a pack file.
+     * Entries are compressed with LZ4 unless the format is already compressed or compression would not pay off.
+     */
+    class FUSION_API PackBuilder {
+    public:
+        /**
+         * @param level The LZ4 HC compression level, 0 stores every entry uncompressed.
+         */
+        explicit PackBuilder(int level = 9);
+        ~PackBuilder() = default;
+        NONCOPYABLE(PackBuilder);
+
+        /**
+         * Adds all files of a directory, paths are relative to the parent of the directory, so the directory name is kept.
+         * Metadata files are not packed, their uuids are stored with the described entries instead.
+         * @param directory The directory to add.
+         */
+        void addDirectory(const fs::path& directory);
+
+        /**
+         * Adds a single file.
+         * @param filepath The path to the file.
+         * @param name The path of the entry inside of the pack.
+         */
+        void addFile(const fs::path& filepath, std::string name);
+
+        /**
+         * Writes the collected files into the pack.
+         * @param filepath The path to the pack file.
+         * @return True on the success, false otherwise.
+         */
+        bool write(const fs::path& filepath) const;
+
+        size_t getFileCount() const { return sources.size(); }
+
+    private:
+        struct Source {
+            fs::path path;
+            std::string name;
+        };
+
+        std::vector<Source> sources;
+        int level;
+    };
+}
@@ -0,0 +1,158 @@
+#include "pack_file_system.h"
+#include "pack_file.h"
+
+using namespace fe;
+
+PackFileSystem::PackFileSystem() : VirtualFileSystem{} {
+}
+
+PackFileSystem::~PackFileSystem() {
+}
+
+void PackFileSystem::mount(const fs::path& path, const fs::path& mount) {
+    unmount(path);
+
+    auto archive = std::make_unique<PackArchive>(path);
+    if (!archive->isValid())
+        return;
+
+    auto point = mount.lexically_normal().generic_string();
+    while (!point.empty() && point.back() == '/')
+        point.pop_back();
+    if (point == ".")
+        point.clear();
+
+    FE_LOG_INFO("Pack: '{}' mounted at '{}' with {} entries", path, point, archive->getEntries().size());
+    mountPoints.push_back({ path, std::move(point), std::move(archive) });
+}
+
+void PackFileSystem::unmount(const fs::path& path) {
+    mountPoints.erase(std::remove_if(mountPoints.begin(), mountPoints.end(), [&path](const MountPoint& mountPoint) {
+        return mountPoint.path == path;
+    }), mountPoints.end());
+}
+
+std::optional<std::string> PackFileSystem::GetEntryName(const MountPoint& mountPoint, const fs::path& filepath) {
+    auto name = filepath.lexically_normal().generic_string();
+    if (mountPoint.mount.empty())
+        return { std::move(name) };
+
+    if (name.compare(0, mountPoint.mount.size(), mountPoint.mount) != 0)
+        return std::nullopt;
+    if (name.size() == mountPoint.mount.size())
+        return std::string{};
+    if (name[mountPoint.mount.size()] != '/')
+        return std::nullopt;
+
+    return name.substr(mountPoint.mount.size() + 1);
+}
+
+void PackFileSystem::readBytes(const fs::path& filepath, const std::function<void(gsl::span<const uint8_t>)>& handler) const {
+    for (const auto& mountPoint : mountPoints) {
+        if (auto name = GetEntryName(mountPoint, filepath)) {
+            if (auto entry = mountPoint.archive->find(*name)) {
+                mountPoint.archive->read(*entry, handler);
+                return;
+            }
+        }
+    }
+
+    FE_LOG_ERROR("File: '{}' could not be found in the mounted packs", filepath);
+}
+
+void PackFileSystem::readAsync(const fs::path& filepath, IoCallback&& callback) const {
+    for (const auto& mountPoint : mountPoints) {
+        if (auto name = GetEntryName(mountPoint, filepath)) {
+            if (auto entry = mountPoint.archive->find(*name)) {
+                mountPoint.archive->readAsync(*entry, std::move(callback));
+                return;
+            }
+        }
+    }
+
+    FE_LOG_ERROR("File: '{}' could not be found in the mounted packs", filepath);
+    IoResult result;
+    result.error = ENOENT;
+    callback(std::move(result));
+}
+
+std::string PackFileSystem::readText(const fs::path& filepath) const {
+    std::string text;
+    readBytes(filepath, [&text](gsl::span<const uint8_t> buffer) {
+        text.assign(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    });
+    return text;
+}
+
+bool PackFileSystem::writeBytes(const fs::path& filepath, gsl::span<const uint8_t> buffer) const {
+    return false;
+}
+
+bool PackFileSystem::writeText(const fs::path& filepath, std::string_view text) const {
+    return false;
+}
+
+bool PackFileSystem::isExists(const fs::path& filepath) const {
+    for (const auto& mountPoint : mountPoints) {
+        if (auto name = GetEntryName(mountPoint, filepath)) {
+            if (mountPoint.archive->find(*name))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool PackFileSystem::isDirectory(const fs::path& filepath) const {
+    for (const auto& mountPoint : mountPoints) {
+        auto name = GetEntryName(mountPoint, filepath);
+        if (!name)
+            continue;
+        if (name->empty())
+            return true;
+
+        *name += '/';
+        for (const auto& entry : mountPoint.archive->getEntries()) {
+            if (mountPoint.archive->getName(entry).compare(0, name->size(), *name) == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+std::vector<fs::path> PackFileSystem::getFiles(const fs::path& filepath, bool recursive, std::string_view ext) const {
+    std::vector<fs::path> paths;
+
+    for (const auto& mountPoint : mountPoints) {
+        auto name = GetEntryName(mountPoint, filepath);
+        if (!name)
+            continue;
+        if (!name->empty())
+            *name += '/';
+
+        for (const auto& entry : mountPoint.archive->getEntries()) {
+            auto entryName = mountPoint.archive->getName(entry);
+            if (entryName.compare(0, name->size(), *name) != 0)
+                continue;
+            if (!recursive && entryName.find('/', name->size()) != std::string_view::npos)
+                continue;
+
+            fs::path path{ mountPoint.mount };
+            path /= entryName;
+            if (ext.empty() || FileSystem::GetExtension(path) == ext)
+                paths.push_back(std::move(path));
+        }
+    }
+
+    return paths;
+}
+
+std::optional<fs::path> PackFileSystem::getPath(const uuids::uuid& uuid) const {
+    for (const auto& mountPoint : mountPoints) {
+        if (auto entry = mountPoint.archive->find(uuid)) {
+            fs::path path{ mountPoint.mount };
+            path /= mountPoint.archive->getName(*entry);
+            return { std::move(path) };
+        }
+    }
+    return std::nullopt;
+}
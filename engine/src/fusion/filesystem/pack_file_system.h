@@ -0,0 +1,69 @@
+#pragma once
+
+#include "fusion/filesystem/virtual_file_system.h"
+#include "fusion/filesystem/io_service.h"
+
+namespace fe {
+    class PackArchive;
+
+    /**
+     * @brief Read-only file system over mounted pack files, entries are searched in the order the packs were mounted.
+     * Uncompressed entries are read without a copy from the mapped pack.
+     */
+    class FUSION_API PackFileSystem final : public VirtualFileSystem {
+    public:
+        PackFileSystem();
+        ~PackFileSystem() override;
+
+        void mount(const fs::path& path, const fs::path& mount) override;
+
+        void unmount(const fs::path& path) override;
+
+        void readBytes(const fs::path& filepath, const std::function<void(gsl::span<const uint8_t>)>& handler) const override;
+
+        std::string readText(const fs::path& filepath) const override;
+
+        bool writeBytes(const fs::path& filepath, gsl::span<const uint8_t> buffer) const override;
+
+        bool writeText(const fs::path& filepath, std::string_view text) const override;
+
+        bool isExists(const fs::path& filepath) const override;
+
+        bool isDirectory(const fs::path& filepath) const override;
+
+        std::vector<fs::path> getFiles(const fs::path& filepath, bool recursive = false, std::string_view ext = "") const override;
+
+        /**
+         * Reads a file through the I/O service.
+         * @param filepath The path to read.
+         * @param callback The callback with the data of the file.
+         */
+        void readAsync(const fs::path& filepath, IoCallback&& callback) const;
+
+        /**
+         * Finds the path of an asset by the uuid from its metadata.
+         * @param uuid The uuid of the asset.
+         * @return The mounted path of the asset.
+         */
+        std::optional<fs::path> getPath(const uuids::uuid& uuid) const;
+
+        bool isEmpty() const { return mountPoints.empty(); }
+
+    private:
+        struct MountPoint {
+            fs::path path;
+            std::string mount; /// Generic path the pack is mounted at, empty for the root.
+            std::unique_ptr<PackArchive> archive;
+        };
+
+        /**
+         * Converts the path into the name of an entry inside of the pack.
+         * @param mountPoint The mounted pack.
+         * @param filepath The path to convert.
+         * @return The entry name or nullopt if the path is outside of the mount point.
+         */
+        static std::optional<std::string> GetEntryName(const MountPoint& mountPoint, const fs::path& filepath);
+
+        std::vector<MountPoint> mountPoints;
+    };
+}
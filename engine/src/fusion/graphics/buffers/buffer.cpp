@@ -2,6 +2,7 @@
 
 #include "fusion/graphics/graphics.h"
 #include "fusion/graphics/commands/command_buffer.h"
+#include "fusion/core/perf_counters.h"
 
 using namespace fe;
 
@@ -181,17 +182,20 @@ std::unique_ptr<Buffer> Buffer::StageToDeviceBuffer(VkBufferUsageFlags usage, Vk
 
     commandBuffer.submitIdle();
 
+    PerfCounters::Add(PerfCounters::Counter::BufferUploads);
+    PerfCounters::Add(PerfCounters::Counter::UploadedBytes, static_cast<int64_t>(size));
+
     return deviceBuffer;
 }
 
 std::unique_ptr<Buffer> Buffer::DeviceToStageBuffer(const Buffer& deviceBuffer) {
-    auto stagingBuffer = std::make_unique<Buffer>(deviceBuffer, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    auto stagingBuffer = std::make_unique<Buffer>(deviceBuffer.getSize(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
     CommandBuffer commandBuffer{true};
 
     VkBufferCopy copyRegion = {};
     copyRegion.size = stagingBuffer->getSize();
-    vkCmdCopyBuffer(commandBuffer, *stagingBuffer, deviceBuffer, 1, &copyRegion);
+    vkCmdCopyBuffer(commandBuffer, deviceBuffer, *stagingBuffer, 1, &copyRegion);
 
     commandBuffer.submitIdle();
 
@@ -0,0 +1,73 @@
+#include "frame_allocator.h"
+
+#include "fusion/graphics/graphics.h"
+#include "fusion/core/perf_counters.h"
+
+using namespace fe;
+
+static VkDeviceSize GetMinOffsetAlignment() {
+    const auto& limits = Graphics::Get()->getPhysicalDevice().getProperties().limits;
+    return std::max(limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment);
+}
+
+FrameAllocator::FrameAllocator(VkDeviceSize capacity, uint32_t frames)
+        : Buffer{capacity * frames, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT}
+        , capacity{capacity}
+        , alignment{GetMinOffsetAlignment()} {
+    // Memory stays mapped for the whole lifetime of the allocator
+    map();
+}
+
+void FrameAllocator::reset(size_t frame) {
+    begin = capacity * frame;
+    head = begin;
+    required = 0;
+    overflows = 0;
+}
+
+FrameAllocator::Allocation FrameAllocator::allocate(VkDeviceSize allocationSize) {
+    if (allocationSize == 0)
+        return {};
+
+    VkDeviceSize offset = (head + alignment - 1) & ~(alignment - 1);
+    required += (allocationSize + alignment - 1) & ~(alignment - 1);
+    if (offset + allocationSize > begin + capacity) {
+        // Reported once per frame, the allocator grows before the next one
+        if (overflows++ == 0)
+            FE_LOG_ERROR("Frame allocator is out of memory, draws are dropped: requested = {}, used = {}, capacity = {}", allocationSize, getUsed(), capacity);
+        return {};
+    }
+
+    head = offset + allocationSize;
+
+    PerfCounters::Add(PerfCounters::Counter::BufferUploads);
+    PerfCounters::Add(PerfCounters::Counter::UploadedBytes, static_cast<int64_t>(allocationSize));
+
+    return { static_cast<uint8_t*>(mapped) + offset, static_cast<uint32_t>(offset), static_cast<uint32_t>(allocationSize) };
+}
+
+WriteDescriptorSet FrameAllocator::getWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize>& offsetSize) const {
+    // Dynamic descriptors point to the buffer start, the slice is selected by the dynamic offset when binding
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = buffer;
+    if (offsetSize) {
+        bufferInfo.offset = offsetSize->getOffset();
+        bufferInfo.range = offsetSize->getSize();
+    } else {
+        bufferInfo.offset = 0;
+        bufferInfo.range = capacity;
+    }
+
+    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    descriptorWrite.dstSet = VK_NULL_HANDLE; // Will be set in the descriptor handler.
+    descriptorWrite.dstBinding = binding;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.descriptorType = descriptorType;
+    return {descriptorWrite, bufferInfo};
+}
+
+void FrameAllocator::Allocation::push(const void* object, size_t objectSize, size_t objectOffset) const {
+    FE_ASSERT(data && objectOffset + objectSize <= size && "Push is out of allocation range");
+    std::memcpy(static_cast<uint8_t*>(data) + objectOffset, object, objectSize);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "fusion/graphics/descriptors/descriptor.h"
+#include "fusion/graphics/buffers/buffer.h"
+
+namespace fe {
+    /**
+     * @brief Linear allocator over a persistently mapped buffer which is split into one region per frame in flight.
+     * Transient uniform and storage data is bumped into the region of the current frame and bound by dynamic offsets,
+     * the region is reset once the fence of the frame that used it has been signaled.
+     */
+    class FUSION_API FrameAllocator final : public Descriptor, public Buffer {
+    public:
+        /**
+         * @brief Slice of the current frame region.
+         */
+        struct Allocation {
+            void* data{ nullptr };
+            uint32_t offset{ 0 };
+            uint32_t size{ 0 };
+
+            /**
+             * Copies the specified data into the slice.
+             * @param object Pointer to the data to copy.
+             * @param objectSize Size of the data in bytes.
+             * @param objectOffset Byte offset from beginning of the slice.
+             */
+            void push(const void* object, size_t objectSize, size_t objectOffset = 0) const;
+
+            template<typename T>
+            void push(const T& object, size_t objectOffset = 0) const {
+                push(&object, sizeof(T), objectOffset);
+            }
+
+            operator bool() const { return data != nullptr; }
+        };
+
+        /**
+         * Creates a new frame allocator.
+         * @param capacity Size of the region reserved for each frame in flight, in bytes.
+         * @param frames The number of regions to create.
+         */
+        FrameAllocator(VkDeviceSize capacity, uint32_t frames);
+        ~FrameAllocator() override = default;
+        NONCOPYABLE(FrameAllocator);
+
+        /**
+         * Rewinds the region used by the frame and clears the overflow of the last one, must only be called when the frame fence was signaled.
+         * @param frame The frame in flight index.
+         */
+        void reset(size_t frame);
+
+        /**
+         * Bumps a new slice from the current frame region.
+         * @param allocationSize Size of the slice in bytes.
+         * @return The allocation, it is empty when the region is exhausted.
+         */
+        Allocation allocate(VkDeviceSize allocationSize);
+
+        /**
+         * Gets if allocations failed since the last reset, {@link Graphics} replaces the allocator with a bigger one then.
+         * @return If the region was exhausted.
+         */
+        bool hasOverflowed() const { return overflows != 0; }
+
+        /**
+         * Bumps a new slice and copies the object into it.
+         * @param object The object to copy.
+         * @return The allocation, it is empty when the region is exhausted.
+         */
+        template<typename T>
+        Allocation allocate(const T& object) {
+            auto allocation = allocate(sizeof(T));
+            if (allocation)
+                allocation.push(object);
+            return allocation;
+        }
+
+        WriteDescriptorSet getWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize>& offsetSize) const override;
+
+        VkDeviceSize getCapacity() const { return capacity; }
+        VkDeviceSize getAlignment() const { return alignment; }
+        VkDeviceSize getUsed() const { return head - begin; }
+        VkDeviceSize getRequired() const { return required; }
+
+    private:
+        VkDeviceSize capacity;
+        VkDeviceSize alignment;
+        VkDeviceSize begin{ 0 };
+        VkDeviceSize head{ 0 };
+        VkDeviceSize required{ 0 }; /// Bytes the frame asked for, including the failed allocations.
+        uint32_t overflows{ 0 }; /// Failed allocations since the last reset.
+    };
+}
@@ -24,6 +24,19 @@ bool PushHandler::update(const std::optional<Shader::UniformBlock>& uniformBlock
 	return true;
 }
 
+bool PushHandler::update(const Shader::UniformBlock* uniformBlock) {
+    // Same block as on the last update, skips the deep comparison
+    if (uniformBlock && uniformBlock == lastUniformBlock)
+        return true;
+
+    lastUniformBlock = uniformBlock;
+    return update(uniformBlock ? std::make_optional(*uniformBlock) : std::nullopt);
+}
+
 void PushHandler::bindPush(const CommandBuffer& commandBuffer, const Pipeline& pipeline) {
 	vkCmdPushConstants(commandBuffer, pipeline.getPipelineLayout(), uniformBlock->getStageFlags(), 0, static_cast<uint32_t>(uniformBlock->getSize()), data.get());
-}
\ No newline at end of file
+}
+
+void PushHandler::bindPush(const CommandBuffer& commandBuffer, const Pipeline& pipeline, const void* pushData) const {
+    vkCmdPushConstants(commandBuffer, pipeline.getPipelineLayout(), uniformBlock->getStageFlags(), 0, static_cast<uint32_t>(uniformBlock->getSize()), pushData);
+}
@@ -35,12 +35,37 @@ namespace fe {
             push(object, static_cast<size_t>(uniform->getOffset()), realSize);
         }
 
+        template<typename T>
+        void push(const Shader::UniformHandle& handle, const T& object, size_t size = 0) {
+            if (!uniformBlock || !handle)
+                return;
+
+            auto realSize = size;
+            if (realSize == 0)
+                realSize = glm::min(sizeof(object), static_cast<size_t>(handle.size));
+
+            push(object, static_cast<size_t>(handle.offset), realSize);
+        }
+
         bool update(const std::optional<Shader::UniformBlock>& uniformBlock);
+        bool update(const Shader::UniformBlock* uniformBlock);
 
         void bindPush(const CommandBuffer& commandBuffer, const Pipeline& pipeline);
 
+        /**
+         * Pushes data laid out as the block, allows to record values collected earlier from several threads.
+         * @param commandBuffer The command buffer to record into.
+         * @param pipeline The pipeline the block belongs to.
+         * @param pushData The data of the block size.
+         */
+        void bindPush(const CommandBuffer& commandBuffer, const Pipeline& pipeline, const void* pushData) const;
+
+        const uint8_t* getData() const { return data.get(); }
+        uint32_t getSize() const { return uniformBlock ? static_cast<uint32_t>(uniformBlock->getSize()) : 0; }
+
     private:
         std::optional<Shader::UniformBlock> uniformBlock;
+        const Shader::UniformBlock* lastUniformBlock{ nullptr }; /// Block given on the last update, allows to skip the deep comparison.
         std::unique_ptr<uint8_t[]> data;
         bool multipipeline;
     };
@@ -0,0 +1,82 @@
+#include "shadow_buffer.h"
+#include "buffer.h"
+
+using namespace fe;
+
+static const size_t MAX_DIRTY_RANGES = 16;
+
+void ShadowBuffer::resize(size_t newSize) {
+    if (size != newSize) {
+        auto newData = std::make_unique<uint8_t[]>(newSize);
+        std::memset(newData.get(), 0, newSize);
+        if (data)
+            std::memcpy(newData.get(), data.get(), std::min(size, newSize));
+        data = std::move(newData);
+        size = newSize;
+    }
+
+    invalidate();
+}
+
+bool ShadowBuffer::write(const void* object, size_t objectSize, size_t offset) {
+    if (offset + objectSize > size) {
+        FE_LOG_ERROR("Shadow buffer write is out of range: offset = {}, size = {}, capacity = {}", offset, objectSize, size);
+        return false;
+    }
+
+    auto dst = data.get() + offset;
+    if (std::memcmp(dst, object, objectSize) == 0)
+        return false;
+
+    std::memcpy(dst, object, objectSize);
+    markDirty(offset, offset + objectSize);
+    return true;
+}
+
+void ShadowBuffer::invalidate() {
+    dirtyRanges.clear();
+    if (size != 0)
+        dirtyRanges.emplace_back(0, size);
+}
+
+void ShadowBuffer::flush(Buffer& buffer) {
+    if (dirtyRanges.empty())
+        return;
+
+    FE_ASSERT(buffer.getMappedMemory() && "Cannot flush to unmapped buffer");
+
+    for (const auto& [begin, end] : dirtyRanges) {
+        buffer.copy(data.get() + begin, end - begin, begin);
+    }
+
+    dirtyRanges.clear();
+}
+
+void ShadowBuffer::markDirty(size_t begin, size_t end) {
+    // Finds the first range which can be merged with the new one
+    auto it = std::lower_bound(dirtyRanges.begin(), dirtyRanges.end(), begin, [](const std::pair<size_t, size_t>& range, size_t value) {
+        return range.second < value;
+    });
+
+    if (it == dirtyRanges.end() || it->first > end) {
+        dirtyRanges.emplace(it, begin, end);
+    } else {
+        // Swallows every touching range
+        auto last = it;
+        while (last != dirtyRanges.end() && last->first <= end) {
+            begin = std::min(begin, last->first);
+            end = std::max(end, last->second);
+            ++last;
+        }
+        *it = { begin, end };
+        dirtyRanges.erase(it + 1, last);
+    }
+
+    // Too many small copies are slower than a single bigger one
+    if (dirtyRanges.size() > MAX_DIRTY_RANGES) {
+        auto first = dirtyRanges.front().first;
+        auto second = dirtyRanges.back().second;
+        dirtyRanges.clear();
+        dirtyRanges.emplace_back(first, second);
+    }
+}
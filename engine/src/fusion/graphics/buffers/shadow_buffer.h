@@ -0,0 +1,52 @@
+#pragma once
+
+namespace fe {
+    struct Buffer;
+    /**
+     * @brief CPU copy of a host visible buffer. Changes are detected against the copy instead of the mapped memory,
+     * which is often write-combined and very slow to read back, and only the dirty byte ranges are written to the buffer.
+     */
+    class FUSION_API ShadowBuffer {
+    public:
+        ShadowBuffer() = default;
+        ~ShadowBuffer() = default;
+        NONCOPYABLE(ShadowBuffer);
+
+        /**
+         * Resizes the copy, existing content is kept and the whole range is marked as dirty.
+         * @param newSize The new size in bytes.
+         */
+        void resize(size_t newSize);
+
+        /**
+         * Writes the data into the copy if it differs from the stored one.
+         * @param object Pointer to the data to write.
+         * @param objectSize Size of the data in bytes.
+         * @param offset Byte offset from beginning of the copy.
+         * @return True if the content was changed.
+         */
+        bool write(const void* object, size_t objectSize, size_t offset = 0);
+
+        /**
+         * Marks the whole copy as dirty, used when the buffer was recreated.
+         */
+        void invalidate();
+
+        /**
+         * Writes the dirty ranges into the mapped buffer and clears them.
+         * @param buffer The mapped buffer to write.
+         */
+        void flush(Buffer& buffer);
+
+        bool isDirty() const { return !dirtyRanges.empty(); }
+        size_t getSize() const { return size; }
+        const uint8_t* getData() const { return data.get(); }
+
+    private:
+        void markDirty(size_t begin, size_t end);
+
+        std::unique_ptr<uint8_t[]> data;
+        size_t size{ 0 };
+        std::vector<std::pair<size_t, size_t>> dirtyRanges; /// Sorted, non overlapping [begin, end) ranges.
+    };
+}
@@ -13,6 +13,8 @@ StorageHandler::StorageHandler(const Shader::UniformBlock& uniformBlock, bool mu
         , size{static_cast<uint32_t>(this->uniformBlock->getSize())}
         , storageBuffer{std::make_unique<StorageBuffer>(static_cast<VkDeviceSize>(size))}
         , handlerStatus{Buffer::Status::Changed} {
+    storageBuffer->map();
+    shadow.resize(size);
 }
 
 bool StorageHandler::update(const std::optional<Shader::UniformBlock>& uniformBlock) {
@@ -22,20 +24,33 @@ bool StorageHandler::update(const std::optional<Shader::UniformBlock>& uniformBl
 		}
 
 		this->uniformBlock = uniformBlock;
-		bound = false;
 		storageBuffer = std::make_unique<StorageBuffer>(static_cast<VkDeviceSize>(size));
+		storageBuffer->map();
+		shadow.resize(size);
+		shadow.flush(*storageBuffer);
 		handlerStatus = Buffer::Status::Changed;
 		return false;
 	}
 
 	if (handlerStatus != Buffer::Status::Normal) {
-		if (bound) {
-			storageBuffer->unmap();
-			bound = false;
-		}
-
+		// Only the changed ranges of this frame are written to the mapped memory
+		shadow.flush(*storageBuffer);
 		handlerStatus = Buffer::Status::Normal;
 	}
 
 	return true;
 }
+
+bool StorageHandler::update(const Shader::UniformBlock* uniformBlock) {
+    // Same block as on the last update, only pending changes need to be written
+    if (uniformBlock && uniformBlock == lastUniformBlock && handlerStatus != Buffer::Status::Reset) {
+        if (handlerStatus != Buffer::Status::Normal) {
+            shadow.flush(*storageBuffer);
+            handlerStatus = Buffer::Status::Normal;
+        }
+        return true;
+    }
+
+    lastUniformBlock = uniformBlock;
+    return update(uniformBlock ? std::make_optional(*uniformBlock) : std::nullopt);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fusion/graphics/buffers/storage_buffer.h"
+#include "fusion/graphics/buffers/shadow_buffer.h"
 #include "fusion/graphics/pipelines/shader.h"
 
 namespace fe {
@@ -14,7 +15,10 @@ namespace fe {
 
         void push(void* data, size_t size) {
             if (this->size != size) {
+                // Keeps the data in the cpu copy, it is written once the buffer is recreated
                 this->size = static_cast<uint32_t>(size);
+                shadow.resize(size);
+                shadow.write(data, size);
                 handlerStatus = Buffer::Status::Reset;
                 return;
             }
@@ -22,16 +26,9 @@ namespace fe {
             if (!uniformBlock || !storageBuffer)
                 return;
 
-            if (!bound) {
-                storageBuffer->map();
-                bound = true;
-            }
-
-            // If the buffer is already changed we can skip a memory comparison and just copy
-            if (handlerStatus == Buffer::Status::Changed || storageBuffer->compare(data, size) != 0) {
-                storageBuffer->copy(data, size);
+            // Compares against the cpu copy, changes are written to the buffer once on update
+            if (shadow.write(data, size) && handlerStatus == Buffer::Status::Normal)
                 handlerStatus = Buffer::Status::Changed;
-            }
         }
 
         template<typename T>
@@ -39,16 +36,8 @@ namespace fe {
             if (!uniformBlock || !storageBuffer)
                 return;
 
-            if (!bound) {
-                storageBuffer->unmap();
-                bound = true;
-            }
-
-            // If the buffer is already changed we can skip a memory comparison and just copy
-            if (handlerStatus == Buffer::Status::Changed || storageBuffer->compare(&object, size, offset) != 0) {
-                storageBuffer->copy(&object, size, offset);
+            if (shadow.write(&object, size, offset) && handlerStatus == Buffer::Status::Normal)
                 handlerStatus = Buffer::Status::Changed;
-            }
         }
 
         template<typename T>
@@ -67,16 +56,30 @@ namespace fe {
             push(object, static_cast<size_t>(uniform->getOffset()), realSize);
         }
 
+        template<typename T>
+        void push(const Shader::UniformHandle& handle, const T& object, size_t size = 0) {
+            if (!handle)
+                return;
+
+            auto realSize = size;
+            if (realSize == 0)
+                realSize = glm::min(sizeof(object), static_cast<size_t>(handle.size));
+
+            push(object, static_cast<size_t>(handle.offset), realSize);
+        }
+
         bool update(const std::optional<Shader::UniformBlock>& uniformBlock);
+        bool update(const Shader::UniformBlock* uniformBlock);
 
         const StorageBuffer* getStorageBuffer() const { return storageBuffer.get(); }
 
     private:
         std::optional<Shader::UniformBlock> uniformBlock;
+        const Shader::UniformBlock* lastUniformBlock{ nullptr }; /// Block given on the last update, allows to skip the deep comparison.
         uint32_t size{ 0 };
         std::unique_ptr<StorageBuffer> storageBuffer;
+        ShadowBuffer shadow;
         Buffer::Status handlerStatus;
-        bool bound{ false };
         bool multipipeline;
     };
 }
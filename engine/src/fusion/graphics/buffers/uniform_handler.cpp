@@ -14,6 +14,8 @@ UniformHandler::UniformHandler(const Shader::UniformBlock& uniformBlock, bool mu
         , size{static_cast<uint32_t>(this->uniformBlock->getSize())}
         , uniformBuffer{std::make_unique<UniformBuffer>(static_cast<VkDeviceSize>(size))}
         , handlerStatus{Buffer::Status::Normal} {
+    uniformBuffer->map();
+    shadow.resize(size);
 }
 
 bool UniformHandler::update(const std::optional<Shader::UniformBlock>& uniformBlock) {
@@ -23,20 +25,33 @@ bool UniformHandler::update(const std::optional<Shader::UniformBlock>& uniformBl
 		}
 
 		this->uniformBlock = uniformBlock;
-		bound = false;
 		uniformBuffer = std::make_unique<UniformBuffer>(static_cast<VkDeviceSize>(size));
+		uniformBuffer->map();
+		shadow.resize(size);
+		shadow.flush(*uniformBuffer);
 		handlerStatus = Buffer::Status::Changed;
 		return false;
 	}
 
 	if (handlerStatus != Buffer::Status::Normal) {
-		if (bound) {
-			uniformBuffer->unmap();
-			bound = false;
-		}
-
+		// Only the changed ranges of this frame are written to the mapped memory
+		shadow.flush(*uniformBuffer);
 		handlerStatus = Buffer::Status::Normal;
 	}
 
 	return true;
 }
+
+bool UniformHandler::update(const Shader::UniformBlock* uniformBlock) {
+    // Same block as on the last update, only pending changes need to be written
+    if (uniformBlock && uniformBlock == lastUniformBlock && handlerStatus != Buffer::Status::Reset) {
+        if (handlerStatus != Buffer::Status::Normal) {
+            shadow.flush(*uniformBuffer);
+            handlerStatus = Buffer::Status::Normal;
+        }
+        return true;
+    }
+
+    lastUniformBlock = uniformBlock;
+    return update(uniformBlock ? std::make_optional(*uniformBlock) : std::nullopt);
+}
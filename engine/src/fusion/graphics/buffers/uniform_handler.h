@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fusion/graphics/buffers/uniform_buffer.h"
+#include "fusion/graphics/buffers/shadow_buffer.h"
 #include "fusion/graphics/pipelines/shader.h"
 
 namespace fe {
@@ -17,16 +18,9 @@ namespace fe {
             if (!uniformBlock || !uniformBuffer)
                 return;
 
-            if (!bound) {
-                uniformBuffer->map();
-                bound = true;
-            }
-
-            // If the buffer is already changed we can skip a memory comparison and just copy
-            if (handlerStatus == Buffer::Status::Changed || uniformBuffer->compare(&object, size, offset) != 0) {
-                uniformBuffer->copy(&object, size, offset);
+            // Compares against the cpu copy, changes are written to the buffer once on update
+            if (shadow.write(&object, size, offset) && handlerStatus == Buffer::Status::Normal)
                 handlerStatus = Buffer::Status::Changed;
-            }
         }
 
         template<typename T>
@@ -45,16 +39,30 @@ namespace fe {
             push(object, static_cast<size_t>(uniform->getOffset()), realSize);
         }
 
+        template<typename T>
+        void push(const Shader::UniformHandle& handle, const T& object, size_t size = 0) {
+            if (!handle)
+                return;
+
+            auto realSize = size;
+            if (realSize == 0)
+                realSize = glm::min(sizeof(object), static_cast<size_t>(handle.size));
+
+            push(object, static_cast<size_t>(handle.offset), realSize);
+        }
+
         bool update(const std::optional<Shader::UniformBlock>& uniformBlock);
+        bool update(const Shader::UniformBlock* uniformBlock);
 
         const UniformBuffer* getUniformBuffer() const { return uniformBuffer.get(); }
 
     private:
         std::optional<Shader::UniformBlock> uniformBlock;
+        const Shader::UniformBlock* lastUniformBlock{ nullptr }; /// Block given on the last update, allows to skip the deep comparison.
         uint32_t size{ 0 };
         std::unique_ptr<UniformBuffer> uniformBuffer;
+        ShadowBuffer shadow;
         Buffer::Status handlerStatus;
-        bool bound{ false };
         bool multipipeline;
     };
 }
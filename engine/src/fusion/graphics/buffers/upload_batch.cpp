@@ -0,0 +1,56 @@
+#include "upload_batch.h"
+
+#include "fusion/graphics/graphics.h"
+#include "fusion/core/perf_counters.h"
+
+using namespace fe;
+
+UploadBatch::UploadBatch() : commandBuffer{true} {
+    VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+    VK_CHECK(vkCreateFence(Graphics::Get()->getLogicalDevice(), &fenceCreateInfo, nullptr, &fence));
+}
+
+UploadBatch::~UploadBatch() {
+    // Command buffer and staging buffers cannot be released while the copies still run
+    if (submitted)
+        wait();
+    vkDestroyFence(Graphics::Get()->getLogicalDevice(), fence, nullptr);
+}
+
+const Buffer& UploadBatch::stage(VkDeviceSize size, const void* data) {
+    FE_ASSERT(!submitted && "Batch was already submitted");
+    stagedBytes += size;
+    return *stagingBuffers.emplace_back(std::make_unique<Buffer>(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, data));
+}
+
+std::unique_ptr<Buffer> UploadBatch::stageToDeviceBuffer(VkBufferUsageFlags usage, VkDeviceSize size, const void* data) {
+    const auto& stagingBuffer = stage(size, data);
+    auto deviceBuffer = std::make_unique<Buffer>(size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    VkBufferCopy copyRegion = {};
+    copyRegion.size = size;
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, *deviceBuffer, 1, &copyRegion);
+
+    PerfCounters::Add(PerfCounters::Counter::BufferUploads);
+    PerfCounters::Add(PerfCounters::Counter::UploadedBytes, static_cast<int64_t>(size));
+
+    return deviceBuffer;
+}
+
+void UploadBatch::submit() {
+    if (submitted)
+        return;
+
+    commandBuffer.submit(VK_NULL_HANDLE, VK_NULL_HANDLE, fence);
+    submitted = true;
+}
+
+void UploadBatch::wait() const {
+    if (!submitted)
+        return;
+    VK_CHECK(vkWaitForFences(Graphics::Get()->getLogicalDevice(), 1, &fence, VK_TRUE, UINT64_MAX));
+}
+
+bool UploadBatch::isComplete() const {
+    return submitted && vkGetFenceStatus(Graphics::Get()->getLogicalDevice(), fence) == VK_SUCCESS;
+}
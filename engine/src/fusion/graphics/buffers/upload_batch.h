@@ -0,0 +1,61 @@
+#pragma once
+
+#include "fusion/graphics/buffers/buffer.h"
+#include "fusion/graphics/commands/command_buffer.h"
+
+namespace fe {
+    /**
+     * @brief Records many staging copies into a single command buffer which is submitted once and tracked with a fence,
+     * staging buffers are kept alive until the copies completed.
+     */
+    class FUSION_API UploadBatch {
+    public:
+        UploadBatch();
+        ~UploadBatch();
+        NONCOPYABLE(UploadBatch);
+
+        /**
+         * Copies the data into a new staging buffer owned by the batch.
+         * @param size Size of the data in bytes.
+         * @param data Pointer to the data.
+         * @return The staging buffer to copy from.
+         */
+        const Buffer& stage(VkDeviceSize size, const void* data);
+
+        /**
+         * Creates a device local buffer and records the copy of the data into it.
+         * @param usage Usage flag bitmask for the buffer.
+         * @param size Size of the data in bytes.
+         * @param data Pointer to the data.
+         * @return The device buffer, its content is valid once the batch completed.
+         */
+        std::unique_ptr<Buffer> stageToDeviceBuffer(VkBufferUsageFlags usage, VkDeviceSize size, const void* data);
+
+        /**
+         * Ends the recording and submits the batch.
+         */
+        void submit();
+
+        /**
+         * Holds the current thread until the submitted copies finished.
+         */
+        void wait() const;
+
+        /**
+         * Checks if the submitted copies finished without waiting.
+         * @return If the batch completed.
+         */
+        bool isComplete() const;
+
+        const CommandBuffer& getCommandBuffer() const { return commandBuffer; }
+        VkDeviceSize getStagedBytes() const { return stagedBytes; }
+        bool isSubmitted() const { return submitted; }
+
+    private:
+        CommandBuffer commandBuffer;
+        VkFence fence{ VK_NULL_HANDLE };
+        std::vector<std::unique_ptr<Buffer>> stagingBuffers;
+        VkDeviceSize stagedBytes{ 0 };
+        bool submitted{ false };
+    };
+}
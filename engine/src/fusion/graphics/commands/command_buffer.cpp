@@ -8,7 +8,8 @@ using namespace fe;
 CommandBuffer::CommandBuffer(bool begin, VkQueueFlagBits queueType, VkCommandBufferLevel bufferLevel)
         : logicalDevice{Graphics::Get()->getLogicalDevice()}
         , commandPool{Graphics::Get()->getCommandPool()}
-        , queueType{queueType} {
+        , queueType{queueType}
+        , bufferLevel{bufferLevel} {
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	commandBufferAllocateInfo.commandPool = *commandPool;
 	commandBufferAllocateInfo.level = bufferLevel;
@@ -23,12 +24,13 @@ CommandBuffer::~CommandBuffer() {
 	vkFreeCommandBuffers(logicalDevice, *commandPool, 1, &commandBuffer);
 }
 
-void CommandBuffer::begin(VkCommandBufferUsageFlags usage) {
+void CommandBuffer::begin(VkCommandBufferUsageFlags usage, const VkCommandBufferInheritanceInfo* inheritanceInfo) {
 	if (running)
 		return;
 
 	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
     commandBufferBeginInfo.flags = usage;
+    commandBufferBeginInfo.pInheritanceInfo = inheritanceInfo;
 	VK_CHECK(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo));
 	running = true;
 }
@@ -57,7 +59,11 @@ void CommandBuffer::submitIdle() {
 	VK_CHECK(vkCreateFence(logicalDevice, &fenceCreateInfo, nullptr, &fence));
 
 	//VK_RESULT(vkResetFences(logicalDevice, 1, &fence));
-	VK_CHECK(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
+	{
+		// Uploads from the main thread can race with frames submitted on the render thread
+		std::unique_lock<std::mutex> lock(Graphics::Get()->getQueueMutex());
+		VK_CHECK(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
+	}
 	VK_CHECK(vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE, UINT64_MAX));
 
 	vkDestroyFence(logicalDevice, fence, nullptr);
@@ -89,6 +95,7 @@ void CommandBuffer::submit(VkSemaphore waitSemaphore, VkSemaphore signalSemaphor
         VK_CHECK(vkResetFences(logicalDevice, 1, &fence));
     }
 
+	std::unique_lock<std::mutex> lock(Graphics::Get()->getQueueMutex());
 	VK_CHECK(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
 }
 
@@ -20,8 +20,9 @@ namespace fe {
         /**
          * Begins the recording state for this command buffer.
          * @param usage How this command buffer will be used.
+         * @param inheritanceInfo The render pass state inherited by a secondary command buffer.
          */
-        void begin(VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        void begin(VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, const VkCommandBufferInheritanceInfo* inheritanceInfo = nullptr);
 
         /**
          * Ends the recording state for this command buffer.
@@ -53,6 +54,7 @@ namespace fe {
 
         const VkCommandBuffer& getCommandBuffer() const { return commandBuffer; }
         bool isRunning() const { return running; }
+        bool isSecondary() const { return bufferLevel == VK_COMMAND_BUFFER_LEVEL_SECONDARY; }
 
         VkQueue getQueue() const;
 
@@ -62,6 +64,7 @@ namespace fe {
         std::shared_ptr<CommandPool> commandPool;
 
         VkQueueFlagBits queueType;
+        VkCommandBufferLevel bufferLevel;
         VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
         bool running{ false };
     };
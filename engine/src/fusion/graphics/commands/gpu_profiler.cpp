@@ -0,0 +1,125 @@
+#include "gpu_profiler.h"
+
+#include "fusion/graphics/commands/command_buffer.h"
+#include "fusion/graphics/devices/physical_device.h"
+#include "fusion/graphics/devices/logical_device.h"
+
+using namespace fe;
+
+GpuProfiler::GpuProfiler(const PhysicalDevice& physicalDevice, const LogicalDevice& logicalDevice, uint32_t frames, uint32_t capacity)
+        : logicalDevice{logicalDevice}
+        , capacity{capacity} {
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    uint32_t validBits = physicalDevice.getGraphicsFamily() < familyCount ? families[physicalDevice.getGraphicsFamily()].timestampValidBits : 0;
+    if (validBits == 0) {
+        FE_LOG_WARNING("Graphics queue does not support timestamps, GPU profiler is disabled");
+        return;
+    }
+
+    timestampPeriod = physicalDevice.getProperties().limits.timestampPeriod;
+    timestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t{1} << validBits) - 1;
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = capacity;
+
+    this->frames.resize(frames);
+    for (auto& frame : this->frames) {
+        VK_CHECK(vkCreateQueryPool(logicalDevice, &queryPoolCreateInfo, nullptr, &frame.queryPool));
+    }
+    timestamps.resize(capacity);
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (const auto& frame : frames) {
+        vkDestroyQueryPool(logicalDevice, frame.queryPool, nullptr);
+    }
+}
+
+void GpuProfiler::beginFrame(const CommandBuffer& commandBuffer, size_t frame) {
+    current = nullptr;
+    if (!isSupported())
+        return;
+
+    auto& next = frames[frame];
+    if (!next.samples.empty())
+        resolve(next);
+
+    next.used = 0;
+    next.samples.clear();
+
+    if (!enabled)
+        return;
+
+    vkCmdResetQueryPool(commandBuffer, next.queryPool, 0, capacity);
+    current = &next;
+}
+
+void GpuProfiler::end(const CommandBuffer& commandBuffer, uint32_t scope) {
+    if (!current || scope >= current->samples.size() || current->used == capacity)
+        return;
+
+    auto& sample = current->samples[scope];
+    if (sample.end != UINT32_MAX)
+        return;
+
+    sample.end = current->used++;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, current->queryPool, sample.end);
+}
+
+std::vector<GpuProfiler::Zone> GpuProfiler::getZones() const {
+    std::unique_lock<std::mutex> lock(mutex);
+    return resolved;
+}
+
+uint32_t GpuProfiler::addZone(uint64_t key, uint32_t depth, std::string&& name) {
+    auto index = static_cast<uint32_t>(zones.size());
+    auto& zone = zones.emplace_back();
+    zone.name = std::move(name);
+    zone.depth = depth;
+    zoneIndices.emplace(key, index);
+    return index;
+}
+
+uint32_t GpuProfiler::beginZone(const CommandBuffer& commandBuffer, uint32_t zone) {
+    // Keeps a query for the end, so an opened scope can always be closed
+    if (current->used + 2 > capacity)
+        return UINT32_MAX;
+
+    auto query = current->used++;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current->queryPool, query);
+
+    auto scope = static_cast<uint32_t>(current->samples.size());
+    current->samples.push_back({ zone, query, UINT32_MAX });
+    return scope;
+}
+
+void GpuProfiler::resolve(Frame& frame) {
+    // Fence of the frame was signaled, so the results are available without waiting
+    auto result = vkGetQueryPoolResults(logicalDevice, frame.queryPool, 0, frame.used, frame.used * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    resolved.clear();
+
+    for (const auto& sample : frame.samples) {
+        if (sample.end == UINT32_MAX)
+            continue;
+
+        uint64_t ticks = (timestamps[sample.end] - timestamps[sample.begin]) & timestampMask;
+        float duration = static_cast<float>(static_cast<double>(ticks) * timestampPeriod / 1000000.0);
+
+        auto& zone = zones[sample.zone];
+        zone.sum += duration - zone.history[zone.head];
+        zone.history[zone.head] = duration;
+        zone.head = (zone.head + 1) % HistorySize;
+        zone.count = std::min(zone.count + 1, HistorySize);
+
+        resolved.push_back({ zone.name, zone.depth, duration, zone.sum / static_cast<float>(zone.count) });
+    }
+}
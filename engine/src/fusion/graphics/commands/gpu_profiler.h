@@ -0,0 +1,124 @@
+#pragma once
+
+#include <mutex>
+
+namespace fe {
+    class PhysicalDevice;
+    class LogicalDevice;
+    class CommandBuffer;
+    /**
+     * @brief Measures the device time of render stages, subpasses and subrenders with timestamp queries.
+     * Every frame in flight writes into its own query pool, the results are read back when the frame slot is reused,
+     * at that point the fence of the frame was already waited on, so the host never stalls on the queries.
+     */
+    class FUSION_API GpuProfiler {
+    public:
+        /**
+         * @brief Timing of a measured scope in the last resolved frame.
+         */
+        struct Zone {
+            std::string name;
+            uint32_t depth{ 0 }; /// Nesting level, render stages are at zero.
+            float last{ 0.0f }; /// Duration in the last resolved frame, in milliseconds.
+            float average{ 0.0f }; /// Rolling average over the last frames, in milliseconds.
+        };
+
+        /**
+         * Creates a new profiler.
+         * @param physicalDevice The physical device.
+         * @param logicalDevice The logical device.
+         * @param frames The number of frames in flight.
+         * @param capacity The number of timestamps a frame can write.
+         */
+        GpuProfiler(const PhysicalDevice& physicalDevice, const LogicalDevice& logicalDevice, uint32_t frames, uint32_t capacity);
+        ~GpuProfiler();
+        NONCOPYABLE(GpuProfiler);
+
+        /**
+         * Resolves the timestamps the frame slot wrote last time and resets its queries, must be called outside of a render pass
+         * after the fence of the frame was signaled.
+         * @param commandBuffer The primary command buffer of the frame.
+         * @param frame The frame in flight index.
+         */
+        void beginFrame(const CommandBuffer& commandBuffer, size_t frame);
+
+        /**
+         * Opens a scope by writing a timestamp.
+         * @param commandBuffer The command buffer to write the timestamp into.
+         * @param key The unique key of the scope, timings of the same key are averaged together.
+         * @param depth The nesting level of the scope.
+         * @param getName The function which returns the display name, it is only called the first time the key is seen.
+         * @return The scope handle which is passed to end, or UINT32_MAX if nothing was written.
+         */
+        template<typename F>
+        uint32_t begin(const CommandBuffer& commandBuffer, uint64_t key, uint32_t depth, const F& getName) {
+            if (!isActive())
+                return UINT32_MAX;
+            auto it = zoneIndices.find(key);
+            return beginZone(commandBuffer, it != zoneIndices.end() ? it->second : addZone(key, depth, getName()));
+        }
+
+        /**
+         * Closes a scope by writing a timestamp.
+         * @param commandBuffer The command buffer to write the timestamp into, it has to execute after the one the scope was opened in.
+         * @param scope The scope handle returned by begin.
+         */
+        void end(const CommandBuffer& commandBuffer, uint32_t scope);
+
+        /**
+         * Gets the scopes of the last resolved frame in the order they were opened.
+         * @return The copy of the zones, it can be called from any thread.
+         */
+        std::vector<Zone> getZones() const;
+
+        bool isSupported() const { return timestampPeriod > 0.0f; }
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool flag) { enabled = flag; }
+
+    private:
+        static constexpr size_t HistorySize = 64;
+
+        struct ZoneData {
+            std::string name;
+            uint32_t depth;
+            std::array<float, HistorySize> history{};
+            size_t head{ 0 };
+            size_t count{ 0 };
+            float sum{ 0.0f };
+        };
+
+        struct Sample {
+            uint32_t zone;
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct Frame {
+            VkQueryPool queryPool{ VK_NULL_HANDLE };
+            uint32_t used{ 0 };
+            std::vector<Sample> samples;
+        };
+
+        bool isActive() const { return enabled && current != nullptr; }
+
+        uint32_t addZone(uint64_t key, uint32_t depth, std::string&& name);
+        uint32_t beginZone(const CommandBuffer& commandBuffer, uint32_t zone);
+        void resolve(Frame& frame);
+
+        VkDevice logicalDevice;
+        uint32_t capacity;
+        float timestampPeriod{ 0.0f }; /// Nanoseconds per timestamp tick.
+        uint64_t timestampMask{ 0 };
+        std::atomic<bool> enabled{ true }; /// Toggled from the interface while frames are recorded.
+
+        std::vector<Frame> frames;
+        Frame* current{ nullptr }; /// Frame that is currently recorded.
+        std::vector<uint64_t> timestamps;
+
+        std::vector<ZoneData> zones;
+        fst::unordered_flatmap<uint64_t, uint32_t> zoneIndices;
+
+        std::vector<Zone> resolved;
+        mutable std::mutex mutex;
+    };
+}
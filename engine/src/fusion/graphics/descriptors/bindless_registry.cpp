@@ -0,0 +1,83 @@
+#include "bindless_registry.h"
+
+#include "fusion/graphics/graphics.h"
+#include "fusion/graphics/textures/texture.h"
+
+using namespace fe;
+
+BindlessRegistry::BindlessRegistry(uint32_t capacity) : capacity{capacity} {
+    table.descriptors.reserve(capacity);
+    used.reserve(capacity);
+}
+
+int32_t BindlessRegistry::acquire(const Texture* texture) {
+    int32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else if (used.size() < capacity) {
+        slot = static_cast<int32_t>(used.size());
+        used.push_back(false);
+    } else {
+        FE_LOG_ERROR("Bindless registry is full: capacity = {}", capacity);
+        return -1;
+    }
+
+    if (table.descriptors.size() < used.size())
+        table.descriptors.resize(used.size());
+
+    used[slot] = true;
+    table.descriptors[slot] = texture;
+    ++count;
+
+    fillHoles();
+    ++table.version;
+    return slot;
+}
+
+void BindlessRegistry::release(int32_t slot) {
+    if (slot < 0 || slot >= static_cast<int32_t>(used.size()) || !used[slot])
+        return;
+
+    used[slot] = false;
+    --count;
+
+    // Slot could be still sampled by the frames in flight, so it is not reused right away
+    retiredSlots.emplace_back(slot, frameNumber);
+
+    fillHoles();
+    ++table.version;
+}
+
+void BindlessRegistry::onUpdate() {
+    ++frameNumber;
+
+    while (!retiredSlots.empty() && retiredSlots.front().second + MAX_FRAMES_IN_FLIGHT < frameNumber) {
+        freeSlots.push_back(retiredSlots.front().first);
+        retiredSlots.pop_front();
+    }
+}
+
+void BindlessRegistry::fillHoles() {
+    // Partially bound arrays still require valid writes, so free slots reference any live texture
+    const Descriptor* fallback = nullptr;
+    for (size_t i = 0; i < used.size(); ++i) {
+        if (used[i]) {
+            fallback = table.descriptors[i];
+            break;
+        }
+    }
+
+    if (!fallback) {
+        table.descriptors.clear();
+        return;
+    }
+
+    if (table.descriptors.size() < used.size())
+        table.descriptors.resize(used.size());
+
+    for (size_t i = 0; i < used.size(); ++i) {
+        if (!used[i])
+            table.descriptors[i] = fallback;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+namespace fe {
+    class Descriptor;
+    class Texture;
+
+    /**
+     * @brief Descriptors of the bindless slots with the version they were changed at.
+     */
+    struct BindlessTable {
+        std::vector<const Descriptor*> descriptors;
+        uint64_t version{ 0 };
+    };
+
+    /**
+     * @brief Global table of textures used by bindless descriptor arrays. Slots stay the same while the texture lives,
+     * freed slots are reused only after every frame in flight that could still sample them has finished.
+     * @note Accessed from the main thread only, the render thread reads the copy of the table in the {@link RenderSnapshot}.
+     */
+    class FUSION_API BindlessRegistry {
+    public:
+        explicit BindlessRegistry(uint32_t capacity);
+        ~BindlessRegistry() = default;
+        NONCOPYABLE(BindlessRegistry);
+
+        /**
+         * Assigns a slot to the texture.
+         * @param texture The texture to register.
+         * @return The slot index or -1 if the table is full.
+         */
+        int32_t acquire(const Texture* texture);
+
+        /**
+         * Removes the texture from the slot, the slot becomes reusable after the frames in flight.
+         * @param slot The slot to free.
+         */
+        void release(int32_t slot);
+
+        /**
+         * Advances the frame counter and moves retired slots back to the free list.
+         */
+        void onUpdate();
+
+        /**
+         * Gets the descriptors of all slots, free slots point to any live texture so the array can be written in one go.
+         * @return The descriptor array.
+         */
+        const std::vector<const Descriptor*>& getDescriptors() const { return table.descriptors; }
+
+        /**
+         * Gets the version of the table, it is changed every time the content of a slot is changed.
+         * @return The table version.
+         */
+        uint64_t getVersion() const { return table.version; }
+
+        const BindlessTable& getTable() const { return table; }
+
+        uint32_t getCapacity() const { return capacity; }
+        uint32_t getCount() const { return count; }
+
+    private:
+        void fillHoles();
+
+        BindlessTable table;
+        std::vector<bool> used;
+        std::vector<int32_t> freeSlots;
+        std::deque<std::pair<int32_t, uint64_t>> retiredSlots; /// Slots with the frame they were released on.
+        uint32_t capacity;
+        uint32_t count{ 0 };
+        uint64_t frameNumber{ 0 };
+    };
+}
@@ -9,10 +9,10 @@ static const std::vector<std::pair<VkDescriptorType, float>> DESCRIPTOR_SIZES =
         { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f },
         { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1.0f },
         { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 1.0f },
-        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
-        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f },
-        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
-        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2.0f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 2.0f },
         { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 0.5f }
 };
 
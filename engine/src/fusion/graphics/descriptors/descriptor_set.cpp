@@ -27,6 +27,6 @@ void DescriptorSet::updateDescriptor(gsl::span<const VkWriteDescriptorSet> descr
 	vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
 }
 
-void DescriptorSet::bindDescriptor(const CommandBuffer& commandBuffer, const Pipeline& pipeline) const {
-    vkCmdBindDescriptorSets(commandBuffer, pipeline.getPipelineBindPoint(), pipeline.getPipelineLayout(), 0, 1, &descriptorSet, 0, nullptr);
+void DescriptorSet::bindDescriptor(const CommandBuffer& commandBuffer, const Pipeline& pipeline, gsl::span<const uint32_t> dynamicOffsets) const {
+    vkCmdBindDescriptorSets(commandBuffer, pipeline.getPipelineBindPoint(), pipeline.getPipelineLayout(), 0, 1, &descriptorSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
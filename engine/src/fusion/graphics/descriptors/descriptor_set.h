@@ -9,7 +9,7 @@ namespace fe {
         ~DescriptorSet();
 
         static void updateDescriptor(gsl::span<const VkWriteDescriptorSet> descriptorWrites);
-        void bindDescriptor(const CommandBuffer& commandBuffer, const Pipeline& pipeline) const;
+        void bindDescriptor(const CommandBuffer& commandBuffer, const Pipeline& pipeline, gsl::span<const uint32_t> dynamicOffsets = {}) const;
 
         operator bool() const { return descriptorSet != VK_NULL_HANDLE; }
         operator const VkDescriptorSet&() const { return descriptorSet; }
@@ -1,6 +1,8 @@
 #include "descriptors_handler.h"
 
 #include "fusion/graphics/graphics.h"
+#include "fusion/core/frame_timings.h"
+#include "fusion/core/perf_counters.h"
 #include "fusion/graphics/buffers/uniform_handler.h"
 #include "fusion/graphics/buffers/storage_handler.h"
 #include "fusion/graphics/buffers/push_handler.h"
@@ -12,34 +14,112 @@ DescriptorsHandler::DescriptorsHandler(const Pipeline& pipeline)
         : shader{&pipeline.getShader()}
         , descriptorSet{std::make_unique<DescriptorSet>(pipeline)}
         , changed{true} {
+    resetDescriptors();
 }
 
 void DescriptorsHandler::push(const std::string& descriptorName, UniformHandler& uniformHandler, const std::optional<OffsetSize>& offsetSize) {
 	if (shader) {
-		uniformHandler.update(shader->getUniformBlock(descriptorName));
-		push(descriptorName, uniformHandler.getUniformBuffer(), offsetSize);
+		push(findHandle(descriptorName), uniformHandler, offsetSize);
 	}
 }
 
 void DescriptorsHandler::push(const std::string& descriptorName, StorageHandler& storageHandler, const std::optional<OffsetSize>& offsetSize) {
 	if (shader) {
-		storageHandler.update(shader->getUniformBlock(descriptorName));
-		push(descriptorName, storageHandler.getStorageBuffer(), offsetSize);
+		push(findHandle(descriptorName), storageHandler, offsetSize);
 	}
 }
 
 void DescriptorsHandler::push(const std::string& descriptorName, PushHandler& pushHandler, const std::optional<OffsetSize>& offsetSize) {
 	if (shader) {
-		pushHandler.update(shader->getUniformBlock(descriptorName));
+		push(findHandle(descriptorName), pushHandler);
 	}
 }
 
+void DescriptorsHandler::push(const std::string& descriptorName, const FrameAllocator& frameAllocator, const FrameAllocator::Allocation& allocation) {
+    if (shader) {
+        push(findHandle(descriptorName), frameAllocator, allocation);
+    }
+}
+
+void DescriptorsHandler::push(const Shader::DescriptorHandle& handle, UniformHandler& uniformHandler, const std::optional<OffsetSize>& offsetSize) {
+    if (shader && handle.uniformBlock) {
+        uniformHandler.update(handle.uniformBlock);
+        push(handle, uniformHandler.getUniformBuffer(), offsetSize);
+    }
+}
+
+void DescriptorsHandler::push(const Shader::DescriptorHandle& handle, StorageHandler& storageHandler, const std::optional<OffsetSize>& offsetSize) {
+    if (shader && handle.uniformBlock) {
+        storageHandler.update(handle.uniformBlock);
+        push(handle, storageHandler.getStorageBuffer(), offsetSize);
+    }
+}
+
+void DescriptorsHandler::push(const Shader::DescriptorHandle& handle, PushHandler& pushHandler) {
+    if (shader && handle.uniformBlock) {
+        pushHandler.update(handle.uniformBlock);
+    }
+}
+
+void DescriptorsHandler::push(const Shader::DescriptorHandle& handle, const FrameAllocator& frameAllocator, const FrameAllocator::Allocation& allocation) {
+    if (!shader || !allocation)
+        return;
+
+    if (auto it = dynamicOffsets.find(handle.binding); it != dynamicOffsets.end()) {
+        it->second = allocation.offset;
+        push(handle, &frameAllocator, OffsetSize{0, allocation.size});
+    } else {
+        // Push descriptors and buffers over the dynamic limit of the device fall back to a descriptor write per slice
+        push(handle, &frameAllocator, OffsetSize{allocation.offset, allocation.size});
+    }
+}
+
+void DescriptorsHandler::push(const Shader::DescriptorHandle& handle, const BindlessTable& bindlessTable) {
+    if (!shader || handle.binding >= descriptors.size())
+        return;
+
+    // Slots are stable, so the array is untouched while no texture is added or removed
+    auto& value = descriptors[handle.binding];
+    if (value && value->version == bindlessTable.version)
+        return;
+
+    const auto& values = bindlessTable.descriptors;
+    if (values.empty()) {
+        if (value) {
+            value.reset();
+            changed = true;
+        }
+        return;
+    }
+
+    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    descriptorWrite.dstSet = VK_NULL_HANDLE; // Will be set in the descriptor handler.
+    descriptorWrite.dstBinding = handle.binding;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = handle.type;
+
+    value = DescriptorValue{values, WriteDescriptorSet{descriptorWrite, values}, std::nullopt, bindlessTable.version};
+    changed = true;
+}
+
+Shader::DescriptorHandle DescriptorsHandler::findHandle(const std::string& descriptorName) const {
+    auto handle = shader->getDescriptorHandle(descriptorName);
+#if FUSION_DEBUG
+    if (!handle && shader->reportedNotFound(descriptorName, true)) {
+        FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}'", shader->getName(), descriptorName);
+    }
+#endif
+    return handle;
+}
+
 bool DescriptorsHandler::update(const Pipeline& pipeline) {
+    ScopedFrameTiming timing{FrameTimings::Phase::Descriptors};
+
     auto currentShader = &pipeline.getShader();
 	if (shader != currentShader) {
 		shader = currentShader;
-		descriptors.clear();
 		writeDescriptorSets.clear();
+		resetDescriptors();
 
 		if (!pipeline.isPushDescriptors())
 			descriptorSet = std::make_unique<DescriptorSet>(pipeline);
@@ -52,8 +132,11 @@ bool DescriptorsHandler::update(const Pipeline& pipeline) {
 		writeDescriptorSets.clear();
 		writeDescriptorSets.reserve(descriptors.size());
 
-		for (const auto& [descriptorName, descriptor] : descriptors) {
-            auto writeDescriptorSet = descriptor.writeDescriptor.getWriteDescriptorSet();
+		for (const auto& descriptor : descriptors) {
+            if (!descriptor)
+                continue;
+
+            auto writeDescriptorSet = descriptor->writeDescriptor.getWriteDescriptorSet();
             if (writeDescriptorSet.descriptorCount == 0)
                 continue;
 
@@ -68,6 +151,8 @@ bool DescriptorsHandler::update(const Pipeline& pipeline) {
 		if (!pipeline.isPushDescriptors())
 			descriptorSet->updateDescriptor(writeDescriptorSets);
 
+        PerfCounters::Add(PerfCounters::Counter::DescriptorWrites, static_cast<int64_t>(writeDescriptorSets.size()));
+
 		changed = false;
 	}
 
@@ -79,6 +164,23 @@ void DescriptorsHandler::bindDescriptor(const CommandBuffer& commandBuffer, cons
         const auto& logicalDevice = Graphics::Get()->getLogicalDevice();
         Instance::FvkCmdPushDescriptorSetKHR(logicalDevice, commandBuffer, pipeline.getPipelineBindPoint(), pipeline.getPipelineLayout(), 0, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data());
 	} else {
-        descriptorSet->bindDescriptor(commandBuffer, pipeline);
+        descriptorSet->bindDescriptor(commandBuffer, pipeline, dynamicOffsets.values());
+    }
+}
+
+void DescriptorsHandler::resetDescriptors() {
+    descriptors.clear();
+    dynamicOffsets.clear();
+
+    if (!shader)
+        return;
+
+    for (const auto& layout : shader->getDescriptorSetLayouts()) {
+        if (layout.binding >= descriptors.size())
+            descriptors.resize(layout.binding + 1);
+
+        // Buffers which are not pushed from the frame allocator are bound from their start
+        if (layout.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || layout.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+            dynamicOffsets.emplace(layout.binding, 0);
     }
 }
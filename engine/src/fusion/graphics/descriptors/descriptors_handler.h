@@ -3,6 +3,8 @@
 #include "fusion/graphics/descriptors/descriptor.h"
 #include "fusion/graphics/descriptors/descriptor_set.h"
 #include "fusion/graphics/pipelines/shader.h"
+#include "fusion/graphics/buffers/frame_allocator.h"
+#include "fusion/graphics/descriptors/bindless_registry.h"
 
 namespace fe {
     class Image;
@@ -22,43 +24,31 @@ namespace fe {
             if (!shader)
                 return;
 
-            // Finds the local value given to the descriptor name
-            if (auto it = descriptors.find(descriptorName); it != descriptors.end()) {
-                // If the descriptor and size have not changed then the write is not modified
-                if (it->second.descriptors.front() == descriptor && it->second.offsetSize == offsetSize) {
-                    return;
-                }
-                descriptors.erase(it);
-            }
+            push(findHandle(descriptorName), descriptor, offsetSize);
+        }
 
-            // Only non-null descriptors can be mapped
-            if (!descriptor)
+        template<typename T, typename = std::enable_if_t<std::is_convertible_v<T*, Descriptor*>>>
+        void push(const Shader::DescriptorHandle& handle, const T* descriptor, const std::optional<OffsetSize>& offsetSize = std::nullopt) {
+            if (!shader || handle.binding >= descriptors.size())
                 return;
 
-            // When adding the descriptor find the location in the shader
-            auto location = shader->getDescriptorLocation(descriptorName);
-            if (!location) {
-    #if FUSION_DEBUG
-                if (shader->reportedNotFound(descriptorName, true)) {
-                    FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}'", shader->getName(), descriptorName);
+            // If the descriptor and size have not changed then the write is not modified
+            auto& value = descriptors[handle.binding];
+            if (value) {
+                if (value->descriptors.size() == 1 && value->descriptors.front() == descriptor && value->offsetSize == offsetSize) {
+                    return;
                 }
-    #endif
-                return;
+                value.reset();
+                changed = true;
             }
 
-            auto descriptorType = shader->getDescriptorType(*location);
-            if (!descriptorType) {
-    #if FUSION_DEBUG
-                if (shader->reportedNotFound(descriptorName, true)) {
-                    FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}' at location: {}", shader->getName(), descriptorName, *location);
-                }
-    #endif
+            // Only non-null descriptors can be mapped
+            if (!descriptor)
                 return;
-            }
 
             // Adds the new descriptor value
-            auto writeDescriptor = descriptor->getWriteDescriptor(*location, *descriptorType, offsetSize);
-            descriptors.emplace(descriptorName, DescriptorValue{std::vector{reinterpret_cast<const Descriptor*>(descriptor)}, std::move(writeDescriptor), offsetSize, *location});
+            auto writeDescriptor = descriptor->getWriteDescriptor(handle.binding, handle.type, offsetSize);
+            value = DescriptorValue{std::vector{reinterpret_cast<const Descriptor*>(descriptor)}, std::move(writeDescriptor), offsetSize};
             changed = true;
         }
 
@@ -67,50 +57,38 @@ namespace fe {
             if (!shader)
                 return;
 
-            // Finds the local value given to the descriptor name
-            if (auto it = descriptors.find(descriptorName); it != descriptors.end()) {
-                // If the descriptor and size have not changed then the write is not modified
-                if (it->second.descriptors.size() == descriptor.size() && it->second.descriptors == descriptor) {
+            push(findHandle(descriptorName), descriptor);
+        }
+
+        template<typename T, typename = std::enable_if_t<std::is_convertible_v<T*, Descriptor*>>>
+        void push(const Shader::DescriptorHandle& handle, const std::vector<const T*>& descriptor) {
+            if (!shader || handle.binding >= descriptors.size())
+                return;
+
+            // If the descriptor and size have not changed then the write is not modified
+            auto& value = descriptors[handle.binding];
+            if (value) {
+                if (value->descriptors.size() == descriptor.size() && std::equal(descriptor.begin(), descriptor.end(), value->descriptors.begin())) {
                     return;
                 }
-                descriptors.erase(it);
+                value.reset();
+                changed = true;
             }
 
             // Only non-null descriptors can be mapped
             if (descriptor.empty()/* || std::any_of(descriptor.begin(), descriptor.end(), [](const T* d) { return d == nullptr; })*/)
                 return;
 
-            // When adding the descriptor find the location in the shader
-            auto location = shader->getDescriptorLocation(descriptorName);
-            if (!location) {
-#if FUSION_DEBUG
-                if (shader->reportedNotFound(descriptorName, true)) {
-                    FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}'", shader->getName(), descriptorName);
-                }
-#endif
-                return;
-            }
-
-            auto descriptorType = shader->getDescriptorType(*location);
-            if (!descriptorType) {
-#if FUSION_DEBUG
-                if (shader->reportedNotFound(descriptorName, true)) {
-                    FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}' at location: {}", shader->getName(), descriptorName, *location);
-                }
-#endif
-                return;
-            }
+            std::vector<const Descriptor*> values{ descriptor.begin(), descriptor.end() };
 
-            //auto writeDescriptor = descriptor->getWriteDescriptor(*location, *descriptorType, offsetSize);
             VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
             descriptorWrite.dstSet = VK_NULL_HANDLE; // Will be set in the descriptor handler.
-            descriptorWrite.dstBinding = *location;
+            descriptorWrite.dstBinding = handle.binding;
             descriptorWrite.dstArrayElement = 0;
-            //descriptorWrite.descriptorCount = 1;
-            descriptorWrite.descriptorType = *descriptorType;
-            //descriptorWrite.pImageInfo = &imageInfo;
+            descriptorWrite.descriptorType = handle.type;
 
-            descriptors.emplace(descriptorName, DescriptorValue{descriptor, WriteDescriptorSet{descriptorWrite, descriptor}, std::nullopt, *location});
+            WriteDescriptorSet writeDescriptor{descriptorWrite, values};
+            value = DescriptorValue{std::move(values), std::move(writeDescriptor), std::nullopt};
             changed = true;
         }
 
@@ -119,17 +97,11 @@ namespace fe {
             if (!shader)
                 return;
 
-            auto location = shader->getDescriptorLocation(descriptorName);
-            if (!location) {
-#if FUSION_DEBUG
-                if (shader->reportedNotFound(descriptorName, true)) {
-                    FE_LOG_ERROR("Could not find descriptor in shader '{}' of name '{}'", shader->getName(), descriptorName);
-                }
-#endif
+            auto handle = findHandle(descriptorName);
+            if (handle.binding >= descriptors.size())
                 return;
-            }
 
-            descriptors[descriptorName] = DescriptorValue{std::vector{reinterpret_cast<const Descriptor*>(descriptor)}, std::move(writeDescriptorSet), std::nullopt, *location};
+            descriptors[handle.binding] = DescriptorValue{std::vector{reinterpret_cast<const Descriptor*>(descriptor)}, std::move(writeDescriptorSet), std::nullopt};
             changed = true;
         }
 
@@ -137,6 +109,30 @@ namespace fe {
         void push(const std::string& descriptorName, StorageHandler& storageHandler, const std::optional<OffsetSize>& offsetSize = std::nullopt);
         void push(const std::string& descriptorName, PushHandler& pushHandler, const std::optional<OffsetSize>& offsetSize = std::nullopt);
 
+        /**
+         * Binds a slice of the frame allocator. On dynamic buffers only the dynamic offset is changed,
+         * so the descriptor set is written once and stays untouched while the slice size is the same.
+         * @param descriptorName The name of the uniform or storage block.
+         * @param frameAllocator The allocator that owns the slice.
+         * @param allocation The slice to bind.
+         */
+        void push(const std::string& descriptorName, const FrameAllocator& frameAllocator, const FrameAllocator::Allocation& allocation);
+
+        /**
+         * Fast path of the named pushes, handles are resolved once from the pipeline shader with Shader::getDescriptorHandle.
+         */
+        void push(const Shader::DescriptorHandle& handle, UniformHandler& uniformHandler, const std::optional<OffsetSize>& offsetSize = std::nullopt);
+        void push(const Shader::DescriptorHandle& handle, StorageHandler& storageHandler, const std::optional<OffsetSize>& offsetSize = std::nullopt);
+        void push(const Shader::DescriptorHandle& handle, PushHandler& pushHandler);
+        void push(const Shader::DescriptorHandle& handle, const FrameAllocator& frameAllocator, const FrameAllocator::Allocation& allocation);
+
+        /**
+         * Binds the global texture table to a bindless array, the array is only rewritten when the table version changes.
+         * @param handle The handle of the sampler array.
+         * @param bindlessTable The texture table, subrenders pass the copy of the {@link RenderSnapshot}.
+         */
+        void push(const Shader::DescriptorHandle& handle, const BindlessTable& bindlessTable);
+
         bool update(const Pipeline& pipeline);
 
         void bindDescriptor(const CommandBuffer& commandBuffer, const Pipeline &pipeline);
@@ -148,13 +144,17 @@ namespace fe {
             std::vector<const Descriptor*> descriptors;
             WriteDescriptorSet writeDescriptor;
             std::optional<OffsetSize> offsetSize;
-            uint32_t location;
+            uint64_t version{ 0 }; /// Version of the bindless table that was written.
         };
 
+        Shader::DescriptorHandle findHandle(const std::string& descriptorName) const;
+        void resetDescriptors();
+
         const Shader* shader{ nullptr };
         std::unique_ptr<DescriptorSet> descriptorSet;
-        fst::unordered_flatmap<std::string, DescriptorValue> descriptors;
+        std::vector<std::optional<DescriptorValue>> descriptors; /// Descriptor values by binding.
         std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+        fst::split_flatmap<uint32_t, uint32_t> dynamicOffsets; /// Dynamic offsets by binding, ordered as required by vkCmdBindDescriptorSets.
         bool changed{ false };
     };
 }
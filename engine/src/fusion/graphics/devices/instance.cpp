@@ -147,8 +147,10 @@ bool Instance::CheckValidationLayerSupport() {
 }
 
 std::vector<const char*> Instance::getExtensions() const {
-	// Sets up the extensions.
-	auto extensions = DeviceManager::Get()->getRequiredInstanceExtensions();
+	// Sets up the extensions, headless rendering has no surfaces and does not need the window system ones.
+	std::vector<const char*> extensions;
+	if (!Engine::Get()->getCommandLineParser().isSet("headless"))
+		extensions = DeviceManager::Get()->getRequiredInstanceExtensions();
 
 	if (enableValidationLayers)
 		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
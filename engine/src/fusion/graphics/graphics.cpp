@@ -11,9 +11,18 @@
 #include "fusion/graphics/render_stage.h"
 #include "fusion/graphics/renderer.h"
 #include "fusion/graphics/subrender.h"
+#include "fusion/graphics/render_snapshot.h"
+#include "fusion/scene/scene_manager.h"
+#include "fusion/assets/asset_registry.h"
+#include "fusion/core/thread_pool.h"
+#include "fusion/core/engine.h"
+#include "fusion/core/frame_timings.h"
+#include "fusion/core/perf_counters.h"
 
 #include <glslang/Public/ShaderLang.h>
 
+#include <numeric>
+
 #if FUSION_PROFILE && TRACY_ENABLE
 #include <tracy/TracyVulkan.hpp>
 #endif
@@ -22,9 +31,32 @@ using namespace fe;
 
 Graphics* Graphics::Instance = nullptr;
 
-Graphics::Graphics() : elapsedPurge{5s} {
+/**
+ * Packs the position of a measured scope into a profiler key.
+ * @param stage The render stage index.
+ * @param subpass The subpass binding, or UINT16_MAX for the whole stage.
+ * @param subrender The position of the subrender in the subpass, or UINT32_MAX for the whole subpass.
+ * @return The key.
+ */
+static uint64_t GetProfilerKey(uint32_t stage, uint32_t subpass = UINT16_MAX, uint32_t subrender = UINT32_MAX) {
+    return (uint64_t{stage} << 48) | (uint64_t{subpass & UINT16_MAX} << 32) | subrender;
+}
+
+Graphics::Graphics() : elapsedPurge{5s}, snapshot{std::make_unique<RenderSnapshot>()} {
     Instance = this;
 
+    const auto& commandLineParser = Engine::Get()->getCommandLineParser();
+    threadedRendering = commandLineParser.isSet("renderthread");
+    headless = commandLineParser.isSet("headless");
+    frameLimit = static_cast<uint32_t>(commandLineParser.getValue<int>("benchmarkframes", 0));
+    if (headless) {
+        headlessExtent.width = static_cast<uint32_t>(commandLineParser.getValue<int>("width", static_cast<int>(headlessExtent.width)));
+        headlessExtent.height = static_cast<uint32_t>(commandLineParser.getValue<int>("height", static_cast<int>(headlessExtent.height)));
+        dumpPath = commandLineParser.getValue<std::string>("dumpframes", "");
+        if (!dumpPath.empty())
+            fs::create_directories(dumpPath);
+    }
+
     /*for (auto& window : DeviceManager::Get()->getWindows()) {
         onWindowCreate(window.get(), true);
     }*/
@@ -35,6 +67,16 @@ Graphics::Graphics() : elapsedPurge{5s} {
 }
 
 Graphics::~Graphics() {
+    waitRenderThread();
+    if (renderThread.joinable()) {
+        {
+            std::unique_lock<std::mutex> lock(renderMutex);
+            renderStopping = true;
+        }
+        renderCondition.notify_all();
+        renderThread.join();
+    }
+
     Instance = nullptr;
 
     auto graphicsQueue = logicalDevice.getGraphicsQueue();
@@ -54,14 +96,35 @@ Graphics::~Graphics() {
 }
 
 void Graphics::onStop() {
+    waitRenderThread();
+
+    std::unique_lock<std::mutex> lock(queueMutex);
     VK_CHECK(vkDeviceWaitIdle(logicalDevice));
+
+    renderGraph.clear();
+
+    std::deque<std::pair<uint64_t, std::shared_ptr<void>>> expired;
+    {
+        std::unique_lock<std::mutex> retiredLock(retiredMutex);
+        expired.swap(retired);
+    }
 }
 
 void Graphics::onStart() {
 }
 
 void Graphics::onUpdate() {
-    if (!renderer || DeviceManager::Get()->getWindow(0)->isIconified())
+    // The previous frame is recorded until here, so the renderer and the snapshot can be touched after
+    waitRenderThread();
+
+    // Assets are only evicted while no frame is recorded, the snapshot points to them
+    if (auto assetRegistry = AssetRegistry::Get())
+        assetRegistry->updateMemory();
+
+    if (!renderer)
+        return;
+
+    if (auto window = DeviceManager::Get()->getWindow(0); window && window->isIconified())
         return;
 
     if (!renderer->started) {
@@ -70,9 +133,88 @@ void Graphics::onUpdate() {
         renderer->started = true;
     }
 
+    ++updateCount;
+
+    // Every surface has waited for the frame which was recorded this many updates ago
+    std::vector<std::shared_ptr<void>> expired;
+    {
+        std::unique_lock<std::mutex> lock(retiredMutex);
+        while (!retired.empty() && updateCount - retired.front().first > MAX_FRAMES_IN_FLIGHT) {
+            expired.push_back(std::move(retired.front().second));
+            retired.pop_front();
+        }
+    }
+    // Destroyed outside of the lock, destructors can retire other objects
+    expired.clear();
+
+    bindlessRegistry.onUpdate();
+
     renderer->onUpdate();
     renderer->subrenderHolder.updateAll();
 
+    if (renderGraph.getOrder().size() != renderer->renderStages.size())
+        renderGraph.compile(renderer->renderStages);
+    if (renderGraph.update())
+        recreateAttachmentsMap();
+
+    // Everything the recording reads from the main thread state is copied here
+    for (auto& renderStage : renderer->renderStages) {
+        renderStage->frameViewport = renderStage->viewport;
+    }
+    snapshot->extract(SceneManager::Get()->getScene(), renderer->renderStages);
+
+    bool threadSafe = std::all_of(renderer->subrenderHolder.subrenders.begin(), renderer->subrenderHolder.subrenders.end(), [](const auto& pair) {
+        return std::all_of(pair.second.begin(), pair.second.end(), [](const auto& subrender) {
+            return !subrender->isEnabled() || subrender->isThreadSafe();
+        });
+    });
+
+    if (!threadedRendering || !threadSafe) {
+        renderFrame();
+    } else {
+        if (!renderThread.joinable())
+            renderThread = std::thread(&Graphics::onRenderThread, this);
+
+        {
+            std::unique_lock<std::mutex> lock(renderMutex);
+            renderPending = true;
+        }
+        renderCondition.notify_all();
+    }
+
+    if (frameLimit != 0)
+        updateFrameLimit();
+}
+
+void Graphics::updateFrameLimit() {
+    auto now = DateTime::Now();
+    if (frameCount++ != 0)
+        frameTimes.push_back((now - lastFrameTime).asMilliseconds<float>());
+    lastFrameTime = now;
+
+    if (frameCount < frameLimit)
+        return;
+
+    // Last frame is finished before the total time is taken
+    waitRenderThread();
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        VK_CHECK(vkDeviceWaitIdle(logicalDevice));
+    }
+    frameTimes.push_back((DateTime::Now() - lastFrameTime).asMilliseconds<float>());
+
+    auto [minTime, maxTime] = std::minmax_element(frameTimes.begin(), frameTimes.end());
+    float totalTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0f);
+    float averageTime = totalTime / static_cast<float>(frameTimes.size());
+
+    FE_LOG_INFO("Rendered {} frames in {}ms: average {}ms ({} fps), min {}ms, max {}ms", frameCount, totalTime, averageTime, 1000.0f / averageTime, *minTime, *maxTime);
+
+    Engine::Get()->requestClose();
+}
+
+void Graphics::renderFrame() {
+    FUSION_PROFILE_FUNCTION();
+
     for (const auto& [id, swapchain] : enumerate(swapchains)) {
         auto& perSurfaceBuffer = perSurfaceBuffers[id];
         auto& currentFrame = perSurfaceBuffer->currentFrame;
@@ -86,23 +228,66 @@ void Graphics::onUpdate() {
         if (!beginFrame(info))
             continue;
 
-        Pipeline::Stage stage;
+        // Draws were dropped in the last frame, frames in flight keep the old allocator until they finished
+        auto& surfaceAllocator = perSurfaceBuffer->frameAllocator;
+        if (surfaceAllocator->hasOverflowed()) {
+            auto capacity = std::max(surfaceAllocator->getCapacity() * 2, surfaceAllocator->getRequired());
+            FE_LOG_WARNING("Frame allocator of surface {} grows from {} to {} bytes", id, surfaceAllocator->getCapacity(), capacity);
+            retire(std::move(surfaceAllocator));
+            surfaceAllocator = std::make_unique<FrameAllocator>(capacity, MAX_FRAMES_IN_FLIGHT);
+        }
 
-        for (auto& renderStage : renderer->renderStages) {
-            renderStage->update(id, *swapchain);
+        // Fence of this frame was waited on acquire, so the region can be reused
+        frameAllocator = surfaceAllocator.get();
+        frameAllocator->reset(currentFrame);
 
-            if (beginRenderpass(info, *renderStage)) {
-                nextSubpasses(info, *renderStage, stage);
-                endRenderpass(info);
+        recordingSurface = perSurfaceBuffer.get();
+        for (auto& [threadId, secondaryBuffers] : perSurfaceBuffer->secondaryBuffers) {
+            secondaryBuffers[currentFrame].used = 0;
+        }
+
+        {
+            ScopedFrameTiming timing{FrameTimings::Phase::Recording};
+
+            Pipeline::Stage stage;
+            auto& gpuProfiler = *perSurfaceBuffer->gpuProfiler;
+            auto& primary = perSurfaceBuffer->commandBuffers[currentFrame];
+
+            for (auto index : renderGraph.getOrder()) {
+                if (!renderGraph.isLive(index))
+                    continue;
+
+                auto& renderStage = renderer->renderStages[index];
+                renderStage->update(id, *swapchain);
+                stage.first = index;
+
+                // Primary can not write timestamps inside of a pass made of secondary buffers, so the stage is measured around it
+                auto stageScope = gpuProfiler.begin(primary, GetProfilerKey(index), 0, [index] { return fmt::format("Render Stage {}", index); });
+
+                if (beginRenderpass(info, *renderStage)) {
+                    nextSubpasses(info, *renderStage, stage);
+                    endRenderpass(info);
+                }
+
+                gpuProfiler.end(primary, stageScope);
             }
+        }
 
-            ++stage.first;
+        {
+            ScopedFrameTiming timing{FrameTimings::Phase::Submit};
+            endFrame(info);
         }
 
-        endFrame(info);
+        // Queue executes the copy after the frame, so the image is complete
+        if (!dumpPath.empty() && swapchain->isOffscreen())
+            captureScreenshot(dumpPath / fmt::format("frame_{}_{:05}.png", id, updateCount), id);
     }
 
+    frameAllocator = nullptr;
+    recordingSurface = nullptr;
+
     if (elapsedPurge.getElapsed() != 0) {
+        std::unique_lock<std::mutex> lock(commandPoolMutex);
         for (auto it = commandPools.begin(); it != commandPools.end();) {
             if ((*it).second.use_count() <= 1) {
                 it = commandPools.erase(it);
@@ -113,6 +298,32 @@ void Graphics::onUpdate() {
     }
 }
 
+void Graphics::waitRenderThread() {
+    std::unique_lock<std::mutex> lock(renderMutex);
+    renderCondition.wait(lock, [this] { return !renderPending; });
+}
+
+void Graphics::onRenderThread() {
+    FUSION_PROFILE_SETTHREADNAME("Render Thread");
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(renderMutex);
+            renderCondition.wait(lock, [this] { return renderPending || renderStopping; });
+            if (renderStopping)
+                return;
+        }
+
+        renderFrame();
+
+        {
+            std::unique_lock<std::mutex> lock(renderMutex);
+            renderPending = false;
+        }
+        renderCondition.notify_all();
+    }
+}
+
 bool Graphics::beginFrame(FRAME_INFO) {
     auto result = swapchain.acquireNextImage(syncObject.getImageAvailableSemaphore(), syncObject.getInFlightFence());
 
@@ -133,14 +344,15 @@ bool Graphics::beginFrame(FRAME_INFO) {
 
     commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
+    // Fence of this frame was waited on acquire, so its timestamps can be read back
+    perSurfaceBuffers[id]->gpuProfiler->beginFrame(commandBuffer, currentFrame);
+
     FUSION_PROFILE_GPU("Begin Frame");
 
     return true;
 }
 
 bool Graphics::beginRenderpass(FRAME_INFO, RenderStage& renderStage) {
-    FUSION_PROFILE_GPU("Begin Renderpass");
-
     if (renderStage.isOutOfDate()) {
         //FE_LOG_WARNING("Render stage is out of date!");
         recreatePass(id, swapchain, renderStage);
@@ -150,10 +362,15 @@ bool Graphics::beginRenderpass(FRAME_INFO, RenderStage& renderStage) {
     const auto& renderArea = renderStage.getRenderArea();
 
     VkViewport viewport{ vku::viewport(renderArea.extent) };
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
     VkRect2D scissor{ vku::rect2D(renderArea.extent, renderArea.offset) };
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    {
+        // Zone is closed before the pass, primary can not write timestamps inside of a pass made of secondary buffers
+        FUSION_PROFILE_GPU("Begin Renderpass");
+
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    }
 
     auto clearValues = renderStage.getClearValues();
 
@@ -163,25 +380,123 @@ bool Graphics::beginRenderpass(FRAME_INFO, RenderStage& renderStage) {
     renderPassBeginInfo.renderArea = scissor; // same as render area
     renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassBeginInfo.pClearValues = clearValues.data();
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, parallelRecording ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    PerfCounters::Add(PerfCounters::Counter::RenderPasses);
+
+    // Dynamic state is not inherited by secondary buffers
+    inheritanceInfo.renderPass = renderPassBeginInfo.renderPass;
+    inheritanceInfo.framebuffer = renderPassBeginInfo.framebuffer;
+    secondaryViewport = viewport;
+    secondaryScissor = scissor;
 
     return true;
 }
 
 void Graphics::nextSubpasses(FRAME_INFO, RenderStage& renderStage, Pipeline::Stage& pipelineStage) {
     auto lastBinding = renderStage.getSubpasses().back().binding;
+    uint32_t subpassIndex = 0;
 
-    for (const auto& subpass : renderStage.getSubpasses()) {
-        FUSION_PROFILE_GPU("Begin Subpass");
+    auto& gpuProfiler = *recordingSurface->gpuProfiler;
 
+    for (const auto& subpass : renderStage.getSubpasses()) {
         pipelineStage.second = subpass.binding;
 
-        // Renders subpass subrender pipelines
-        renderer->subrenderHolder.renderStage(pipelineStage, commandBuffer, renderStage.getOverrideCamera());
+        // Subrender is measured from its first command to the first command of the next one, the subpass from the first subrender to the end
+        uint32_t subpassScope = UINT32_MAX;
+        uint32_t subrenderScope = UINT32_MAX;
+        bool subpassBegun = false;
+        auto onSubrender = [&](const Subrender& subrender, uint32_t index, const CommandBuffer& target) {
+            gpuProfiler.end(target, subrenderScope);
+            if (!subpassBegun) {
+                subpassBegun = true;
+                subpassScope = gpuProfiler.begin(target, GetProfilerKey(pipelineStage.first, pipelineStage.second), 1, [&] { return fmt::format("Subpass {}", pipelineStage.second); });
+            }
+            subrenderScope = gpuProfiler.begin(target, GetProfilerKey(pipelineStage.first, pipelineStage.second, index), 2, [&] { return subrender.getName(); });
+        };
+
+        if (parallelRecording) {
+            inheritanceInfo.subpass = subpassIndex++;
+            executeList.clear();
+
+            // Every subrender gets own secondary buffer, buffers recorded on the workers are placed right after it
+            CommandBuffer* secondary = nullptr;
+            renderer->subrenderHolder.renderStage(pipelineStage, [&]() -> const CommandBuffer& {
+                if (secondary)
+                    secondary->end();
+                secondary = &beginSecondary();
+                executeList.push_back(*secondary);
+                return *secondary;
+            }, snapshot->getStageCamera(pipelineStage.first), onSubrender);
+
+            if (secondary)
+                secondary->end();
+
+            // Closing timestamps need own buffer, it executes after the secondaries recorded on the workers
+            if (subpassScope != UINT32_MAX) {
+                auto& marker = beginSecondary();
+                gpuProfiler.end(marker, subrenderScope);
+                gpuProfiler.end(marker, subpassScope);
+                marker.end();
+                executeList.push_back(marker);
+            }
+
+            if (!executeList.empty())
+                vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(executeList.size()), executeList.data());
+        } else {
+            FUSION_PROFILE_GPU("Begin Subpass");
+
+            // Renders subpass subrender pipelines
+            renderer->subrenderHolder.renderStage(pipelineStage, commandBuffer, snapshot->getStageCamera(pipelineStage.first), onSubrender);
+
+            gpuProfiler.end(commandBuffer, subrenderScope);
+            gpuProfiler.end(commandBuffer, subpassScope);
+        }
 
         if (subpass.binding != lastBinding)
-            vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdNextSubpass(commandBuffer, parallelRecording ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    }
+}
+
+CommandBuffer& Graphics::beginSecondary() {
+    SecondaryBuffers* secondaryBuffers;
+    {
+        std::unique_lock<std::mutex> lock(secondaryMutex);
+        secondaryBuffers = &recordingSurface->secondaryBuffers[std::this_thread::get_id()][recordingSurface->currentFrame];
     }
+
+    // Only the owning thread touches its buffers, they are allocated from its command pool
+    if (secondaryBuffers->used == secondaryBuffers->commandBuffers.size())
+        secondaryBuffers->commandBuffers.push_back(std::make_unique<CommandBuffer>(false, VK_QUEUE_GRAPHICS_BIT, VK_COMMAND_BUFFER_LEVEL_SECONDARY));
+
+    auto& commandBuffer = *secondaryBuffers->commandBuffers[secondaryBuffers->used++];
+    commandBuffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &inheritanceInfo);
+
+    vkCmdSetViewport(commandBuffer, 0, 1, &secondaryViewport);
+    vkCmdSetScissor(commandBuffer, 0, 1, &secondaryScissor);
+
+    PerfCounters::Add(PerfCounters::Counter::SecondaryBuffers);
+
+    return commandBuffer;
+}
+
+void Graphics::recordParallel(const CommandBuffer& commandBuffer, size_t count, size_t grainSize, const std::function<void(const CommandBuffer&, size_t, size_t)>& function) {
+    auto threadPool = ThreadPool::Get();
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    if (!commandBuffer.isSecondary() || !recordingSurface || !threadPool || count <= grainSize) {
+        function(commandBuffer, 0, count);
+        return;
+    }
+
+    size_t first = executeList.size();
+    executeList.resize(first + (count + grainSize - 1) / grainSize);
+
+    threadPool->parallelFor(count, grainSize, [&](size_t begin, size_t end) {
+        auto& secondary = beginSecondary();
+        function(secondary, begin, end);
+        secondary.end();
+        executeList[first + begin / grainSize] = secondary;
+    });
 }
 
 void Graphics::endRenderpass(FRAME_INFO) {
@@ -202,10 +517,18 @@ void Graphics::endFrame(FRAME_INFO) {
     // Mark the image as now being in use by this frame
     syncObject.setImageInUse();
 
-    commandBuffer.submit(syncObject.getImageAvailableSemaphore(), syncObject.getRenderFinishedSemaphore(), syncObject.getInFlightFence());
+    // Offscreen images are not acquired and presented, so there are no semaphores to wait and signal
+    if (swapchain.isOffscreen())
+        commandBuffer.submit(VK_NULL_HANDLE, VK_NULL_HANDLE, syncObject.getInFlightFence());
+    else
+        commandBuffer.submit(syncObject.getImageAvailableSemaphore(), syncObject.getRenderFinishedSemaphore(), syncObject.getInFlightFence());
 
-    auto presentQueue = logicalDevice.getPresentQueue();
-    auto result = swapchain.queuePresent(presentQueue, syncObject.getRenderFinishedSemaphore());
+    VkResult result;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        auto presentQueue = logicalDevice.getPresentQueue();
+        result = swapchain.queuePresent(presentQueue, syncObject.getRenderFinishedSemaphore());
+    }
 
 #if FUSION_PLATFORM_ANDROID
     VK_CHECK_RESULT(result);
@@ -225,14 +548,15 @@ void Graphics::captureScreenshot(const fs::path& filepath, size_t id) const {
     auto debugStart = DateTime::Now();
 #endif
 
-    const auto& size = DeviceManager::Get()->getWindow(id)->getSize();
     auto& swapchain = swapchains[id];
+    glm::uvec2 size{ swapchain->getExtent().width, swapchain->getExtent().height };
     VkFormat format = swapchain->getSurfaceFormat().format;
+    VkImageLayout layout = swapchain->isOffscreen() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkImage dstImage;
     VkDeviceMemory dstImageMemory;
 
-    bool supportsBlit = Image::CopyImage(swapchain->getActiveImage(), dstImage, dstImageMemory, format, VK_FORMAT_R8G8B8A8_UNORM, { size.x, size.y, 1 }, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0, 0);
+    bool supportsBlit = Image::CopyImage(swapchain->getActiveImage(), dstImage, dstImageMemory, format, VK_FORMAT_R8G8B8A8_UNORM, { size.x, size.y, 1 }, layout, 0, 0);
 
     // Get layout of the image (including row pitch)
     VkImageSubresource imageSubresource = {};
@@ -281,29 +605,50 @@ void Graphics::captureScreenshot(const fs::path& filepath, size_t id) const {
 #endif
 }
 
+void Graphics::retire(std::shared_ptr<void>&& object) {
+    std::unique_lock<std::mutex> lock(retiredMutex);
+    retired.emplace_back(updateCount, std::move(object));
+}
+
 RenderStage* Graphics::getRenderStage(size_t index) const {
     return renderer ? renderer->getRenderStage(index) : nullptr;
 }
 
 const Descriptor* Graphics::getAttachment(const std::string& name) const {
+    std::unique_lock<std::mutex> lock(attachmentsMutex);
     if (auto it = attachments.find(name); it != attachments.end())
         return it->second;
     return nullptr;
 }
 
 void Graphics::resetRenderStages() {
-    for (const auto& [id, surface] : enumerate(surfaces)) {
-        auto& swapchain = swapchains.emplace_back(std::make_unique<Swapchain>(physicalDevice, logicalDevice, *surface, nullptr));
+    renderGraph.compile(renderer->renderStages);
+    renderGraph.update();
+
+    for (const auto& surface : surfaces) {
+        swapchains.push_back(std::make_unique<Swapchain>(physicalDevice, logicalDevice, *surface, nullptr));
+    }
+
+    // Without windows the stages are drawn into offscreen images, one per frame in flight
+    if (headless && swapchains.empty())
+        swapchains.push_back(std::make_unique<Swapchain>(logicalDevice, headlessExtent, VK_FORMAT_B8G8R8A8_UNORM, MAX_FRAMES_IN_FLIGHT));
+
+    for (const auto& [id, swapchain] : enumerate(swapchains)) {
         perSurfaceBuffers.push_back(std::make_unique<PerSurfaceBuffers>());
-        for (const auto& renderStage : renderer->renderStages)
-            renderStage->rebuild(id, *swapchain);
+        for (const auto& [index, renderStage] : enumerate(renderer->renderStages)) {
+            if (renderGraph.isLive(index))
+                renderStage->rebuild(id, *swapchain);
+        }
     }
 
     recreateAttachmentsMap();
 }
 
 void Graphics::recreateSwapchain(size_t id) {
-    VK_CHECK(vkDeviceWaitIdle(logicalDevice));
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        VK_CHECK(vkDeviceWaitIdle(logicalDevice));
+    }
 
     auto& swapchain = swapchains[id];
     auto& surface = surfaces[id];
@@ -319,16 +664,22 @@ void Graphics::recreateSwapchain(size_t id) {
     for (auto& sync : perSurfaceBuffer->syncObjects)
         sync.reset();
 
-    auto graphicsQueue = logicalDevice.getGraphicsQueue();
-    VK_CHECK(vkQueueWaitIdle(graphicsQueue));
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        auto graphicsQueue = logicalDevice.getGraphicsQueue();
+        VK_CHECK(vkQueueWaitIdle(graphicsQueue));
+    }
 
-    for (const auto& renderStage : renderer->renderStages)
-        renderStage->rebuild(id, *swapchain);
+    for (const auto& [index, renderStage] : enumerate(renderer->renderStages)) {
+        if (renderGraph.isLive(index))
+            renderStage->rebuild(id, *swapchain);
+    }
 
     recreateAttachmentsMap();
 }
 
 void Graphics::recreateAttachmentsMap() {
+    std::unique_lock<std::mutex> lock(attachmentsMutex);
     attachments.clear();
 
     for (const auto& renderStage : renderer->renderStages) {
@@ -339,19 +690,17 @@ void Graphics::recreateAttachmentsMap() {
 }
 
 void Graphics::recreatePass(size_t id, Swapchain& swapchain, RenderStage& renderStage) {
-    // Swapchain should recreate in the begin or the end frame stage
-    if (renderStage.hasSwapchain())
+    // Swapchain should recreate in the begin or the end frame stage, unless the stage was culled and has no targets
+    if (renderStage.hasSwapchain() && renderStage.getFramebuffers())
         return;
 
-    auto graphicsQueue = logicalDevice.getGraphicsQueue();
-    VK_CHECK(vkQueueWaitIdle(graphicsQueue));
-
+    // Old targets are retired, so frames in flight keep them without waiting for the queue
     renderStage.rebuild(id, swapchain);
     recreateAttachmentsMap();
 }
 
 void Graphics::onWindowCreate(Window* window, bool create) {
-    if (!window) return;
+    if (!window || headless) return;
     if (create) {
         surfaces.push_back(std::make_unique<Surface>(instance, physicalDevice, *window));
     } else {
@@ -363,7 +712,8 @@ void Graphics::onWindowCreate(Window* window, bool create) {
     }
 }
 
-const std::shared_ptr<CommandPool>& Graphics::getCommandPool(const std::thread::id& threadId) {
+std::shared_ptr<CommandPool> Graphics::getCommandPool(const std::thread::id& threadId) {
+    std::unique_lock<std::mutex> lock(commandPoolMutex);
     if (auto it = commandPools.find(threadId); it != commandPools.end())
         return it->second;
     return commandPools.emplace(threadId, std::make_shared<CommandPool>(threadId)).first->second;
@@ -372,6 +722,8 @@ const std::shared_ptr<CommandPool>& Graphics::getCommandPool(const std::thread::
 Graphics::PerSurfaceBuffers::PerSurfaceBuffers() {
     commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
     syncObjects.resize(MAX_FRAMES_IN_FLIGHT);
+    frameAllocator = std::make_unique<FrameAllocator>(FRAME_ALLOCATOR_CAPACITY, MAX_FRAMES_IN_FLIGHT);
+    gpuProfiler = std::make_unique<GpuProfiler>(Graphics::Get()->getPhysicalDevice(), Graphics::Get()->getLogicalDevice(), MAX_FRAMES_IN_FLIGHT, GPU_PROFILER_CAPACITY);
 #if FUSION_PROFILE && TRACY_ENABLE
     tracyContexts.resize(MAX_FRAMES_IN_FLIGHT);
 
@@ -2,6 +2,7 @@
 
 #include "fusion/devices/window.h"
 #include "fusion/graphics/renderer.h"
+#include "fusion/graphics/render_graph.h"
 #include "fusion/graphics/devices/instance.h"
 #include "fusion/graphics/devices/logical_device.h"
 #include "fusion/graphics/devices/physical_device.h"
@@ -9,15 +10,23 @@
 #include "fusion/graphics/pipelines/pipeline_cache.h"
 #include "fusion/graphics/renderpass/sync_object.h"
 #include "fusion/graphics/commands/command_buffer.h"
+#include "fusion/graphics/commands/gpu_profiler.h"
 #include "fusion/graphics/descriptors/descriptor_allocator.h"
+#include "fusion/graphics/buffers/frame_allocator.h"
 #include "fusion/graphics/descriptors/descriptor_layout_cache.h"
+#include "fusion/graphics/descriptors/bindless_registry.h"
 #include "fusion/graphics/pipelines/pipeline_layout_cache.h"
 #include "fusion/graphics/textures/sampler_cache.h"
 
 #include <thread>
+#include <mutex>
+#include <deque>
+#include <condition_variable>
 
 static const uint32_t MAX_FRAMES_IN_FLIGHT = 2;
 static const uint32_t MAX_BINDLESS_RESOURCES = 1024;
+static const VkDeviceSize FRAME_ALLOCATOR_CAPACITY = 8 * 1024 * 1024;
+static const uint32_t GPU_PROFILER_CAPACITY = 512;
 
 namespace tracy {
     class VkCtx;
@@ -26,6 +35,7 @@ namespace tracy {
 namespace fe {
     template<typename T>
     class Module;
+    class RenderSnapshot;
     /**
      * @brief Module that manages the Vulkan's graphics context.
      */
@@ -51,6 +61,7 @@ namespace fe {
         void setRenderer(std::unique_ptr<Renderer>&& rend) { renderer = std::move(rend); }
 
         RenderStage* getRenderStage(size_t index) const;
+        RenderGraph& getRenderGraph() { return renderGraph; }
         const Descriptor* getAttachment(const std::string& name) const;
 
         const PhysicalDevice& getPhysicalDevice() const { return physicalDevice; }
@@ -62,13 +73,78 @@ namespace fe {
         const PipelineLayoutCache& getPipilineLayoutCache() const { return pipelineLayoutCache; }
         const DescriptorAllocator& getDescriptorAllocator() const { return descriptorAllocator; }
         const DescriptorAllocator& getIndexedDescriptorAllocator() const { return indexedDescriptorAllocator; }
+        BindlessRegistry& getBindlessRegistry() { return bindlessRegistry; }
+        const BindlessRegistry& getBindlessRegistry() const { return bindlessRegistry; }
 
-        const std::shared_ptr<CommandPool>& getCommandPool(const std::thread::id& threadId = std::this_thread::get_id());
+        std::shared_ptr<CommandPool> getCommandPool(const std::thread::id& threadId = std::this_thread::get_id());
         const Surface* getSurface(size_t id) const { return surfaces[id].get(); }
         const Swapchain* getSwapchain(size_t id) const { return swapchains[id].get(); }
 
         size_t getCurrentFrame(size_t id) const { return perSurfaceBuffers[id]->currentFrame; }
 
+        /**
+         * Gets the timestamp profiler of a surface, it measures the device time of render stages, subpasses and subrenders.
+         * @param id The surface index.
+         * @return The profiler or nullptr if there is no such surface.
+         */
+        GpuProfiler* getGpuProfiler(size_t id = 0) const { return id < perSurfaceBuffers.size() ? perSurfaceBuffers[id]->gpuProfiler.get() : nullptr; }
+
+        /**
+         * Gets the linear allocator of the frame that is currently recorded, transient data is valid until the frame fence is signaled.
+         * @return The frame allocator.
+         */
+        FrameAllocator& getFrameAllocator() const { FE_ASSERT(frameAllocator && "Frame allocator is only available during rendering"); return *frameAllocator; }
+
+        /**
+         * Records a range of draws in chunks on the thread pool. Every chunk gets its own secondary command buffer which is executed right after
+         * the buffer of the calling subrender, so it has to be the last thing the subrender records. Without parallel recording the function is called once.
+         * @param commandBuffer The command buffer the subrender records into.
+         * @param count The number of elements.
+         * @param grainSize The number of elements in a chunk.
+         * @param function The function which records elements from begin to end, it is called from several threads at once.
+         */
+        void recordParallel(const CommandBuffer& commandBuffer, size_t count, size_t grainSize, const std::function<void(const CommandBuffer&, size_t, size_t)>& function);
+
+        /**
+         * Gets if subpasses are recorded into secondary command buffers, which lets subrenders spread their draws over the thread pool.
+         * @return If recording is parallel.
+         */
+        bool isParallelRecording() const { return parallelRecording; }
+        void setParallelRecording(bool flag) { parallelRecording = flag; }
+
+        /**
+         * Gets the scene data of the frame which is currently recorded.
+         * @return The render snapshot.
+         */
+        const RenderSnapshot& getSnapshot() const { return *snapshot; }
+
+        /**
+         * Gets if frames are recorded and submitted on the render thread while the main thread updates the next frame.
+         * Frames are recorded on the main thread while an enabled subrender is not thread safe.
+         * @return If the render thread is used.
+         */
+        bool isThreadedRendering() const { return threadedRendering; }
+        void setThreadedRendering(bool flag) { threadedRendering = flag; }
+
+        /**
+         * Gets if render stages are drawn into offscreen images instead of window surfaces.
+         * @return If rendering is headless.
+         */
+        bool isHeadless() const { return headless; }
+
+        /**
+         * Gets the mutex which guards submissions to the device queues, they can happen on the main and on the render thread.
+         * @return The queue mutex.
+         */
+        std::mutex& getQueueMutex() { return queueMutex; }
+
+        /**
+         * Keeps a GPU object alive until the frames which can still use it are finished, so it can be replaced without waiting for the device.
+         * Can be called from the main and from the render thread.
+         * @param object The object to destroy later.
+         */
+        void retire(std::shared_ptr<void>&& object);
+
         /**
          * Takes a screenshot of the current image of the display and saves it into a image file.
          * @param filepath The file to save the screenshot as.
@@ -88,10 +164,16 @@ namespace fe {
         #define FUSION_PROFILE_GPU(name)
 #endif
 
+        void renderFrame();
+        void waitRenderThread();
+        void onRenderThread();
+        void updateFrameLimit();
+
         bool beginFrame(FRAME_INFO);
         bool beginRenderpass(FRAME_INFO, RenderStage& renderStage);
         void nextSubpasses(FRAME_INFO, RenderStage& renderStage, Pipeline::Stage& pipelineStage);
         void endRenderpass(FRAME_INFO);
+        CommandBuffer& beginSecondary();
         void endFrame(FRAME_INFO);
 
         void resetRenderStages();
@@ -108,16 +190,29 @@ namespace fe {
         DescriptorLayoutCache descriptorLayoutCache{ logicalDevice };
         DescriptorAllocator descriptorAllocator{ logicalDevice, 1024, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT };
         DescriptorAllocator indexedDescriptorAllocator{ logicalDevice, 1024, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT };
+        BindlessRegistry bindlessRegistry{ MAX_BINDLESS_RESOURCES - 1 };
 
         SamplerCache samplerCache{ logicalDevice };
         PipelineCache pipelineCache{ logicalDevice };
         PipelineLayoutCache pipelineLayoutCache{ logicalDevice };
 
         fst::unordered_flatmap<std::string, const Descriptor*> attachments;
+        mutable std::mutex attachmentsMutex; /// Attachments are rebuilt on the render thread when a stage is recreated.
 
         std::unordered_map<std::thread::id, std::shared_ptr<CommandPool>> commandPools;
+        std::mutex commandPoolMutex;
         ElapsedTime elapsedPurge; /// Timer used to remove unused command pools.
         std::unique_ptr<Renderer> renderer;
+        RenderGraph renderGraph;
+        std::deque<std::pair<uint64_t, std::shared_ptr<void>>> retired; /// Objects with the update they were retired at.
+        std::mutex retiredMutex; /// Objects are retired from the main and from the render thread.
+        uint64_t updateCount{ 0 };
+        FrameAllocator* frameAllocator{ nullptr }; /// Allocator of the surface that is currently recorded.
+
+        struct SecondaryBuffers {
+            std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+            size_t used{ 0 };
+        };
 
         std::vector<std::unique_ptr<Surface>> surfaces;
         std::vector<std::unique_ptr<Swapchain>> swapchains;
@@ -128,12 +223,40 @@ namespace fe {
             size_t currentFrame{ 0 };
             std::vector<CommandBuffer> commandBuffers;
             std::vector<SyncObject> syncObjects;
+            std::unique_ptr<FrameAllocator> frameAllocator;
+            std::unique_ptr<GpuProfiler> gpuProfiler;
+            std::unordered_map<std::thread::id, std::array<SecondaryBuffers, MAX_FRAMES_IN_FLIGHT>> secondaryBuffers; /// Buffers are allocated from the pool of the recording thread.
 #if FUSION_PROFILE && TRACY_ENABLE
             std::vector<tracy::VkCtx*> tracyContexts;
 #endif
         };
         std::vector<std::unique_ptr<PerSurfaceBuffers>> perSurfaceBuffers;
 
+        PerSurfaceBuffers* recordingSurface{ nullptr }; /// Surface that is currently recorded.
+        VkCommandBufferInheritanceInfo inheritanceInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+        VkViewport secondaryViewport{};
+        VkRect2D secondaryScissor{};
+        std::vector<VkCommandBuffer> executeList; /// Secondary buffers of the current subpass in the execution order.
+        std::mutex secondaryMutex;
+        bool parallelRecording{ true };
+
+        std::unique_ptr<RenderSnapshot> snapshot;
+        std::thread renderThread;
+        std::mutex renderMutex;
+        std::condition_variable renderCondition;
+        std::mutex queueMutex;
+        bool renderPending{ false }; /// Frame was handed to the render thread and is not submitted yet.
+        bool renderStopping{ false };
+        bool threadedRendering{ false };
+
+        bool headless{ false };
+        VkExtent2D headlessExtent{ 1280, 720 };
+        fs::path dumpPath; /// Directory the offscreen frames are written to.
+        uint32_t frameLimit{ 0 }; /// Number of frames to render before closing, zero is unlimited.
+        uint32_t frameCount{ 0 };
+        DateTime lastFrameTime;
+        std::vector<float> frameTimes;
+
         static Graphics* Instance;
     };
 }
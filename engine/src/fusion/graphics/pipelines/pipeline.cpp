@@ -1,9 +1,11 @@
 #include "pipeline.h"
 
 #include "fusion/graphics/commands/command_buffer.h"
+#include "fusion/core/perf_counters.h"
 
 using namespace fe;
 
 void Pipeline::bindPipeline(const CommandBuffer& commandBuffer) const {
     vkCmdBindPipeline(commandBuffer, getPipelineBindPoint(), getPipeline());
+    PerfCounters::Add(PerfCounters::Counter::PipelineBinds);
 }
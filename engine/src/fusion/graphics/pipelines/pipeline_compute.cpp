@@ -54,7 +54,8 @@ void PipelineCompute::createShaderProgram() {
 	shaderStageCreateInfo.pName = "main";
     shaderStageCreateInfo.pSpecializationInfo = specialization ? &specialization->getSpecializationInfo() : nullptr;
 
-    shader.createReflection();
+    // Push descriptors can not hold dynamic buffers.
+    shader.createReflection(!pushDescriptors);
 }
 
 void PipelineCompute::createDescriptorLayout() {
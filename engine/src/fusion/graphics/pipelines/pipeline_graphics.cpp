@@ -96,7 +96,8 @@ void PipelineGraphics::createShaderProgram() {
         pipelineShaderStageCreateInfo.pSpecializationInfo = specialization ? &specialization->getSpecializationInfo() : nullptr;
 	}
 
-	shader.createReflection();
+	// Push descriptors can not hold dynamic buffers.
+	shader.createReflection(!pushDescriptors);
 }
 
 void PipelineGraphics::createDescriptorLayout() {
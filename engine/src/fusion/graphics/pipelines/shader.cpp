@@ -317,6 +317,24 @@ std::optional<Shader::UniformBlock> Shader::getUniformBlock(const std::string& n
 	return std::nullopt;
 }
 
+Shader::DescriptorHandle Shader::getDescriptorHandle(const std::string& name) const {
+    if (auto it = descriptorHandles.find(name); it != descriptorHandles.end())
+        return it->second;
+    return {};
+}
+
+Shader::UniformHandle Shader::getUniformHandle(const std::string& blockName, const std::string& uniformName) const {
+    if (auto it = uniformBlocks.find(blockName); it != uniformBlocks.end())
+        return it->second.getUniformHandle(uniformName);
+    return {};
+}
+
+Shader::UniformHandle Shader::UniformBlock::getUniformHandle(const std::string& name) const {
+    if (auto it = uniforms.find(name); it != uniforms.end() && it->second.offset >= 0 && it->second.size > 0)
+        return { static_cast<uint32_t>(it->second.offset), static_cast<uint32_t>(it->second.size) };
+    return {};
+}
+
 std::optional<Shader::Attribute> Shader::getAttribute(const std::string& name) const {
 	if (auto it = attributes.find(name); it != attributes.end())
 		return it->second;
@@ -643,18 +661,40 @@ std::optional<Shader::Specialization> Shader::createSpecialization(const fst::un
     return specialization;
 }
 
-void Shader::createReflection() {
-	// Process to descriptors.
+void Shader::createReflection(bool dynamicBuffers) {
+    // Devices only allow a few dynamic buffers per layout, so a type falls back to static descriptors over the limit
+    bool dynamicUniforms = false;
+    bool dynamicStorages = false;
+    if (dynamicBuffers) {
+        uint32_t uniformCount = 0;
+        uint32_t storageCount = 0;
+        for (const auto& [uniformBlockName, uniformBlock] : uniformBlocks) {
+            if (uniformBlock.type == UniformBlock::Type::Uniform)
+                ++uniformCount;
+            else if (uniformBlock.type == UniformBlock::Type::Storage)
+                ++storageCount;
+        }
+
+        const auto& limits = Graphics::Get()->getPhysicalDevice().getProperties().limits;
+        dynamicUniforms = uniformCount <= limits.maxDescriptorSetUniformBuffersDynamic;
+        dynamicStorages = storageCount <= limits.maxDescriptorSetStorageBuffersDynamic;
+        if (!dynamicUniforms || !dynamicStorages) {
+            FE_LOG_WARNING("Shader '{}' has more buffers than the device allows as dynamic: uniforms = {}/{}, storages = {}/{}", name,
+                           uniformCount, limits.maxDescriptorSetUniformBuffersDynamic, storageCount, limits.maxDescriptorSetStorageBuffersDynamic);
+        }
+    }
+
+	// Process to descriptors, buffers are made dynamic so transient data can be bound by offset.
 	for (const auto& [uniformBlockName, uniformBlock] : uniformBlocks) {
 		auto descriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
 
 		switch (uniformBlock.type) {
             case UniformBlock::Type::Uniform:
-                descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                descriptorType = dynamicUniforms ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
                 descriptorSetLayouts.push_back(UniformBuffer::GetDescriptorSetLayout(static_cast<uint32_t>(uniformBlock.binding), descriptorType, uniformBlock.stageFlags, 1));
                 break;
             case UniformBlock::Type::Storage:
-                descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                descriptorType = dynamicStorages ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
                 descriptorSetLayouts.push_back(StorageBuffer::GetDescriptorSetLayout(static_cast<uint32_t>(uniformBlock.binding), descriptorType, uniformBlock.stageFlags, 1));
                 break;
             case UniformBlock::Type::Push:
@@ -706,6 +746,19 @@ void Shader::createReflection() {
         descriptorTypes.emplace(layout.binding, layout.descriptorType);
     }
 
+    // Resolves handles once, blocks are not modified after reflection so pointers stay valid.
+    for (const auto& [descriptorName, location] : descriptorLocations) {
+        DescriptorHandle handle = {};
+        if (auto it = descriptorTypes.find(location); it != descriptorTypes.end()) {
+            handle.binding = location;
+            handle.type = it->second;
+        }
+        if (auto it = uniformBlocks.find(descriptorName); it != uniformBlocks.end()) {
+            handle.uniformBlock = &it->second;
+        }
+        descriptorHandles.emplace(descriptorName, handle);
+    }
+
     // Process attribute descriptions.
     {
         std::vector<const Attribute*> values;
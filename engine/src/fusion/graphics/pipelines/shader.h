@@ -33,6 +33,29 @@ namespace fe {\
             fst::split_flatmap<uint32_t, SpecConstant> data;
         };
 
+        /**
+         * @brief Resolved location of an uniform inside of a block.
+         */
+        struct UniformHandle {
+            uint32_t offset{ 0 };
+            uint32_t size{ 0 };
+
+            operator bool() const { return size != 0; }
+        };
+
+        class UniformBlock;
+
+        /**
+         * @brief Resolved descriptor of a shader, used to push descriptors without name lookups.
+         */
+        struct DescriptorHandle {
+            uint32_t binding{ UINT32_MAX };
+            VkDescriptorType type{ VK_DESCRIPTOR_TYPE_MAX_ENUM };
+            const UniformBlock* uniformBlock{ nullptr }; /// Set for uniform, storage and push blocks.
+
+            operator bool() const { return binding != UINT32_MAX || uniformBlock != nullptr; }
+        };
+
         class FUSION_API Uniform {
             friend class Shader;
         public:
@@ -104,6 +127,13 @@ namespace fe {\
                 return std::nullopt;
             }
 
+            /**
+             * Resolves the uniform once, so per frame pushes do not search the block.
+             * @param name The uniform name.
+             * @return The handle, it is empty if uniform is not found.
+             */
+            UniformHandle getUniformHandle(const std::string& name) const;
+
             bool operator==(const UniformBlock& rhs) const {
                 return set == rhs.set && binding == rhs.binding && size == rhs.size && stageFlags == rhs.stageFlags && type == rhs.type && uniforms == rhs.uniforms;
             }
@@ -207,6 +237,8 @@ namespace fe {\
         std::optional<uint32_t> getDescriptorSize(const std::string& name) const;
         std::optional<Uniform> getUniform(const std::string& name) const;
         std::optional<UniformBlock> getUniformBlock(const std::string& name) const;
+        DescriptorHandle getDescriptorHandle(const std::string& name) const;
+        UniformHandle getUniformHandle(const std::string& blockName, const std::string& uniformName) const;
         std::optional<Attribute> getAttribute(const std::string& name) const;
         std::optional<Constant> getConstant(const std::string& name) const;
 
@@ -215,7 +247,7 @@ namespace fe {\
 
         VkShaderModule createShaderModule(const std::string& moduleName, const std::string& moduleCode, VkShaderStageFlagBits moduleFlag);
         std::optional<Specialization> createSpecialization(const fst::unordered_flatmap<std::string, Shader::SpecConstant>& specConstants, VkShaderStageFlagBits moduleFlag) const;
-        void createReflection();
+        void createReflection(bool dynamicBuffers = false);
 
         const std::string& getName() const { return name; }
         const fst::unordered_flatmap<std::string, Uniform>& getUniforms() const { return uniforms; };
@@ -246,6 +278,7 @@ namespace fe {\
         fst::unordered_flatmap<std::string, uint32_t> descriptorSizes;
 
         fst::flatmap<uint32_t, VkDescriptorType> descriptorTypes;
+        fst::unordered_flatmap<std::string, DescriptorHandle> descriptorHandles;
         std::vector<VkDescriptorSetLayoutBinding> descriptorSetLayouts;
 
         std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
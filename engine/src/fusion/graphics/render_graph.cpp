@@ -0,0 +1,164 @@
+#include "render_graph.h"
+#include "render_stage.h"
+
+#include "fusion/graphics/graphics.h"
+#include "fusion/graphics/textures/texture_depth.h"
+
+#include <numeric>
+
+using namespace fe;
+
+void RenderGraph::compile(const std::vector<std::unique_ptr<RenderStage>>& renderStages) {
+    clear();
+
+    size_t count = renderStages.size();
+    stages.reserve(count);
+    for (const auto& renderStage : renderStages) {
+        stages.push_back(renderStage.get());
+    }
+
+    fst::unordered_flatmap<std::string, uint32_t> producers;
+    for (const auto& [index, renderStage] : enumerate(stages)) {
+        for (const auto& attachment : renderStage->getAttachments()) {
+            if (attachment.type != Attachment::Type::Swapchain)
+                producers.emplace(attachment.name, static_cast<uint32_t>(index));
+        }
+    }
+
+    consumers.resize(count);
+    std::vector<uint32_t> dependencies(count, 0);
+    std::unordered_set<std::string> readNames;
+
+    for (const auto& [index, renderStage] : enumerate(stages)) {
+        for (const auto& name : renderStage->getReads()) {
+            readNames.insert(name);
+
+            auto it = producers.find(name);
+            if (it == producers.end()) {
+                FE_LOG_WARNING("Render stage [{}] reads unknown attachment: '{}'", index, name);
+                continue;
+            }
+
+            auto producer = it->second;
+            if (producer == index)
+                continue;
+
+            auto& list = consumers[producer];
+            if (std::find(list.begin(), list.end(), index) == list.end()) {
+                list.push_back(static_cast<uint32_t>(index));
+                ++dependencies[index];
+            }
+        }
+    }
+
+    // Kahn's algorithm, the lowest ready index goes first, so independent stages keep the declared order
+    order.reserve(count);
+    std::vector<bool> visited(count, false);
+    while (order.size() < count) {
+        uint32_t index = 0;
+        while (index < count && (visited[index] || dependencies[index] != 0))
+            ++index;
+
+        if (index == count) {
+            FE_LOG_ERROR("Render stages have cyclic reads, using the declaration order");
+            order.resize(count);
+            std::iota(order.begin(), order.end(), 0);
+            break;
+        }
+
+        visited[index] = true;
+        order.push_back(index);
+        for (auto consumer : consumers[index]) {
+            --dependencies[consumer];
+        }
+    }
+
+    for (auto renderStage : stages) {
+        renderStage->transientDepth = renderStage->depthAttachment && readNames.find(renderStage->depthAttachment->name) == readNames.end();
+    }
+
+    live.assign(count, true);
+}
+
+bool RenderGraph::update() {
+    bool changed = false;
+
+    // Consumers come later in the order, so they are resolved before their producers
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto index = *it;
+        auto renderStage = stages[index];
+
+        bool needed = consumers[index].empty() || renderStage->hasSwapchain() ||
+            std::any_of(consumers[index].begin(), consumers[index].end(), [this](uint32_t consumer) { return live[consumer]; });
+        bool alive = renderStage->isEnabled() && needed;
+
+        if (alive == live[index])
+            continue;
+
+        if (!alive) {
+            releaseTransientDepth(renderStage);
+            renderStage->release();
+        }
+
+        live[index] = alive;
+        changed = true;
+    }
+
+    return changed;
+}
+
+void RenderGraph::clear() {
+    stages.clear();
+    consumers.clear();
+    order.clear();
+    live.clear();
+
+    for (auto& transient : transientDepths) {
+        if (transient.texture)
+            Graphics::Get()->retire(std::move(transient.texture));
+    }
+    transientDepths.clear();
+}
+
+std::shared_ptr<TextureDepth> RenderGraph::acquireTransientDepth(RenderStage& renderStage, const glm::uvec2& extent, VkSampleCountFlagBits samples) {
+    releaseTransientDepth(&renderStage);
+
+    auto it = std::find_if(transientDepths.begin(), transientDepths.end(), [samples](const TransientDepth& t) {
+        return t.samples == samples;
+    });
+    if (it == transientDepths.end())
+        it = transientDepths.insert(transientDepths.end(), TransientDepth{ nullptr, samples });
+
+    auto& transient = *it;
+
+    if (!transient.texture || extent.x > transient.extent.x || extent.y > transient.extent.y) {
+        if (transient.texture)
+            Graphics::Get()->retire(std::move(transient.texture));
+
+        transient.extent = glm::max(transient.extent, extent);
+        transient.texture = std::make_shared<TextureDepth>(transient.extent, samples);
+
+        // Stages which used the smaller target rebuild with the new one on their next update
+        for (auto user : transient.users) {
+            user->release();
+        }
+        transient.users.clear();
+    }
+
+    transient.users.push_back(&renderStage);
+    return transient.texture;
+}
+
+void RenderGraph::releaseTransientDepth(RenderStage* renderStage) {
+    for (auto it = transientDepths.begin(); it != transientDepths.end();) {
+        auto& users = it->users;
+        users.erase(std::remove(users.begin(), users.end(), renderStage), users.end());
+
+        if (users.empty() && it->texture) {
+            Graphics::Get()->retire(std::move(it->texture));
+            it = transientDepths.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace fe {
+    class RenderStage;
+    class TextureDepth;
+    /**
+     * @brief Dependency graph of the render stages built from the attachments they write and the attachments they declare to read.
+     * Stages are executed in dependency order, stages which are disabled or whose outputs are not read by a live stage are culled
+     * and release their targets, depth attachments which no stage reads are transient and share memory between stages.
+     */
+    class FUSION_API RenderGraph {
+    public:
+        RenderGraph() = default;
+        ~RenderGraph() = default;
+        NONCOPYABLE(RenderGraph);
+
+        /**
+         * Builds the execution order and finds transient attachments, called when the stages of the renderer change.
+         * @param renderStages The stages of the renderer.
+         */
+        void compile(const std::vector<std::unique_ptr<RenderStage>>& renderStages);
+
+        /**
+         * Finds stages which have to run this frame, stages culled since the last update release their targets.
+         * @return If the set of live stages has changed.
+         */
+        bool update();
+
+        void clear();
+
+        /**
+         * Gets a depth target shared by transient depth attachments, the target grows to the largest requested extent.
+         * Other users of a replaced target are released, so they rebuild with the new one.
+         * @param renderStage The stage that requests the target.
+         * @param extent The extent of the stage.
+         * @param samples The number of samples.
+         * @return The shared depth target.
+         */
+        std::shared_ptr<TextureDepth> acquireTransientDepth(RenderStage& renderStage, const glm::uvec2& extent, VkSampleCountFlagBits samples);
+
+        /**
+         * Gets stage indices in the order of execution.
+         * @return The execution order.
+         */
+        const std::vector<uint32_t>& getOrder() const { return order; }
+        bool isLive(size_t index) const { return index < live.size() && live[index]; }
+
+    private:
+        struct TransientDepth {
+            std::shared_ptr<TextureDepth> texture;
+            VkSampleCountFlagBits samples;
+            glm::uvec2 extent{ 0 };
+            std::vector<RenderStage*> users;
+        };
+
+        void releaseTransientDepth(RenderStage* renderStage);
+
+        std::vector<RenderStage*> stages;
+        std::vector<std::vector<uint32_t>> consumers; /// Stages that read attachments of the stage.
+        std::vector<uint32_t> order;
+        std::vector<bool> live;
+        std::vector<TransientDepth> transientDepths;
+    };
+}
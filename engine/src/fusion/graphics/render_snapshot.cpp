@@ -0,0 +1,96 @@
+#include "render_snapshot.h"
+#include "render_stage.h"
+#include "graphics.h"
+
+#include "fusion/scene/scene.h"
+#include "fusion/scene/components.h"
+
+using namespace fe;
+
+/**
+ * Textures which are still loading are left out, so the material falls back to its base color until they are ready.
+ * @return The bindless slot of the texture or -1.
+ */
+static int32_t GetTextureIndex(AssetHandle<Texture2d> handle) {
+    auto texture = handle.get();
+    return texture && texture->isReady() ? texture->getBindlessIndex() : -1;
+}
+
+void RenderSnapshot::extract(const Scene* scene, const std::vector<std::unique_ptr<RenderStage>>& renderStages) {
+    clear();
+
+    stageCameras.resize(renderStages.size());
+    for (const auto& [index, renderStage] : enumerate(renderStages)) {
+        if (auto overrideCamera = renderStage->getOverrideCamera())
+            stageCameras[index] = *overrideCamera;
+    }
+
+    if (scene)
+        extractScene(*scene);
+
+    // Slots were acquired above, so the copy contains every texture of the draws
+    const auto& table = Graphics::Get()->getBindlessRegistry().getTable();
+    if (bindlessTable.version != table.version)
+        bindlessTable = table;
+}
+
+void RenderSnapshot::extractScene(const Scene& scene) {
+    sceneValid = true;
+
+    if (auto sceneCamera = scene.getCamera())
+        camera = *sceneCamera;
+
+    const auto& registry = scene.getRegistry();
+
+    {
+        auto view = registry.view<const MeshComponent, const TransformComponent, const MaterialComponent>();
+        for (const auto& [entity, mesh, transform, material] : view.each()) {
+            auto filter = mesh.get();
+            if (!filter)
+                continue;
+
+            meshes.push_back({ filter, transform.getWorldMatrix(), transform.getNormalMatrix(), transform.getWorldPosition(), material.baseColor, material.shininess,
+                               GetTextureIndex(material.diffuse), GetTextureIndex(material.specular), GetTextureIndex(material.normal) });
+        }
+    }
+
+    {
+        auto view = registry.view<const TransformComponent, const LightComponent>();
+        for (const auto& [entity, transform, light] : view.each()) {
+            lights.push_back({ light, transform.getWorldPosition(), transform.getWorldForwardDirection() });
+        }
+    }
+
+    {
+        auto view = registry.view<const TextComponent, const TransformComponent>();
+        for (const auto& [entity, text, transform] : view.each()) {
+            auto font = text.font.get();
+            if (!font || !font->isReady() || !font->getAtlasTexture())
+                continue;
+
+            texts.push_back({ text, font, font->getAtlasTexture()->getBindlessIndex(), transform.getWorldMatrix(), transform.getWorldPosition() });
+        }
+    }
+
+    {
+        auto view = registry.view<const SkyboxComponent>();
+        if (!view.empty()) {
+            const auto& handle = registry.get<SkyboxComponent>(view.front()).texture;
+            auto texture = handle.get();
+            if (texture && texture->isReady())
+                skybox = texture;
+        }
+    }
+}
+
+void RenderSnapshot::clear() {
+    camera.reset();
+    for (auto& stageCamera : stageCameras) {
+        stageCamera.reset();
+    }
+    meshes.clear();
+    lights.clear();
+    texts.clear();
+    skybox = nullptr;
+    sceneValid = false;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "fusion/graphics/cameras/camera.h"
+#include "fusion/graphics/descriptors/bindless_registry.h"
+#include "fusion/scene/components/light_component.h"
+#include "fusion/scene/components/text_component.h"
+
+namespace fe {
+    class Scene;
+    class Model;
+    class Mesh;
+    class Texture2d;
+    class TextureCube;
+    class RenderStage;
+    /**
+     * @brief Immutable copy of the scene data which subrenders draw, extracted once per frame on the main thread.
+     * Handles of the components are resolved into plain pointers, so the frame can be recorded while the scene is already updated for the next one.
+     * Assets resolved for a frame are not evicted, and evicted or released assets are retired through {@link Graphics#retire}, so they outlive the frames in flight.
+     * Bindless slots of the textures are resolved here as well and the bindless table is copied, the render thread never touches the {@link BindlessRegistry}.
+     */
+    class FUSION_API RenderSnapshot {
+    public:
+        struct MeshDraw {
+            const Mesh* mesh;
+            glm::mat4 worldMatrix;
+            glm::mat3 normalMatrix;
+            glm::vec3 position;
+            glm::vec3 baseColor;
+            float shininess;
+            int32_t diffuseIndex; /// Bindless slots of the textures, -1 without a texture.
+            int32_t specularIndex;
+            int32_t normalIndex;
+        };
+
+        struct LightDraw {
+            LightComponent light;
+            glm::vec3 position;
+            glm::vec3 direction;
+        };
+
+        struct TextDraw {
+            TextComponent text;
+            const Font* font;
+            int32_t atlasIndex; /// Bindless slot of the font atlas.
+            glm::mat4 worldMatrix;
+            glm::vec3 position;
+        };
+
+        RenderSnapshot() = default;
+        ~RenderSnapshot() = default;
+        NONCOPYABLE(RenderSnapshot);
+
+        /**
+         * Copies the drawable state of the scene and the cameras of the render stages, containers keep their capacity between frames.
+         * @param scene The scene to extract, can be null.
+         * @param renderStages The stages of the renderer.
+         */
+        void extract(const Scene* scene, const std::vector<std::unique_ptr<RenderStage>>& renderStages);
+
+        void clear();
+
+        /**
+         * Gets the camera of the scene.
+         * @return The camera or nullptr if scene has no camera.
+         */
+        const Camera* getCamera() const { return camera ? &*camera : nullptr; }
+
+        /**
+         * Gets the override camera of the render stage.
+         * @param index The stage index.
+         * @return The camera or nullptr if stage has no override camera.
+         */
+        const Camera* getStageCamera(size_t index) const { return index < stageCameras.size() && stageCameras[index] ? &*stageCameras[index] : nullptr; }
+
+        bool hasScene() const { return sceneValid; }
+        const std::vector<MeshDraw>& getMeshes() const { return meshes; }
+        const std::vector<LightDraw>& getLights() const { return lights; }
+        const std::vector<TextDraw>& getTexts() const { return texts; }
+        const TextureCube* getSkybox() const { return skybox; }
+
+        /**
+         * Gets the copy of the bindless table taken with the draws, it is only copied again when the table version changes.
+         * @return The bindless table.
+         */
+        const BindlessTable& getBindlessTable() const { return bindlessTable; }
+
+    private:
+        void extractScene(const Scene& scene);
+
+        std::optional<Camera> camera;
+        std::vector<std::optional<Camera>> stageCameras;
+        std::vector<MeshDraw> meshes;
+        std::vector<LightDraw> lights;
+        std::vector<TextDraw> texts;
+        const TextureCube* skybox{ nullptr };
+        BindlessTable bindlessTable;
+        bool sceneValid{ false };
+    };
+}
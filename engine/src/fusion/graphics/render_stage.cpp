@@ -14,6 +14,7 @@ RenderStage::RenderStage(std::vector<Attachment>&& images, std::vector<SubpassTy
         : attachments{std::move(images)}
         , subpasses{std::move(subpasses)}
         , viewport{viewport}
+        , frameViewport{viewport}
         , subpassAttachmentCount(this->subpasses.size())
         , subpassMultisampled(this->subpasses.size()) {
 	for (const auto& image : attachments) {
@@ -50,16 +51,16 @@ RenderStage::RenderStage(std::vector<Attachment>&& images, std::vector<SubpassTy
 void RenderStage::update(size_t id, const Swapchain& swapchain) {
 	auto lastRenderArea = renderArea;
 
-	renderArea.offset = viewport.offset;
+	renderArea.offset = frameViewport.offset;
 
-	if (viewport.size)
-		renderArea.extent = viewport.scale * glm::vec2{*viewport.size};
+	if (frameViewport.size)
+		renderArea.extent = frameViewport.scale * glm::vec2{*frameViewport.size};
 	else
-		renderArea.extent = viewport.scale * glm::vec2{ vku::extent2D_cast(swapchain.getExtent()) };
+		renderArea.extent = frameViewport.scale * glm::vec2{ vku::extent2D_cast(swapchain.getExtent()) };
 
 	renderArea.extent += renderArea.offset;
 
-	outOfDate = renderArea != lastRenderArea;
+	outOfDate = renderArea != lastRenderArea || !framebuffers;
 }
 
 void RenderStage::rebuild(size_t id, const Swapchain& swapchain) {
@@ -74,8 +75,20 @@ void RenderStage::rebuild(size_t id, const Swapchain& swapchain) {
 
 	auto msaaSamples = physicalDevice.getMsaaSamples();
 
-	if (depthAttachment)
-		depthStencil = std::make_unique<TextureDepth>(renderArea.extent, depthAttachment->multisampled ? msaaSamples : VK_SAMPLE_COUNT_1_BIT);
+	// Old targets can still be used by frames in flight
+	if (framebuffers)
+		Graphics::Get()->retire(std::move(framebuffers));
+
+	if (depthStencil)
+		Graphics::Get()->retire(std::move(depthStencil));
+
+	if (depthAttachment) {
+		auto depthSamples = depthAttachment->multisampled ? msaaSamples : VK_SAMPLE_COUNT_1_BIT;
+		if (transientDepth)
+			depthStencil = Graphics::Get()->getRenderGraph().acquireTransientDepth(*this, renderArea.extent, depthSamples);
+		else
+			depthStencil = std::make_shared<TextureDepth>(renderArea.extent, depthSamples);
+	}
 
 	if (!renderpass)
 		renderpass = std::make_unique<Renderpass>(logicalDevice, *this, depthStencil ? depthStencil->getFormat() : VK_FORMAT_UNDEFINED, swapchain.getSurfaceFormat().format, msaaSamples);
@@ -97,6 +110,15 @@ void RenderStage::rebuild(size_t id, const Swapchain& swapchain) {
 #endif
 }
 
+void RenderStage::release() {
+	if (framebuffers)
+		Graphics::Get()->retire(std::move(framebuffers));
+	if (depthStencil)
+		Graphics::Get()->retire(std::move(depthStencil));
+
+	descriptors.clear();
+}
+
 std::optional<Attachment> RenderStage::getAttachment(const std::string& name) const {
 	auto it = std::find_if(attachments.begin(), attachments.end(), [name](const Attachment& a) {
 		return a.name == name;
@@ -64,6 +64,7 @@ namespace fe {
 
     class FUSION_API RenderStage {
         friend class Graphics;
+        friend class RenderGraph;
     public:
         explicit RenderStage(std::vector<Attachment>&& images = {}, std::vector<SubpassType>&& subpasses = {}, const Viewport& viewport = {});
         ~RenderStage() = default;
@@ -84,6 +85,20 @@ namespace fe {
         const Viewport& getViewport() { return viewport; }
         bool setViewport(const Viewport& port);
 
+        /**
+         * Gets the names of attachments from other stages which this stage samples, the render graph runs their producers first and keeps them alive.
+         * @return The read attachment names.
+         */
+        const std::vector<std::string>& getReads() const { return reads; }
+        void setReads(std::vector<std::string>&& names) { reads = std::move(names); }
+
+        /**
+         * Gets if the stage is requested to run, disabled stages are culled by the render graph and release their targets.
+         * @return If the stage is enabled.
+         */
+        bool isEnabled() const { return enabled; }
+        void setEnabled(bool flag) { enabled = flag; }
+
         Camera* getOverrideCamera() const { return overrideCamera.get(); }
         void setOverrideCamera(const std::shared_ptr<Camera>& camera) { overrideCamera = camera; }
 
@@ -106,17 +121,25 @@ namespace fe {
         uint32_t getAttachmentCount(uint32_t subpass) const { return subpassAttachmentCount[subpass]; }
         bool hasDepth() const { return depthAttachment.has_value(); }
         bool hasSwapchain() const { return swapchainAttachment.has_value(); }
+        bool isTransientDepth() const { return transientDepth; }
         bool isMultisampled(uint32_t subpass) const { return subpassMultisampled[subpass]; }
 
     private:
+        /**
+         * Frees the framebuffers and depth target once the frames in flight are done with them, the stage rebuilds on the next update.
+         */
+        void release();
+
         std::vector<Attachment> attachments;
         std::vector<SubpassType> subpasses;
+        std::vector<std::string> reads;
 
         Viewport viewport;
+        Viewport frameViewport; /// Copy of the viewport taken when the frame is extracted, it is read while recording.
         std::shared_ptr<Camera> overrideCamera;
 
         std::unique_ptr<Renderpass> renderpass;
-        std::unique_ptr<TextureDepth> depthStencil;
+        std::shared_ptr<TextureDepth> depthStencil; /// Transient depth targets are shared with other stages.
         std::unique_ptr<Framebuffers> framebuffers;
 
         fst::unordered_flatmap<std::string, const Descriptor*> descriptors;
@@ -129,5 +152,7 @@ namespace fe {
 
         RenderArea renderArea;
         bool outOfDate{ false };
+        bool enabled{ true };
+        bool transientDepth{ false }; /// Depth is not read after the pass, so it is not stored and its memory is aliased.
     };
 }
@@ -27,9 +27,12 @@ Renderpass::Renderpass(const LogicalDevice& logicalDevice, const RenderStage& re
             case Attachment::Type::Depth:
                 attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
                 attachmentDescription.format = depthFormat;
+                if (renderStage.isTransientDepth())
+                    attachmentDescription.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE; // Nobody reads it, memory is shared with other stages
                 break;
             case Attachment::Type::Swapchain:
-                attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+                // Offscreen images are never presented, they are only copied out
+                attachmentDescription.finalLayout = Graphics::Get()->isHeadless() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
                 attachmentDescription.format = surfaceFormat;
                 break;
 		}
@@ -70,31 +73,61 @@ Renderpass::Renderpass(const LogicalDevice& logicalDevice, const RenderStage& re
 		subpasses.push_back(std::make_unique<SubpassDescription>(VK_PIPELINE_BIND_POINT_GRAPHICS, std::move(subpassColorAttachments), depthAttachment, resolveAttachment));
 
 		// Subpass dependencies.
-		auto& subpassDependency = dependencies.emplace_back();
-		subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		subpassDependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		subpassDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		subpassDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		subpassDependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-		if (subpassType.binding == renderStage.getSubpasses().size()) {
-			subpassDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
-			subpassDependency.dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-			subpassDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subpassDependency.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-		} else {
+		if (subpassType.binding != 0) {
+			auto& subpassDependency = dependencies.emplace_back();
+			subpassDependency.srcSubpass = subpassType.binding - 1;
 			subpassDependency.dstSubpass = subpassType.binding;
+			subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			subpassDependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			subpassDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			subpassDependency.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			subpassDependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 		}
+	}
 
-		if (subpassType.binding == 0) {
-			subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-			subpassDependency.srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-			subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subpassDependency.srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-			subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		} else {
-			subpassDependency.srcSubpass = subpassType.binding - 1;
-		}
+	// External dependencies are derived from what the stage writes and what it samples, they replace manual barriers between stages.
+	bool hasDepth = renderStage.hasDepth();
+	bool hasReads = !renderStage.getReads().empty();
+	bool isSampled = std::any_of(renderStage.getAttachments().begin(), renderStage.getAttachments().end(), [](const Attachment& attachment) {
+		return attachment.type == Attachment::Type::Image && attachment.layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	});
+
+	// Waits for previous writers of the targets (aliased depth, last frame) and for the last reads of the sampled images
+	auto& beginDependency = dependencies.emplace_back();
+	beginDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+	beginDependency.dstSubpass = 0;
+	beginDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	beginDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	beginDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	beginDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	if (hasDepth) {
+		beginDependency.srcStageMask |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		beginDependency.dstStageMask |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+		beginDependency.srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		beginDependency.dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	}
+	if (isSampled)
+		beginDependency.srcStageMask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	if (hasReads) {
+		beginDependency.dstStageMask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		beginDependency.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+	}
+
+	// Makes the results visible to the stages which sample them
+	auto& endDependency = dependencies.emplace_back();
+	endDependency.srcSubpass = static_cast<uint32_t>(subpasses.size() - 1);
+	endDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+	endDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	endDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	if (hasDepth) {
+		endDependency.srcStageMask |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		endDependency.srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	}
+	endDependency.dstStageMask = isSampled ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	endDependency.dstAccessMask = isSampled ? VK_ACCESS_SHADER_READ_BIT : 0;
+	if (renderStage.hasSwapchain() && Graphics::Get()->isHeadless()) {
+		endDependency.dstStageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+		endDependency.dstAccessMask |= VK_ACCESS_TRANSFER_READ_BIT;
 	}
 
 	std::vector<VkSubpassDescription> subpassDescriptions;
@@ -94,18 +94,47 @@ Swapchain::Swapchain(const PhysicalDevice& physicalDevice, const LogicalDevice&
 	}
 }
 
+Swapchain::Swapchain(const LogicalDevice& logicalDevice, const VkExtent2D& extent, VkFormat format, uint32_t imageCount)
+        : logicalDevice{logicalDevice}
+        , extent{extent}
+        , imageCount{imageCount}
+        , surfaceFormat{format, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR}
+        , presentMode{VK_PRESENT_MODE_IMMEDIATE_KHR} {
+    images.resize(imageCount);
+    imageViews.resize(imageCount);
+    imageMemories.resize(imageCount);
+
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        Image::CreateImage(images[i], imageMemories[i], { extent.width, extent.height, 1 }, format, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_TILING_OPTIMAL,
+                           VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 1, 1, VK_IMAGE_TYPE_2D);
+        Image::CreateImageView(images[i], imageViews[i], VK_IMAGE_VIEW_TYPE_2D, format, VK_IMAGE_ASPECT_COLOR_BIT, 1, 0, 1, 0);
+    }
+}
+
 Swapchain::~Swapchain() {
 	vkDestroySwapchainKHR(logicalDevice, swapchain, nullptr);
 
 	for (const auto& imageView : imageViews) {
 		vkDestroyImageView(logicalDevice, imageView, nullptr);
 	}
+
+	// Offscreen images are owned by the swapchain
+	for (const auto& [index, memory] : enumerate(imageMemories)) {
+		vkDestroyImage(logicalDevice, images[index], nullptr);
+		vkFreeMemory(logicalDevice, memory, nullptr);
+	}
 }
 
 VkResult Swapchain::acquireNextImage(VkSemaphore presentCompleteSemaphore, VkFence fence) {
 	if (fence != VK_NULL_HANDLE)
 		VK_CHECK(vkWaitForFences(logicalDevice, 1, &fence, VK_TRUE, UINT64_MAX));
 
+	// Nothing signals the semaphore, the caller submits without waiting on it
+	if (isOffscreen()) {
+		activeImageIndex = (activeImageIndex + 1) % imageCount;
+		return VK_SUCCESS;
+	}
+
 	auto result = vkAcquireNextImageKHR(logicalDevice, swapchain, UINT64_MAX, presentCompleteSemaphore, VK_NULL_HANDLE, &activeImageIndex);
 
     if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
@@ -115,6 +144,9 @@ VkResult Swapchain::acquireNextImage(VkSemaphore presentCompleteSemaphore, VkFen
 }
 
 VkResult Swapchain::queuePresent(VkQueue presentQueue, VkSemaphore waitSemaphore) {
+    if (isOffscreen())
+        return VK_SUCCESS;
+
     VkPresentInfoKHR presentInfo = { VK_STRUCTURE_TYPE_PRESENT_INFO_KHR };
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = &swapchain;
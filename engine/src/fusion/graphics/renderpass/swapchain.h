@@ -8,6 +8,14 @@ namespace fe {
     class FUSION_API Swapchain {
     public:
         Swapchain(const PhysicalDevice& physicalDevice, const LogicalDevice& logicalDevice, const Surface& surface, const Swapchain* oldSwapchain = nullptr);
+        /**
+         * Creates offscreen images which are used in place of a surface, images are acquired in a ring and presenting them does nothing.
+         * @param logicalDevice The logical device.
+         * @param extent The size of the images.
+         * @param format The format of the images.
+         * @param imageCount The number of images.
+         */
+        Swapchain(const LogicalDevice& logicalDevice, const VkExtent2D& extent, VkFormat format, uint32_t imageCount);
         ~Swapchain();
         NONCOPYABLE(Swapchain);
 
@@ -27,6 +35,7 @@ namespace fe {
          */
         VkResult queuePresent(VkQueue presentQueue, VkSemaphore waitSemaphore = VK_NULL_HANDLE);
 
+        bool isOffscreen() const { return !imageMemories.empty(); }
         bool isSameExtent(const VkExtent2D& extent2D) { return extent.width == extent2D.width && extent.height == extent2D.height; }
 
         operator bool() const { return swapchain != VK_NULL_HANDLE; }
@@ -48,6 +57,7 @@ namespace fe {
         VkExtent2D extent;
         std::vector<VkImage> images;
         std::vector<VkImageView> imageViews;
+        std::vector<VkDeviceMemory> imageMemories; /// Memory of the offscreen images.
 
         uint32_t imageCount{ 0 };
         VkSwapchainKHR swapchain{ VK_NULL_HANDLE };
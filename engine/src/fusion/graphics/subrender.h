@@ -20,6 +20,14 @@ namespace fe {
         NONCOPYABLE(Subrender);
 
         Pipeline::Stage getStage() const { return stage; }
+        const std::string& getName() const { return name; }
+
+        /**
+         * Gets if the subrender only reads the render snapshot and its own state when rendering, so it can be recorded on the render thread
+         * while the scene is updated for the next frame.
+         * @return If the subrender is thread safe.
+         */
+        virtual bool isThreadSafe() const { return false; }
 
         bool isEnabled() const { return enabled; }
         void setEnabled(bool flag) {
@@ -58,5 +66,6 @@ namespace fe {
     protected:
         bool enabled{ true };
         Pipeline::Stage stage;
+        std::string name; /// Type name, set when the subrender is added to the holder.
     };
 }
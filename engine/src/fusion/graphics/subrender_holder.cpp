@@ -17,7 +17,8 @@ void SubrenderHolder::updateAll() {
     }
 }
 
-void SubrenderHolder::renderStage(Pipeline::Stage pipelineStage, const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
+void SubrenderHolder::renderStage(Pipeline::Stage pipelineStage, const CommandBuffer& commandBuffer, const Camera* overrideCamera, const RenderCallback& onRender) {
+    uint32_t index = 0;
 	for (const auto& [stageId, type] : stages) {
 		if (stageId != pipelineStage) {
 			continue;
@@ -25,8 +26,30 @@ void SubrenderHolder::renderStage(Pipeline::Stage pipelineStage, const CommandBu
 
         if (auto& subrender = subrenders[type.first][type.second]) {
             if (subrender->isEnabled()) {
+                if (onRender)
+                    onRender(*subrender, index, commandBuffer);
                 subrender->onRender(commandBuffer, overrideCamera);
             }
         }
+        ++index;
 	}
 }
+
+void SubrenderHolder::renderStage(Pipeline::Stage pipelineStage, const std::function<const CommandBuffer&()>& nextCommandBuffer, const Camera* overrideCamera, const RenderCallback& onRender) {
+    uint32_t index = 0;
+    for (const auto& [stageId, type] : stages) {
+        if (stageId != pipelineStage) {
+            continue;
+        }
+
+        if (auto& subrender = subrenders[type.first][type.second]) {
+            if (subrender->isEnabled()) {
+                const auto& commandBuffer = nextCommandBuffer();
+                if (onRender)
+                    onRender(*subrender, index, commandBuffer);
+                subrender->onRender(commandBuffer, overrideCamera);
+            }
+        }
+        ++index;
+    }
+}
@@ -62,6 +62,7 @@ namespace fe {
             stages.insert({ pipelineStage, { type, static_cast<uint32_t>(storage.size()) } });
 
             // Then, add the subrender
+            subrender->name = type_name<T>();
             auto& it = storage.emplace_back(std::move(subrender));
             return static_cast<T*>(it.get());
         }
@@ -98,6 +99,11 @@ namespace fe {
          */
         using SubrenderIndex = std::pair<type_index, uint32_t>;
 
+        /**
+         * Function which is called right before a subrender records, with the subrender, its position in the stage and the command buffer it records into.
+         */
+        using RenderCallback = std::function<void(const Subrender&, uint32_t, const CommandBuffer&)>;
+
         /**
          * Iterates through all subrenders for updating stages.
          */
@@ -108,8 +114,18 @@ namespace fe {
          * @param pipelineStage The subrender stage.
          * @param commandBuffer The command buffer to record render command into.
          * @param overrideCamera The optional camera for rendering.
+         * @param onRender The optional function called before every subrender.
+         */
+        void renderStage(Pipeline::Stage pipelineStage, const CommandBuffer& commandBuffer, const Camera* overrideCamera = nullptr, const RenderCallback& onRender = {});
+
+        /**
+         * Iterates through all subrenders for rendering, every subrender records into its own command buffer.
+         * @param pipelineStage The subrender stage.
+         * @param nextCommandBuffer The function which returns the command buffer for the next subrender.
+         * @param overrideCamera The optional camera for rendering.
+         * @param onRender The optional function called before every subrender.
          */
-        void renderStage(Pipeline::Stage pipelineStage, const CommandBuffer& commandBuffer, const Camera* overrideCamera = nullptr);
+        void renderStage(Pipeline::Stage pipelineStage, const std::function<const CommandBuffer&()>& nextCommandBuffer, const Camera* overrideCamera = nullptr, const RenderCallback& onRender = {});
 
         /// List of all subrenders
         fst::unordered_flatmap<type_index, std::vector<std::unique_ptr<Subrender>>> subrenders;
@@ -185,7 +185,12 @@ void Image::CreateImageView(VkImage image, VkImageView& imageView, VkImageViewTy
 void Image::CreateMipmaps(VkImage image, const VkExtent3D& extent, VkFormat format, VkImageLayout dstImageLayout,
                           uint32_t mipLevels, uint32_t baseArrayLayer, uint32_t layerCount) {
     CommandBuffer commandBuffer{true};
+    CreateMipmaps(commandBuffer, image, extent, format, dstImageLayout, mipLevels, baseArrayLayer, layerCount);
+    commandBuffer.submitIdle();
+}
 
+void Image::CreateMipmaps(VkCommandBuffer commandBuffer, VkImage image, const VkExtent3D& extent, VkFormat format, VkImageLayout dstImageLayout,
+                          uint32_t mipLevels, uint32_t baseArrayLayer, uint32_t layerCount) {
     const auto& physicalDevice = Graphics::Get()->getPhysicalDevice();
 
 	// Get device properites for the requested Image format.
@@ -255,14 +260,17 @@ void Image::CreateMipmaps(VkImage image, const VkExtent3D& extent, VkFormat form
 	barrier.subresourceRange.baseArrayLayer = baseArrayLayer;
 	barrier.subresourceRange.layerCount = layerCount;
 	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    commandBuffer.submitIdle();
 }
 
 void Image::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout srcImageLayout, VkImageLayout dstImageLayout, VkImageAspectFlags imageAspect,
                                   uint32_t mipLevels, uint32_t baseMipLevel, uint32_t layerCount, uint32_t baseArrayLayer) {
     CommandBuffer commandBuffer{true};
+    TransitionImageLayout(commandBuffer, image, format, srcImageLayout, dstImageLayout, imageAspect, mipLevels, baseMipLevel, layerCount, baseArrayLayer);
+    commandBuffer.submitIdle();
+}
 
+void Image::TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout srcImageLayout, VkImageLayout dstImageLayout, VkImageAspectFlags imageAspect,
+                                  uint32_t mipLevels, uint32_t baseMipLevel, uint32_t layerCount, uint32_t baseArrayLayer) {
     VkImageMemoryBarrier imageMemoryBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
     imageMemoryBarrier.oldLayout = srcImageLayout;
     imageMemoryBarrier.newLayout = dstImageLayout;
@@ -306,8 +314,6 @@ void Image::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout
     }
 
     vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-
-    commandBuffer.submitIdle();
 }
 
 void Image::InsertImageMemoryBarrier(VkCommandBuffer commandBuffer, VkImage image, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask, VkImageLayout oldImageLayout,
@@ -331,7 +337,11 @@ void Image::InsertImageMemoryBarrier(VkCommandBuffer commandBuffer, VkImage imag
 
 void Image::CopyBufferToImage(VkBuffer buffer, VkImage image, const VkExtent3D& extent, uint32_t layerCount, uint32_t baseArrayLayer) {
     CommandBuffer commandBuffer{true};
+    CopyBufferToImage(commandBuffer, buffer, image, extent, layerCount, baseArrayLayer);
+    commandBuffer.submitIdle();
+}
 
+void Image::CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image, const VkExtent3D& extent, uint32_t layerCount, uint32_t baseArrayLayer) {
 	VkBufferImageCopy region = {};
 	region.bufferOffset = 0;
 	region.bufferRowLength = 0;
@@ -343,8 +353,6 @@ void Image::CopyBufferToImage(VkBuffer buffer, VkImage image, const VkExtent3D&
 	region.imageOffset = {0, 0, 0};
 	region.imageExtent = extent;
 	vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    commandBuffer.submitIdle();
 }
 
 bool Image::CopyImage(VkImage srcImage, VkImage& dstImage, VkDeviceMemory& dstImageMemory, VkFormat srcFormat, VkFormat dstFormat,
@@ -127,7 +127,29 @@ namespace fe {
                 uint32_t baseArrayLayer,
                 uint32_t layerCount);
 
+        static void CreateMipmaps(
+                VkCommandBuffer commandBuffer,
+                VkImage image,
+                const VkExtent3D& extent,
+                VkFormat format,
+                VkImageLayout dstImageLayout,
+                uint32_t mipLevels,
+                uint32_t baseArrayLayer,
+                uint32_t layerCount);
+
+        static void TransitionImageLayout(
+                VkImage image,
+                VkFormat format,
+                VkImageLayout srcImageLayout,
+                VkImageLayout dstImageLayout,
+                VkImageAspectFlags imageAspect,
+                uint32_t mipLevels,
+                uint32_t baseMipLevel,
+                uint32_t layerCount,
+                uint32_t baseArrayLayer);
+
         static void TransitionImageLayout(
+                VkCommandBuffer commandBuffer,
                 VkImage image,
                 VkFormat format,
                 VkImageLayout srcImageLayout,
@@ -160,6 +182,14 @@ namespace fe {
                 uint32_t layerCount,
                 uint32_t baseArrayLayer);
 
+        static void CopyBufferToImage(
+                VkCommandBuffer commandBuffer,
+                VkBuffer buffer,
+                VkImage image,
+                const VkExtent3D& extent,
+                uint32_t layerCount,
+                uint32_t baseArrayLayer);
+
         static bool CopyImage(
                 VkImage srcImage,
                 VkImage& dstImage,
@@ -2,6 +2,7 @@
 
 #include "fusion/bitmaps/bitmap.h"
 #include "fusion/graphics/buffers/buffer.h"
+#include "fusion/graphics/graphics.h"
 
 using namespace fe;
 
@@ -86,6 +87,26 @@ void Texture::setPixels(gsl::span<const uint8_t> pixels, uint32_t layerCount, ui
     CopyBufferToImage(bufferStaging, image, extent, layerCount, baseArrayLayer);
 }
 
+Texture::~Texture() {
+    if (bindlessIndex != -1)
+        Graphics::Get()->getBindlessRegistry().release(bindlessIndex);
+}
+
+uint64_t Texture::getMemorySize() const {
+    if (memorySize == 0 && image != VK_NULL_HANDLE) {
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(Graphics::Get()->getLogicalDevice(), image, &memoryRequirements);
+        memorySize = memoryRequirements.size;
+    }
+    return memorySize;
+}
+
+int32_t Texture::getBindlessIndex() const {
+    if (bindlessIndex == -1 && *this)
+        bindlessIndex = Graphics::Get()->getBindlessRegistry().acquire(this);
+    return bindlessIndex;
+}
+
 WriteDescriptorSet Texture::getWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize>& offsetSize) const {
     VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
     descriptorWrite.dstSet = VK_NULL_HANDLE; // Will be set in the descriptor handler.
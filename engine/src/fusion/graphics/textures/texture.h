@@ -130,11 +130,19 @@ namespace fe {
                 bool anisotropic,
                 bool mipmap);
 
-        ~Texture() override = default;
+        ~Texture() override;
 
         WriteDescriptorSet getWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize>& offsetSize) const override;
         const VkDescriptorImageInfo& getDescriptor() const { return descriptor; }
 
+        /**
+         * Gets the slot of the texture in the global bindless table, a slot is assigned on first use and stays the same until the texture is destroyed.
+         * Must be called from the main thread, the render thread reads the slots resolved into the {@link RenderSnapshot}.
+         * The slot can be sampled right away, so it must not be taken before the image content was uploaded, for loaded textures once they are ready.
+         * @return The slot index or -1 if the table is full.
+         */
+        int32_t getBindlessIndex() const;
+
         uint32_t getMipLevels() const { return mipLevels; }
         uint32_t getArrayLevels() const { return arrayLayers; }
 
@@ -170,6 +178,7 @@ namespace fe {
         const fs::path& getPath() const override { return path; }
         bool isLoaded() const override { return loaded; };
         bool isInternal() const override { return internal; };
+        uint64_t getMemorySize() const override;
 
         /*bool operator==(const Texture& rhs) const {
             //if (!Image::operator==(rhs)) return false;
@@ -198,6 +207,8 @@ namespace fe {
         uint32_t arrayLayers{ 0 };
         bool anisotropic{ false };
         bool mipmap{ false };
+        mutable int32_t bindlessIndex{ -1 };
+        mutable VkDeviceSize memorySize{ 0 };
         bool loaded{ false };
         bool internal{ false };
     };
@@ -3,7 +3,7 @@
 #include "fusion/core/engine.h"
 #include "fusion/assets/asset_registry.h"
 #include "fusion/bitmaps/bitmap.h"
-#include "fusion/graphics/buffers/buffer.h"
+#include "fusion/graphics/buffers/upload_batch.h"
 #include "fusion/filesystem/file_format.h"
 #include "fusion/filesystem/file_system.h"
 
@@ -91,26 +91,63 @@ void Texture2d::loadFromFile() {
         return;
     }
 
+    if (!decode()) {
+        setState(AssetState::Failed);
+        return;
+    }
+
+    UploadBatch batch;
+    upload(batch);
+    batch.submit();
+    batch.wait();
+
+    setState(AssetState::Ready);
+}
+
+fs::path Texture2d::getSourcePath() const {
+    auto op = AssetRegistry::Get()->getDatabase()->getValue(uuid);
+    if (!op.has_value())
+        return {};
+    return Engine::Get()->getApp()->getProjectSettings().projectRoot / *op; // get full path
+}
+
+bool Texture2d::decode() {
     auto op = AssetRegistry::Get()->getDatabase()->getValue(uuid);
     if (!op.has_value()) {
         FE_LOG_ERROR("Texture2d: [{}] is not valid", uuid);
-        return;
+        return false;
     }
 
-    path = std::move(*op);
-    name = path.filename().replace_extension().string();
+    fs::path filepath{ Engine::Get()->getApp()->getProjectSettings().projectRoot / *op }; // get full path
+
+    bool result = false;
+    FileSystem::ReadBytes(filepath, [&](gsl::span<const uint8_t> buffer) {
+        result = decodeImage(std::move(*op), filepath, buffer);
+    });
+    return result;
+}
+
+bool Texture2d::decodeFrom(gsl::span<const uint8_t> source) {
+    auto op = AssetRegistry::Get()->getDatabase()->getValue(uuid);
+    if (!op.has_value()) {
+        FE_LOG_ERROR("Texture2d: [{}] is not valid", uuid);
+        return false;
+    }
+
+    fs::path filepath{ Engine::Get()->getApp()->getProjectSettings().projectRoot / *op }; // get full path
+    return decodeImage(std::move(*op), filepath, source);
+}
 
-    fs::path filepath{ Engine::Get()->getApp()->getProjectSettings().projectRoot / path }; // get full path
+bool Texture2d::decodeImage(fs::path&& shortPath, const fs::path& filepath, gsl::span<const uint8_t> buffer) {
+    decoded = std::make_unique<DecodedImage>();
+    decoded->path = std::move(shortPath);
 
     // That is fast loading approach
     if (FileFormat::IsTextureStorageFile(filepath)) {
 #if FUSION_DEBUG
         auto debugStart = DateTime::Now();
 #endif
-        gli::texture2d texture;
-        FileSystem::ReadBytes(filepath, [&texture](gsl::span<const uint8_t> buffer) {
-            texture = gli::texture2d{gli::load(reinterpret_cast<const char*>(buffer.data()), buffer.size())};
-        });
+        gli::texture2d texture{gli::load(reinterpret_cast<const char*>(buffer.data()), buffer.size())};
 
         if (texture.empty())
             throw std::runtime_error("Texture is empty");
@@ -119,48 +156,61 @@ void Texture2d::loadFromFile() {
         FE_LOG_DEBUG("Texture2d '{}' loaded in {}ms", filepath, (DateTime::Now() - debugStart).asMilliseconds<float>());
 #endif
 
-        extent.width = static_cast<uint32_t>(texture.extent().x);
-        extent.height = static_cast<uint32_t>(texture.extent().y);
-        // arrayLayers = 1
-        mipLevels = static_cast<uint32_t>(texture.levels());
-        format = vku::convert_format(texture.format());
+        decoded->extent = { static_cast<uint32_t>(texture.extent().x), static_cast<uint32_t>(texture.extent().y), 1 };
+        decoded->mipLevels = static_cast<uint32_t>(texture.levels());
+        decoded->format = vku::convert_format(texture.format());
+        decoded->imageType = vku::convert_type(texture.target());
 
-        if (extent.width == 0 || extent.height == 0)
-            throw std::runtime_error("Width or height is empty");
+        auto data = static_cast<const uint8_t*>(texture.data());
+        decoded->pixels.assign(data, data + texture.size());
+    } else {
+        auto loadBitmap = std::make_unique<Bitmap>(buffer, filepath);
+        decoded->extent = vku::uvec3_cast(loadBitmap->getExtent());
+        decoded->mipLevels = mipmap ? GetMipLevels(decoded->extent) : 1;
+        decoded->format = loadBitmap->getFormat();
+        decoded->imageType = VK_IMAGE_TYPE_2D;
+
+        auto data = loadBitmap->getData<uint8_t>();
+        decoded->pixels.assign(data, data + loadBitmap->getLength() * arrayLayers);
+    }
 
-        CreateImage(image, memory, extent, format, samples, VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipLevels, arrayLayers, vku::convert_type(texture.target()));
-        CreateImageSampler(sampler, filter, addressMode, anisotropic, mipLevels);
-        CreateImageView(image, view, viewType, format, aspect, mipLevels, 0, arrayLayers, 0);
+    if (decoded->extent.width == 0 || decoded->extent.height == 0)
+        throw std::runtime_error("Width or height is empty");
 
-        TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, aspect, mipLevels, 0, arrayLayers, 0);
-        Buffer bufferStaging{texture.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, texture.data()};
-        CopyBufferToImage(bufferStaging, image, extent, arrayLayers, 0);
-    } else {
-        auto loadBitmap = std::make_unique<Bitmap>(filepath);
-        extent =  vku::uvec3_cast(loadBitmap->getExtent());
-        format = loadBitmap->getFormat();
+    return true;
+}
 
-        if (extent.width == 0 || extent.height == 0)
-            throw std::runtime_error("Width or height is empty");
+void Texture2d::upload(UploadBatch& batch) {
+    if (loaded || !decoded)
+        return;
 
-        mipLevels = mipmap ? GetMipLevels(extent) : 1;
+    path = std::move(decoded->path);
+    name = path.filename().replace_extension().string();
+    extent = decoded->extent;
+    // arrayLayers = 1
+    mipLevels = decoded->mipLevels;
+    format = decoded->format;
 
-        CreateImage(image, memory, extent, format, samples, VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipLevels, arrayLayers, VK_IMAGE_TYPE_2D);
-        CreateImageSampler(sampler, filter, addressMode, anisotropic, mipLevels);
-        CreateImageView(image, view, viewType, format, aspect, mipLevels, 0, arrayLayers, 0);
+    const auto& commandBuffer = batch.getCommandBuffer();
 
-        TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, aspect, mipLevels, 0, arrayLayers, 0);
-        Buffer bufferStaging{loadBitmap->getLength() * arrayLayers, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, loadBitmap->getData<void>()};
-        CopyBufferToImage(bufferStaging, image, extent, arrayLayers, 0);
-    }
+    CreateImage(image, memory, extent, format, samples, VK_IMAGE_TILING_OPTIMAL, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipLevels, arrayLayers, decoded->imageType);
+    CreateImageSampler(sampler, filter, addressMode, anisotropic, mipLevels);
+    CreateImageView(image, view, viewType, format, aspect, mipLevels, 0, arrayLayers, 0);
+
+    TransitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, aspect, mipLevels, 0, arrayLayers, 0);
+    const auto& bufferStaging = batch.stage(decoded->pixels.size(), decoded->pixels.data());
+    CopyBufferToImage(commandBuffer, bufferStaging, image, extent, arrayLayers, 0);
 
     if (mipmap) {
-        CreateMipmaps(image, extent, format, layout, mipLevels, 0, arrayLayers);
+        CreateMipmaps(commandBuffer, image, extent, format, layout, mipLevels, 0, arrayLayers);
     } else {
-        TransitionImageLayout(image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout, aspect, mipLevels, 0, arrayLayers, 0);
+        TransitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, layout, aspect, mipLevels, 0, arrayLayers, 0);
     }
 
+    decoded.reset();
+
     updateDescriptor();
 
+    // Bindless slot is taken by the first draw after the batch completed, the image is still being copied here
     loaded = true;
-}
\ No newline at end of file
+}
@@ -99,7 +99,34 @@ namespace fe {
         void load() override { loadFromFile(); };
         void unload() override { loaded = false; /*TODO: implement unload/reload feature*/ }
 
+        fs::path getSourcePath() const override;
+        bool decode() override;
+        bool decodeFrom(gsl::span<const uint8_t> source) override;
+        void upload(UploadBatch& batch) override;
+
     private:
         void loadFromFile();
+
+        /**
+         * Decodes the pixels of an image file.
+         * @param shortPath The path in the project folder.
+         * @param filepath The full path, the format is chosen by its extension.
+         * @param buffer The content of the file.
+         * @return If the image was decoded.
+         */
+        bool decodeImage(fs::path&& shortPath, const fs::path& filepath, gsl::span<const uint8_t> buffer);
+
+        /**
+         * Pixels read by {@link Texture2d#decode} which wait for the upload.
+         */
+        struct DecodedImage {
+            fs::path path;
+            std::vector<uint8_t> pixels;
+            VkExtent3D extent{ 0, 0, 1 };
+            VkFormat format{ VK_FORMAT_UNDEFINED };
+            VkImageType imageType{ VK_IMAGE_TYPE_2D };
+            uint32_t mipLevels{ 1 };
+        };
+        std::unique_ptr<DecodedImage> decoded;
     };
 }
@@ -0,0 +1,83 @@
+#include "render_queue.h"
+
+using namespace fe;
+
+static uint64_t QuantizeDepth(float depth) {
+    // Bits of positive floats are ordered the same way as values, the top 20 bits keep exponent and part of mantissa
+    uint32_t bits;
+    depth = std::max(depth, 0.0f);
+    std::memcpy(&bits, &depth, sizeof(float));
+    return (bits >> 11) & 0xFFFFF;
+}
+
+uint64_t RenderQueue::OpaqueKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+    return (static_cast<uint64_t>(pass & 0xF) << 60) |
+           (static_cast<uint64_t>(pipeline & 0xFF) << 52) |
+           (static_cast<uint64_t>(material & 0xFFFF) << 36) |
+           (static_cast<uint64_t>(mesh & 0xFFFF) << 20) |
+           QuantizeDepth(depth);
+}
+
+uint64_t RenderQueue::TranslucentKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) {
+    return (static_cast<uint64_t>(pass & 0xF) << 60) |
+           ((0xFFFFF - QuantizeDepth(depth)) << 40) |
+           (static_cast<uint64_t>(pipeline & 0xFF) << 32) |
+           (static_cast<uint64_t>(material & 0xFFFF) << 16) |
+           static_cast<uint64_t>(mesh & 0xFFFF);
+}
+
+uint32_t RenderQueue::PointerId(const void* pointer) {
+    auto value = reinterpret_cast<uintptr_t>(pointer) >> 4;
+    return static_cast<uint32_t>((value ^ (value >> 16)) & 0xFFFF);
+}
+
+void RenderQueue::sort() {
+    if (items.size() < 2)
+        return;
+
+    // Small queues are faster with a comparison sort
+    if (items.size() <= 64) {
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return a.key < b.key;
+        });
+        return;
+    }
+
+    // Builds histograms of all byte passes in one sweep
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (const auto& item : items) {
+        for (size_t pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(item.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    scratch.resize(items.size());
+
+    auto* src = &items;
+    auto* dst = &scratch;
+
+    for (size_t pass = 0; pass < 8; ++pass) {
+        auto& histogram = histograms[pass];
+
+        // All keys share the byte, the pass would not change the order
+        auto first = (src->front().key >> (pass * 8)) & 0xFF;
+        if (histogram[first] == items.size())
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& count : histogram) {
+            auto value = count;
+            count = offset;
+            offset += value;
+        }
+
+        for (const auto& item : *src) {
+            (*dst)[histogram[(item.key >> (pass * 8)) & 0xFF]++] = item;
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src != &items)
+        items.swap(scratch);
+}
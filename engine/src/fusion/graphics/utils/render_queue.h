@@ -0,0 +1,67 @@
+#pragma once
+
+namespace fe {
+    /**
+     * @brief List of visible draws which are submitted in the order of compact 64-bit sort keys.
+     * Keys group draws by pass, pipeline, material and mesh to reduce state changes, while payloads point back to the draw data of the subrender.
+     * Sorting happens on the queue, so storages of the registry are never reordered.
+     */
+    class FUSION_API RenderQueue {
+    public:
+        struct Item {
+            uint64_t key;
+            uint32_t payload;
+        };
+
+        RenderQueue() = default;
+        ~RenderQueue() = default;
+
+        void clear() { items.clear(); }
+        void reserve(size_t size) { items.reserve(size); }
+        void push(uint64_t key, uint32_t payload) { items.push_back({ key, payload }); }
+
+        /**
+         * Sorts the items by key with a LSD radix sort, byte passes which are the same for every key are skipped.
+         */
+        void sort();
+
+        bool empty() const { return items.empty(); }
+        size_t size() const { return items.size(); }
+        std::vector<Item>::const_iterator begin() const { return items.begin(); }
+        std::vector<Item>::const_iterator end() const { return items.end(); }
+
+        /**
+         * Creates a key for opaque draws: pass(4) | pipeline(8) | material(16) | mesh(16) | depth(20), draws are grouped by state and sorted front to back inside a group.
+         * @param pass The pass index.
+         * @param pipeline The pipeline index within the pass.
+         * @param material The material or texture slot.
+         * @param mesh The mesh identifier.
+         * @param depth The distance to the camera, must be positive.
+         * @return The sort key.
+         */
+        static uint64_t OpaqueKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+
+        /**
+         * Creates a key for translucent draws: pass(4) | inverted depth(20) | pipeline(8) | material(16) | mesh(16), draws are sorted back to front
+         * and only equal depths are grouped by state.
+         * @param pass The pass index.
+         * @param pipeline The pipeline index within the pass.
+         * @param material The material or texture slot.
+         * @param mesh The mesh identifier.
+         * @param depth The distance to the camera, must be positive.
+         * @return The sort key.
+         */
+        static uint64_t TranslucentKey(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth);
+
+        /**
+         * Creates a compact identifier from a pointer, collisions only reduce batching.
+         * @param pointer The pointer to the object.
+         * @return The identifier.
+         */
+        static uint32_t PointerId(const void* pointer);
+
+    private:
+        std::vector<Item> items;
+        std::vector<Item> scratch;
+    };
+}
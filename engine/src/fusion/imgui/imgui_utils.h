@@ -586,7 +586,10 @@ namespace ImGuiUtils {
 
             ImGui::BeginChild("AssetExplorer", ImVec2{300.0f, 500.0f});
 
-            for (const auto& [key, asset] : AssetRegistry::Get()->getAssets<T>()) {
+            for (const auto& slot : AssetRegistry::Get()->getAssets<T>().slots) {
+                const auto& asset = slot.asset;
+                if (!asset)
+                    continue;
                 if (filter.IsActive() && !filter.PassFilter(asset->getName().c_str()))
                     continue;
 
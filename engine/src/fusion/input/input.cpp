@@ -19,6 +19,9 @@ Input::~Input() {
 void Input::onStart() {
     // Set the window events callbacks.
     auto window = DeviceManager::Get()->getWindow(0);
+    if (!window)
+        return;
+
     window->OnMouseButton().connect<&Input::onMouseButton>(this);
     window->OnMouseMotion().connect<&Input::onMouseMotion>(this);
     window->OnMouseScroll().connect<&Input::onMouseScroll>(this);
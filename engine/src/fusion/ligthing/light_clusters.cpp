@@ -0,0 +1,193 @@
+#include "light_clusters.h"
+
+#include "fusion/core/thread_pool.h"
+#include "fusion/graphics/cameras/camera.h"
+
+using namespace fe;
+
+static uint32_t GetTile(float ndc, uint32_t count) {
+    auto tile = static_cast<int32_t>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(count)));
+    return static_cast<uint32_t>(std::clamp(tile, 0, static_cast<int32_t>(count) - 1));
+}
+
+static void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function) {
+    if (auto threadPool = ThreadPool::Get())
+        threadPool->parallelFor(count, grainSize, function);
+    else
+        function(0, count);
+}
+
+void LightClusters::clear() {
+    lights.clear();
+    localLights.clear();
+    ranges.clear();
+    directionalCount = 0;
+}
+
+void LightClusters::addDirectional(const Light& light) {
+    if (lights.size() + localLights.size() >= MAX_LIGHTS)
+        return;
+
+    lights.push_back(light);
+    ++directionalCount;
+}
+
+void LightClusters::addLocal(const Light& light, float range) {
+    if (lights.size() + localLights.size() >= MAX_LIGHTS)
+        return;
+
+    localLights.push_back(light);
+    ranges.push_back(range);
+}
+
+void LightClusters::build(const Camera& camera) {
+    static const uint32_t tileCount = GRID_X * GRID_Y;
+    static const uint32_t clusterCount = tileCount * GRID_Z;
+
+    nearClip = camera.getNearClip();
+    farClip = camera.getFarClip();
+
+    // Exponential slices keep clusters roughly cubic in perspective, orthographic depth is spread evenly
+    bool perspective = !camera.isOrthographic() && nearClip > 0.0f;
+    float scale = perspective ?
+            static_cast<float>(GRID_Z) / std::log(farClip / nearClip) :
+            static_cast<float>(GRID_Z) / std::max(farClip - nearClip, FLT_EPSILON);
+    clusterParams = { nearClip, scale, perspective ? 0.0f : 1.0f, 0.0f };
+
+    lights.resize(directionalCount);
+    lights.insert(lights.end(), localLights.begin(), localLights.end());
+
+    const auto& view = camera.getViewMatrix();
+    const auto& projection = camera.getProjectionMatrix();
+
+    bounds.resize(localLights.size());
+    ParallelFor(localLights.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bounds[i] = calculateBounds(view, projection, perspective, localLights[i], ranges[i]);
+        }
+    });
+
+    clusterData.resize(2 * clusterCount);
+
+    // Every slice owns its part of the grid, so slices are filled without locks
+    ParallelFor(GRID_Z, 1, [&](size_t begin, size_t end) {
+        std::array<uint32_t, tileCount> counts;
+
+        for (size_t z = begin; z < end; ++z) {
+            counts.fill(0);
+
+            for (const auto& b : bounds) {
+                if (!b.visible || z < b.min.z || z > b.max.z)
+                    continue;
+                for (uint32_t y = b.min.y; y <= b.max.y; ++y) {
+                    for (uint32_t x = b.min.x; x <= b.max.x; ++x) {
+                        ++counts[y * GRID_X + x];
+                    }
+                }
+            }
+
+            auto grid = &clusterData[2 * z * tileCount];
+            uint32_t offset = 0;
+            for (uint32_t t = 0; t < tileCount; ++t) {
+                grid[2 * t] = offset;
+                grid[2 * t + 1] = 0;
+                offset += std::min(counts[t], MAX_LIGHTS_PER_CLUSTER);
+            }
+
+            auto& indices = sliceIndices[z];
+            indices.resize(offset);
+            sliceSizes[z] = offset;
+
+            for (size_t i = 0; i < bounds.size(); ++i) {
+                const auto& b = bounds[i];
+                if (!b.visible || z < b.min.z || z > b.max.z)
+                    continue;
+                for (uint32_t y = b.min.y; y <= b.max.y; ++y) {
+                    for (uint32_t x = b.min.x; x <= b.max.x; ++x) {
+                        auto t = y * GRID_X + x;
+                        auto& count = grid[2 * t + 1];
+                        if (count < MAX_LIGHTS_PER_CLUSTER)
+                            indices[grid[2 * t] + count++] = directionalCount + static_cast<uint32_t>(i);
+                    }
+                }
+            }
+        }
+    });
+
+    // Makes offsets relative to the start of the buffer and appends the index lists after the grid
+    uint32_t base = 2 * clusterCount;
+    for (uint32_t z = 0; z < GRID_Z; ++z) {
+        auto grid = &clusterData[2 * z * tileCount];
+        for (uint32_t t = 0; t < tileCount; ++t) {
+            grid[2 * t] += base;
+        }
+        base += sliceSizes[z];
+    }
+
+    clusterData.resize(base);
+
+    auto data = clusterData.data() + 2 * clusterCount;
+    for (uint32_t z = 0; z < GRID_Z; ++z) {
+        std::copy(sliceIndices[z].begin(), sliceIndices[z].end(), data);
+        data += sliceSizes[z];
+    }
+}
+
+LightClusters::Bounds LightClusters::calculateBounds(const glm::mat4& view, const glm::mat4& projection, bool perspective, const Light& light, float range) const {
+    Bounds result{ glm::uvec3{ 0 }, glm::uvec3{ GRID_X - 1, GRID_Y - 1, GRID_Z - 1 }, false };
+
+    glm::vec3 center{ view * glm::vec4{light.position, 1.0f} };
+    float depth = -center.z;
+
+    if (depth + range < nearClip || depth - range > farClip)
+        return result;
+
+    result.min.z = getSlice(std::max(depth - range, nearClip));
+    result.max.z = getSlice(std::min(depth + range, farClip));
+
+    // Spheres crossing the near plane can not be projected, they cover the whole screen
+    if (!std::isfinite(range) || (perspective && depth - range <= nearClip)) {
+        result.visible = true;
+        return result;
+    }
+
+    glm::vec2 ndcMin{ FLT_MAX };
+    glm::vec2 ndcMax{ -FLT_MAX };
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        glm::vec3 corner{ center.x + (i & 1 ? range : -range), center.y + (i & 2 ? range : -range), center.z + (i & 4 ? range : -range) };
+        glm::vec4 clip{ projection * glm::vec4{corner, 1.0f} };
+        glm::vec2 ndc{ clip.x / clip.w, clip.y / clip.w };
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+        return result;
+
+    result.min.x = GetTile(ndcMin.x, GRID_X);
+    result.min.y = GetTile(ndcMin.y, GRID_Y);
+    result.max.x = GetTile(ndcMax.x, GRID_X);
+    result.max.y = GetTile(ndcMax.y, GRID_Y);
+    result.visible = true;
+    return result;
+}
+
+uint32_t LightClusters::getSlice(float depth) const {
+    float slice = clusterParams.z > 0.0f ?
+            (depth - clusterParams.x) * clusterParams.y :
+            std::log(depth / clusterParams.x) * clusterParams.y;
+    return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GRID_Z - 1)));
+}
+
+float LightClusters::CalculateRange(float constant, float linear, float quadratic, float intensity) {
+    // Solves constant + linear * d + quadratic * d^2 = 256 * intensity
+    float c = constant - 256.0f * intensity;
+    if (c >= 0.0f)
+        return 0.0f;
+    if (quadratic > FLT_EPSILON)
+        return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic);
+    if (linear > FLT_EPSILON)
+        return -c / linear;
+    return std::numeric_limits<float>::infinity();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+namespace fe {
+    class Camera;
+    /**
+     * @brief Assigns local lights to the cells of a froxel grid (screen tiles split into exponential depth slices),
+     * so fragments only visit lights that can reach their cell. Directional lights reach everything and are kept apart.
+     */
+    class FUSION_API LightClusters {
+    public:
+        static constexpr uint32_t GRID_X = 16;
+        static constexpr uint32_t GRID_Y = 9;
+        static constexpr uint32_t GRID_Z = 24;
+        static constexpr uint32_t MAX_LIGHTS = 4096;
+        static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 64;
+
+        struct/* FUSION_MEM_ALIGN*/ Light {
+            glm::vec3 position{ 0.0f };
+            float cutOff{ 0.0f };
+            glm::vec3 direction{ 0.0f };
+            float outerCutOff{ 0.0f };
+            glm::vec3 ambient{ 0.0f };
+            float constant{ 0.0f };
+            glm::vec3 diffuse{ 0.0f };
+            float linear{ 0.0f };
+            glm::vec3 specular{ 0.0f };
+            float quadratic{ 0.0f };
+        };
+
+        LightClusters() = default;
+        ~LightClusters() = default;
+        NONCOPYABLE(LightClusters);
+
+        void clear();
+
+        /**
+         * Adds a light which reaches every fragment.
+         * @param light The light to add.
+         */
+        void addDirectional(const Light& light);
+
+        /**
+         * Adds a point or spot light.
+         * @param light The light to add.
+         * @param range The distance where the light stops contributing.
+         */
+        void addLocal(const Light& light, float range);
+
+        /**
+         * Assigns the local lights to the clusters of the camera view, the work is split over the thread pool.
+         * @param camera The camera to build the grid for.
+         */
+        void build(const Camera& camera);
+
+        /**
+         * Gets all lights, directional ones go first.
+         * @return The light array.
+         */
+        const std::vector<Light>& getLights() const { return lights; }
+        uint32_t getDirectionalCount() const { return directionalCount; }
+
+        /**
+         * Gets the cluster buffer: (offset, count) pair per cluster followed by the light indices the pairs point to.
+         * @return The cluster array.
+         */
+        const std::vector<uint32_t>& getClusterData() const { return clusterData; }
+
+        /**
+         * Gets the grid dimensions in xyz and total number of clusters in w.
+         * @return The grid size.
+         */
+        glm::uvec4 getClusterSize() const { return { GRID_X, GRID_Y, GRID_Z, GRID_X * GRID_Y * GRID_Z }; }
+
+        /**
+         * Gets the parameters used to find the depth slice: near plane, slice scale, and if slices are linear.
+         * @return The slice parameters.
+         */
+        const glm::vec4& getClusterParams() const { return clusterParams; }
+
+        /**
+         * Calculates the distance where the light contribution falls below one step of 8 bit color.
+         * @param constant The constant attenuation.
+         * @param linear The linear attenuation.
+         * @param quadratic The quadratic attenuation.
+         * @param intensity The brightest color channel of the light.
+         * @return The distance or infinity if the light never fades.
+         */
+        static float CalculateRange(float constant, float linear, float quadratic, float intensity);
+
+    private:
+        struct Bounds {
+            glm::uvec3 min;
+            glm::uvec3 max;
+            bool visible;
+        };
+
+        Bounds calculateBounds(const glm::mat4& view, const glm::mat4& projection, bool perspective, const Light& light, float range) const;
+        uint32_t getSlice(float depth) const;
+
+        std::vector<Light> lights;
+        std::vector<Light> localLights;
+        std::vector<float> ranges;
+        std::vector<Bounds> bounds;
+        std::array<std::vector<uint32_t>, GRID_Z> sliceIndices;
+        std::array<uint32_t, GRID_Z> sliceSizes{};
+        std::vector<uint32_t> clusterData;
+        glm::vec4 clusterParams{ 0.0f };
+        uint32_t directionalCount{ 0 };
+        float nearClip{ 0.0f };
+        float farClip{ 0.0f };
+    };
+}
@@ -1,8 +1,8 @@
 #include "light_subrender.h"
 
+#include "fusion/graphics/graphics.h"
 #include "fusion/graphics/commands/command_buffer.h"
-#include "fusion/scene/scene_manager.h"
-#include "fusion/scene/components.h"
+#include "fusion/graphics/render_snapshot.h"
 
 using namespace fe;
 
@@ -18,23 +18,33 @@ LightSubrender::LightSubrender(Pipeline::Stage pipelineStage)
                    VK_CULL_MODE_FRONT_BIT,
                    VK_FRONT_FACE_CLOCKWISE}
         , descriptorSet{pipeline} {
+    const auto& shader = pipeline.getShader();
+    uniformObjectHandle = shader.getDescriptorHandle("UniformObject");
+    pushObjectHandle = shader.getDescriptorHandle("PushObject");
+    colorHandle = shader.getUniformHandle("PushObject", "color");
+    positionHandle = shader.getUniformHandle("PushObject", "position");
 }
 
 void LightSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
-    auto scene = SceneManager::Get()->getScene();
-    if (!scene)
+    const auto& snapshot = Graphics::Get()->getSnapshot();
+    if (!snapshot.hasScene())
         return;
 
-    auto camera = overrideCamera ? overrideCamera : scene->getCamera();
+    auto camera = overrideCamera ? overrideCamera : snapshot.getCamera();
     if (!camera)
         return;
 
-    auto& registry = scene->getRegistry();
-
     // Update uniforms
-    uniformObject.push("projection", camera->getProjectionMatrix());
-    uniformObject.push("view", camera->getViewMatrix());
-    descriptorSet.push("UniformObject", uniformObject);
+    UniformObject uniformObject = {};
+    uniformObject.projection = camera->getProjectionMatrix();
+    uniformObject.view = camera->getViewMatrix();
+
+    auto& frameAllocator = Graphics::Get()->getFrameAllocator();
+    auto allocationObject = frameAllocator.allocate(uniformObject);
+    if (!allocationObject)
+        return;
+
+    descriptorSet.push(uniformObjectHandle, frameAllocator, allocationObject);
 
     if (!descriptorSet.update(pipeline))
         return;
@@ -44,15 +54,13 @@ void LightSubrender::onRender(const CommandBuffer& commandBuffer, const Camera*
     descriptorSet.bindDescriptor(commandBuffer, pipeline);
     //pushObject.bindPush(commandBuffer, pipeline);
 
-    auto lightView = registry.view<TransformComponent, LightComponent>();
-
-    for (const auto& [entity, transform, light] : lightView.each()) {
+    for (const auto& [light, position, direction] : snapshot.getLights()) {
         if (light.type == LightComponent::LightType::Directional)
             continue;
 
-        pushObject.push("color", light.color);
-        pushObject.push("position", glm::vec4{ transform.getWorldPosition(), light.radius });
-        descriptorSet.push("PushObject", pushObject);
+        pushObject.push(colorHandle, light.color);
+        pushObject.push(positionHandle, glm::vec4{ position, light.radius });
+        descriptorSet.push(pushObjectHandle, pushObject);
         pushObject.bindPush(commandBuffer, pipeline);
 
         vkCmdDraw(commandBuffer, 6, 1, 0, 0);
@@ -2,10 +2,8 @@
 
 #include "fusion/graphics/subrender.h"
 #include "fusion/graphics/pipelines/pipeline_graphics.h"
-#include "fusion/graphics/buffers/uniform_handler.h"
 #include "fusion/graphics/buffers/push_handler.h"
 #include "fusion/graphics/descriptors/descriptors_handler.h"
-#include "fusion/graphics/buffers/storage_handler.h"
 
 namespace fe {
     class LightSubrender final : public Subrender {
@@ -14,12 +12,23 @@ namespace fe {
         ~LightSubrender() override = default;
 
     private:
+        struct UniformObject {
+            glm::mat4 projection;
+            glm::mat4 view;
+        };
+
+        bool isThreadSafe() const override { return true; }
+
         void onUpdate() override {};
         void onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) override;
 
         PipelineGraphics pipeline;
         DescriptorsHandler descriptorSet;
-        UniformHandler uniformObject;
         PushHandler pushObject;
+
+        Shader::DescriptorHandle uniformObjectHandle;
+        Shader::DescriptorHandle pushObjectHandle;
+        Shader::UniformHandle colorHandle;
+        Shader::UniformHandle positionHandle;
     };
 }
\ No newline at end of file
@@ -1,25 +1,39 @@
 #include "mesh.h"
 
+#include "fusion/core/perf_counters.h"
+
 using namespace fe;
 
 Mesh::Mesh(uint32_t index) : index{index} {
 }
 
 bool Mesh::cmdRender(const CommandBuffer& commandBuffer, uint32_t instances) const {
-    if (vertexBuffer && indexBuffer) {
-        VkBuffer vertexBuffers[1] = { *vertexBuffer };
-        VkDeviceSize offsets[1] = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-        vkCmdBindIndexBuffer(commandBuffer, *indexBuffer, 0, indexType);
-        vkCmdDrawIndexed(commandBuffer, indexCount, instances, 0, 0, 0);
-    } else if (vertexBuffer && !indexBuffer) {
-        VkBuffer vertexBuffers[1] = { *vertexBuffer };
-        VkDeviceSize offsets[1] = { 0 };
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-        vkCmdDraw(commandBuffer, vertexCount, instances, 0, 0);
-    } else {
+    if (!cmdBind(commandBuffer))
+        return false;
+    cmdDraw(commandBuffer, instances);
+    return true;
+}
+
+bool Mesh::cmdBind(const CommandBuffer& commandBuffer) const {
+    if (!vertexBuffer) {
         FE_LOG_WARNING("Mesh with no buffers can't be rendered");
         return false;
     }
+
+    VkBuffer vertexBuffers[1] = { *vertexBuffer };
+    VkDeviceSize offsets[1] = { 0 };
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+    if (indexBuffer)
+        vkCmdBindIndexBuffer(commandBuffer, *indexBuffer, 0, indexType);
     return true;
+}
+
+void Mesh::cmdDraw(const CommandBuffer& commandBuffer, uint32_t instances) const {
+    PerfCounters::Add(PerfCounters::Counter::DrawCalls);
+    PerfCounters::Add(PerfCounters::Counter::Triangles, static_cast<int64_t>(indexBuffer ? indexCount : vertexCount) / 3 * instances);
+
+    if (indexBuffer)
+        vkCmdDrawIndexed(commandBuffer, indexCount, instances, 0, 0, 0);
+    else
+        vkCmdDraw(commandBuffer, vertexCount, instances, 0, 0);
 }
\ No newline at end of file
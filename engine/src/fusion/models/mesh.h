@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fusion/graphics/buffers/buffer.h"
+#include "fusion/graphics/buffers/upload_batch.h"
 #include "fusion/graphics/commands/command_buffer.h"
 #include "fusion/geometry/aabb.h"
 
@@ -14,6 +15,14 @@ namespace fe {
 
         bool cmdRender(const CommandBuffer& commandBuffer, uint32_t instances = 1) const;
 
+        /**
+         * Binds vertex and index buffers, consecutive draws of the same mesh only need cmdDraw.
+         * @param commandBuffer The command buffer to record into.
+         * @return False if the mesh has no buffers.
+         */
+        bool cmdBind(const CommandBuffer& commandBuffer) const;
+        void cmdDraw(const CommandBuffer& commandBuffer, uint32_t instances = 1) const;
+
         const Buffer* getVertexBuffer() const { return vertexBuffer.get(); }
         const Buffer* getIndexBuffer() const { return indexBuffer.get(); }
         uint32_t getVertexCount() const { return vertexCount; }
@@ -21,8 +30,17 @@ namespace fe {
         VkIndexType getIndexType() const { return indexType; }
         const AABB& getBoundingBox() const { return boundingBox; }
 
-        // TODO: Do we need store this in RAM too ?
+        /**
+         * Gets the vertices, from the copy in RAM if the geometry is retained, otherwise they are copied back from the GPU.
+         * @param stride The size of a vertex.
+         * @return The vertex data.
+         */
         std::vector<uint8_t> getVertices(uint32_t stride) const {
+            if (!cachedVertices.empty())
+                return cachedVertices;
+            if (!vertexBuffer)
+                return {};
+
             auto vertexStaging = Buffer::DeviceToStageBuffer(*vertexBuffer);
 
             vertexStaging->map();
@@ -35,26 +53,46 @@ namespace fe {
 
         void setVertices(const std::vector<uint8_t>& vertices, uint32_t stride) {
             vertexBuffer = nullptr;
+            std::vector<uint8_t>().swap(cachedVertices);
             vertexCount = static_cast<uint32_t>(vertices.size() / stride);
 
             if (vertices.empty())
                 return;
 
             vertexBuffer = Buffer::StageToDeviceBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, vertices.size(), vertices.data());
+            boundingBox = ComputeBoundingBox(vertices, stride);
+        }
 
-            glm::vec3 min{ *reinterpret_cast<const glm::vec3*>(&vertices[0]) };
-            glm::vec3 max{ *reinterpret_cast<const glm::vec3*>(&vertices[0]) };
-            for (size_t i = stride; i < vertices.size(); i += stride) {
-                const auto& position = *reinterpret_cast<const glm::vec3*>(&vertices[i]);
-                min = glm::min(position, min);
-                max = glm::max(position, max);
-            }
-            boundingBox = AABB{min, max};
+        /**
+         * Records the copy of the vertices into an upload batch, the mesh can be drawn once the batch completed.
+         * @param vertices The vertex data.
+         * @param stride The size of a vertex.
+         * @param bounds The bounding box of the vertices, computed ahead by {@link Mesh#ComputeBoundingBox}.
+         * @param batch The batch to record the copy into.
+         */
+        void setVertices(const std::vector<uint8_t>& vertices, uint32_t stride, const AABB& bounds, UploadBatch& batch) {
+            vertexBuffer = nullptr;
+            std::vector<uint8_t>().swap(cachedVertices);
+            vertexCount = static_cast<uint32_t>(vertices.size() / stride);
+
+            if (vertices.empty())
+                return;
+
+            vertexBuffer = batch.stageToDeviceBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, vertices.size(), vertices.data());
+            boundingBox = bounds;
         }
 
-        // TODO: Do we need store this in RAM too ?
+        /**
+         * Gets the indices, from the copy in RAM if the geometry is retained, otherwise they are copied back from the GPU.
+         * @return The index data.
+         */
         template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
         std::vector<T> getIndices() const {
+            if (!cachedIndices.empty())
+                return std::vector<T>(cachedIndices.begin(), cachedIndices.end());
+            if (!indexBuffer)
+                return {};
+
             auto indexStaging = Buffer::DeviceToStageBuffer(*indexBuffer);
 
             indexStaging->map();
@@ -68,27 +106,96 @@ namespace fe {
         template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
         void setIndices(const std::vector<T>& indices) {
             indexBuffer = nullptr;
+            std::vector<uint32_t>().swap(cachedIndices);
             indexCount = static_cast<T>(indices.size());
 
             if (indices.empty())
                 return;
 
             indexBuffer = Buffer::StageToDeviceBuffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, sizeof(T) * indices.size(), indices.data());
+            indexType = GetIndexType<T>();
+        }
 
+        /**
+         * Records the copy of the indices into an upload batch, the mesh can be drawn once the batch completed.
+         * @param indices The index data.
+         * @param batch The batch to record the copy into.
+         */
+        template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+        void setIndices(const std::vector<T>& indices, UploadBatch& batch) {
+            indexBuffer = nullptr;
+            std::vector<uint32_t>().swap(cachedIndices);
+            indexCount = static_cast<T>(indices.size());
+
+            if (indices.empty())
+                return;
+
+            indexBuffer = batch.stageToDeviceBuffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, sizeof(T) * indices.size(), indices.data());
+            indexType = GetIndexType<T>();
+        }
+
+        /**
+         * Keeps a copy of the geometry in RAM, so colliders, BVH building and picking read it without a copy back from the GPU.
+         * The copy is dropped when the buffers are set again.
+         * @param vertices The vertex data of the vertex buffer.
+         * @param indices The index data of the index buffer.
+         */
+        void retainGeometry(std::vector<uint8_t>&& vertices, std::vector<uint32_t>&& indices) {
+            cachedVertices = std::move(vertices);
+            cachedIndices = std::move(indices);
+        }
+
+        void releaseGeometry() {
+            std::vector<uint8_t>().swap(cachedVertices);
+            std::vector<uint32_t>().swap(cachedIndices);
+        }
+
+        bool hasGeometry() const { return !cachedVertices.empty(); }
+
+        /**
+         * Gets the memory held by the copy of the geometry.
+         * @return The size in bytes.
+         */
+        uint64_t getGeometrySize() const { return cachedVertices.size() + cachedIndices.size() * sizeof(uint32_t); }
+
+        uint32_t getIndex() const { return index; }
+
+        /**
+         * Computes the bounding box of interleaved vertices which start with the position.
+         * @param vertices The vertex data.
+         * @param stride The size of a vertex.
+         * @return The bounding box.
+         */
+        static AABB ComputeBoundingBox(const std::vector<uint8_t>& vertices, uint32_t stride) {
+            if (vertices.empty())
+                return {};
+
+            glm::vec3 min{ *reinterpret_cast<const glm::vec3*>(&vertices[0]) };
+            glm::vec3 max{ *reinterpret_cast<const glm::vec3*>(&vertices[0]) };
+            for (size_t i = stride; i < vertices.size(); i += stride) {
+                const auto& position = *reinterpret_cast<const glm::vec3*>(&vertices[i]);
+                min = glm::min(position, min);
+                max = glm::max(position, max);
+            }
+            return AABB{min, max};
+        }
+
+    private:
+
+        template<typename T>
+        static constexpr VkIndexType GetIndexType() {
             if constexpr (sizeof(uint8_t) == sizeof(T)) {
-                indexType = VK_INDEX_TYPE_UINT8_EXT;
+                return VK_INDEX_TYPE_UINT8_EXT;
             } else if constexpr (sizeof(uint16_t) == sizeof(T)) {
-                indexType = VK_INDEX_TYPE_UINT16;
+                return VK_INDEX_TYPE_UINT16;
             } else if constexpr (sizeof(uint32_t) == sizeof(T)) {
-                indexType = VK_INDEX_TYPE_UINT32;
+                return VK_INDEX_TYPE_UINT32;
             } else {
                 static_assert("Invalid type");
+                return VK_INDEX_TYPE_NONE_KHR;
             }
         }
 
-        uint32_t getIndex() const { return index; }
-
-    private:
         std::unique_ptr<Buffer> vertexBuffer;
         std::unique_ptr<Buffer> indexBuffer;
         uint32_t vertexCount{ 0 };
@@ -96,5 +203,7 @@ namespace fe {
         VkIndexType indexType{ VK_INDEX_TYPE_NONE_KHR };
         uint32_t index{ UINT32_MAX };
         AABB boundingBox;
+        std::vector<uint8_t> cachedVertices; /// Copy of the geometry in RAM, empty unless retained.
+        std::vector<uint32_t> cachedIndices;
     };
 }
@@ -1,14 +1,20 @@
 #include "mesh_subrender.h"
 #include "mesh.h"
 
-#include "fusion/scene/scene_manager.h"
-#include "fusion/scene/components.h"
-#include "fusion/scene/scene.h"
 #include "fusion/graphics/graphics.h"
+#include "fusion/graphics/render_snapshot.h"
+#include "fusion/core/frame_timings.h"
+#include "fusion/core/perf_counters.h"
 
 using namespace fe;
 
-static const uint32_t MAX_LIGHTS = 32; // TODO: Make configurable.
+static const size_t LIGHTS_BLOCK = 256;
+static const size_t CLUSTERS_BLOCK = 16384;
+static const size_t DRAWS_PER_TASK = 256;
+
+static size_t RoundUp(size_t value, size_t block) {
+    return (value + block - 1) / block * block;
+}
 
 MeshSubrender::MeshSubrender(Pipeline::Stage pipelineStage)
         : Subrender{pipelineStage}
@@ -23,109 +29,174 @@ MeshSubrender::MeshSubrender(Pipeline::Stage pipelineStage)
                    }}},
                    {{"blinnPhongEnabled", true}}}
         , descriptorSet{pipeline} {
+    const auto& shader = pipeline.getShader();
+    uniformObjectHandle = shader.getDescriptorHandle("UniformObject");
+    bufferLightsHandle = shader.getDescriptorHandle("BufferLights");
+    bufferClustersHandle = shader.getDescriptorHandle("BufferClusters");
+    texturesHandle = shader.getDescriptorHandle("textures");
+    pushObjectHandle = shader.getDescriptorHandle("PushObject");
+    modelHandle = shader.getUniformHandle("PushObject", "model");
+    normalHandle = shader.getUniformHandle("PushObject", "normal");
 }
 
 void MeshSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
-    auto scene = SceneManager::Get()->getScene();
-    if (!scene)
+    FUSION_PROFILE_FUNCTION();
+
+    const auto& snapshot = Graphics::Get()->getSnapshot();
+    if (!snapshot.hasScene())
         return;
 
-    auto camera = overrideCamera ? overrideCamera : scene->getCamera();
+    auto camera = overrideCamera ? overrideCamera : snapshot.getCamera();
     if (!camera)
         return;
 
-    auto& registry = scene->getRegistry();
+    auto& frameAllocator = Graphics::Get()->getFrameAllocator();
 
-    // Updates uniforms.
-    std::vector<Light> lights(MAX_LIGHTS);
-    uint32_t lightCount = 0;
+    lightClusters.clear();
 
-    {
-        auto view = registry.view<TransformComponent, LightComponent>();
+    for (const auto& [light, position, direction] : snapshot.getLights()) {
+        LightClusters::Light baseLight = {};
+        baseLight.position = position;
+        if (light.type != LightComponent::LightType::Point) {
+            baseLight.direction = direction;
+        }
+        if (light.type == LightComponent::LightType::Spot) {
+            baseLight.cutOff = glm::cos(glm::radians(light.cutOff));
+            baseLight.outerCutOff = glm::cos(glm::radians(light.outerCutOff));
+        }
+        baseLight.ambient = light.ambient;
+        baseLight.diffuse = light.diffuse;
+        baseLight.specular = light.specular;
+        baseLight.constant = light.constant;
+        baseLight.linear = light.linear;
+        baseLight.quadratic = light.quadratic;
+
+        if (light.type == LightComponent::LightType::Directional) {
+            lightClusters.addDirectional(baseLight);
+            continue;
+        }
 
-        for (const auto& [entity, transform, light]: view.each()) {
-            Light baseLight = {};
-            baseLight.position = transform.getWorldPosition();
-            if (light.type != LightComponent::LightType::Point) {
-                baseLight.direction = transform.getWorldForwardDirection();
-            }
-            if (light.type == LightComponent::LightType::Spot) {
-                baseLight.cutOff = glm::cos(glm::radians(light.cutOff));
-                baseLight.outerCutOff = glm::cos(glm::radians(light.outerCutOff));
-            }
-            baseLight.ambient = light.ambient;
-            baseLight.diffuse = light.diffuse;
-            baseLight.specular = light.specular;
-            baseLight.constant = light.constant;
-            baseLight.linear = light.linear;
-            baseLight.quadratic = light.quadratic;
-            lights[lightCount] = baseLight;
-            ++lightCount;
-
-            if (lightCount >= MAX_LIGHTS)
-                break;
+        float range = light.radius;
+        if (range <= 0.0f) {
+            auto brightest = glm::max(light.ambient, glm::max(light.diffuse, light.specular));
+            float intensity = std::max(brightest.x, std::max(brightest.y, brightest.z));
+            range = LightClusters::CalculateRange(light.constant, light.linear, light.quadratic, intensity);
         }
+        if (range > 0.0f)
+            lightClusters.addLocal(baseLight, range);
     }
 
-    // Updates storage buffers.
-    storageLights.push(lights.data(), sizeof(Light) * MAX_LIGHTS);
-    descriptorSet.push("BufferLights", storageLights);
+    {
+        ScopedFrameTiming timing{FrameTimings::Phase::Culling};
+        lightClusters.build(*camera);
+    }
 
-    // Update uniforms
-    uniformObject.push("projection", camera->getProjectionMatrix());
-    uniformObject.push("view", camera->getViewMatrix());
-    uniformObject.push("cameraPos", camera->getEyePoint());
-    uniformObject.push("lightsCount", lightCount);
-    descriptorSet.push("UniformObject", uniformObject);
-    //descriptorSet.push("PushObject", pushObject);
+    // Sizes are rounded up, so the descriptors are only rewritten when the scene grows past a block
+    const auto& lights = lightClusters.getLights();
+    auto allocationLights = frameAllocator.allocate(RoundUp(std::max<size_t>(lights.size(), 1), LIGHTS_BLOCK) * sizeof(LightClusters::Light));
+    if (!allocationLights)
+        return;
+    if (!lights.empty())
+        allocationLights.push(lights.data(), lights.size() * sizeof(LightClusters::Light));
 
-    bindlessDescriptors.clear();
+    const auto& clusterData = lightClusters.getClusterData();
+    auto allocationClusters = frameAllocator.allocate(RoundUp(clusterData.size(), CLUSTERS_BLOCK) * sizeof(uint32_t));
+    if (!allocationClusters)
+        return;
+    allocationClusters.push(clusterData.data(), clusterData.size() * sizeof(uint32_t));
 
-    auto view = registry.view<MaterialComponent>();
+    descriptorSet.push(bufferLightsHandle, frameAllocator, allocationLights);
+    descriptorSet.push(bufferClustersHandle, frameAllocator, allocationClusters);
 
-    float id = 0.0f;
-    for (const auto& [entity, material]: view.each()) {
-        if (material.diffuse && *material.diffuse) if (bindlessDescriptors.emplace(material.diffuse.get(), id).second) ++id;
-        if (material.specular && *material.specular) if (bindlessDescriptors.emplace(material.specular.get(), id).second) ++id;
-        if (material.normal && *material.normal) if (bindlessDescriptors.emplace(material.normal.get(), id).second) ++id;
-    }
+    // Update uniforms
+    UniformObject uniformObject = {};
+    uniformObject.projection = camera->getProjectionMatrix();
+    uniformObject.view = camera->getViewMatrix();
+    uniformObject.cameraPos = camera->getEyePoint();
+    uniformObject.directionalCount = lightClusters.getDirectionalCount();
+    uniformObject.clusterSize = lightClusters.getClusterSize();
+    uniformObject.clusterParams = lightClusters.getClusterParams();
+
+    auto allocationObject = frameAllocator.allocate(uniformObject);
+    if (!allocationObject)
+        return;
 
-    descriptorSet.push("textures", bindlessDescriptors.keys());
+    descriptorSet.push(uniformObjectHandle, frameAllocator, allocationObject);
+    //descriptorSet.push("PushObject", pushObject);
+
+    // Textures keep their slots in the global table, so the array is only written when the table changes
+    descriptorSet.push(texturesHandle, snapshot.getBindlessTable());
 
     if (!descriptorSet.update(pipeline))
         return;
 
-    // Draws the object
-    pipeline.bindPipeline(commandBuffer);
-    descriptorSet.bindDescriptor(commandBuffer, pipeline);
+    const auto& meshes = snapshot.getMeshes();
+    const auto& frustum = camera->getFrustum();
+    const auto& eyePoint = camera->getEyePoint();
 
-    auto group = registry.group<MeshComponent>(entt::get<TransformComponent, MaterialComponent>);
+    // Emits a key per visible draw, the snapshot itself is left untouched
+    renderQueue.clear();
 
-    group.sort([&registry](const entt::entity a, const entt::entity b) {
-        return registry.get<MeshComponent>(a).get() < registry.get<MeshComponent>(b).get();
-    });
+    {
+        ScopedFrameTiming timing{FrameTimings::Phase::Culling};
 
-    const auto& frustum = camera->getFrustum();
+        for (const auto& [i, draw] : enumerate(meshes)) {
+            if (!frustum.intersects(draw.mesh->getBoundingBox()))
+                continue;
 
-    for (const auto& [entity, mesh, transform, material] : group.each()) {
-        auto filter = mesh.get();
-        if (!filter || !frustum.intersects(filter->getBoundingBox()))
-            continue;
+            auto depth = glm::distance2(eyePoint, draw.position);
+            auto slot = draw.diffuseIndex + 1;
+            renderQueue.push(RenderQueue::OpaqueKey(0, 0, static_cast<uint32_t>(slot), RenderQueue::PointerId(draw.mesh), depth), static_cast<uint32_t>(i));
+        }
+    }
 
-        pushObject.push("model", transform.getWorldMatrix());
+    PerfCounters::Add(PerfCounters::Counter::CulledObjects, static_cast<int64_t>(meshes.size() - renderQueue.size()));
 
-        glm::mat4 normal{ transform.getNormalMatrix() };
-        normal[0].w = material.diffuse && *material.diffuse ? bindlessDescriptors[material.diffuse.get()] : -1.0f;
-        normal[1].w = material.specular && *material.specular ? bindlessDescriptors[material.specular.get()] : -1.0f;
-        normal[2].w = material.normal && *material.normal ? bindlessDescriptors[material.normal.get()] : -1.0f;
-        normal[3] = glm::vec4{material.baseColor, material.shininess};
-        pushObject.push("normal", normal);
+    renderQueue.sort();
 
-        descriptorSet.push("PushObject", pushObject);
+    // Push constants are gathered here, so the workers only read prepared data
+    descriptorSet.push(pushObjectHandle, pushObject);
 
-        pushObject.bindPush(commandBuffer, pipeline);
-        filter->cmdRender(commandBuffer);
+    auto pushSize = pushObject.getSize();
+    pushData.resize(renderQueue.size() * pushSize);
+
+    for (const auto& [i, item] : enumerate(renderQueue)) {
+        const auto& draw = meshes[item.payload];
+
+        pushObject.push(modelHandle, draw.worldMatrix);
+
+        glm::mat4 normal{ draw.normalMatrix };
+        normal[0].w = static_cast<float>(draw.diffuseIndex);
+        normal[1].w = static_cast<float>(draw.specularIndex);
+        normal[2].w = static_cast<float>(draw.normalIndex);
+        normal[3] = glm::vec4{draw.baseColor, draw.shininess};
+        pushObject.push(normalHandle, normal);
+
+        std::memcpy(pushData.data() + i * pushSize, pushObject.getData(), pushSize);
     }
+
+    // Draws the objects, chunks of the sorted queue are recorded on the workers
+    auto items = renderQueue.begin();
+    Graphics::Get()->recordParallel(commandBuffer, renderQueue.size(), DRAWS_PER_TASK, [&](const CommandBuffer& recordBuffer, size_t begin, size_t end) {
+        pipeline.bindPipeline(recordBuffer);
+        descriptorSet.bindDescriptor(recordBuffer, pipeline);
+
+        const Mesh* lastMesh = nullptr;
+
+        for (size_t i = begin; i < end; ++i) {
+            auto filter = meshes[items[i].payload].mesh;
+
+            pushObject.bindPush(recordBuffer, pipeline, pushData.data() + i * pushSize);
+
+            // Draws sorted by mesh reuse the bound buffers
+            if (filter != lastMesh) {
+                if (!filter->cmdBind(recordBuffer))
+                    continue;
+                lastMesh = filter;
+            }
+            filter->cmdDraw(recordBuffer);
+        }
+    });
 }
 
 // PBR
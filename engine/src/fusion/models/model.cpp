@@ -1,7 +1,10 @@
 #include "model.h"
 
 #include "fusion/core/engine.h"
+#include "fusion/core/thread_pool.h"
 #include "fusion/assets/asset_registry.h"
+#include "fusion/graphics/buffers/upload_batch.h"
+#include "fusion/filesystem/file_system.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/Exporter.hpp>
@@ -21,25 +24,162 @@ static inline glm::mat4 mat4_cast(const aiMatrix3x3& m) { return glm::transpose(
 // TODO: May be load from shader ?
 Vertex::Layout Model::Layout = {{ Vertex::Component::Position, Vertex::Component::Normal, Vertex::Component::Tangent, Vertex::Component::Bitangent, Vertex::Component::UV }};
 
+static constexpr std::array<char, 4> CookedMagic{ 'F', 'E', 'M', 'S' };
+static constexpr uint32_t CookedVersion = 1;
+
+/**
+ * Header of a cooked model, the source is identified by its size and write time, and by its content hash once the time changed.
+ */
+struct CookedHeader {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint64_t layoutHash;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t sourceHash;
+};
+
+/**
+ * Reads values from cooked data, reads past the end fail instead of overrunning the buffer.
+ */
+class CookedReader {
+public:
+    explicit CookedReader(gsl::span<const uint8_t> buffer) : buffer{buffer} {}
+
+    bool read(void* data, size_t size) {
+        if (size > getRemaining())
+            return false;
+        std::memcpy(data, buffer.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& value) {
+        return read(&value, sizeof(T));
+    }
+
+    template<typename T>
+    bool read(std::vector<T>& values) {
+        uint32_t count;
+        if (!read(count) || count > getRemaining() / sizeof(T))
+            return false;
+        values.resize(count);
+        return read(values.data(), count * sizeof(T));
+    }
+
+    bool read(std::string& value) {
+        uint32_t count;
+        if (!read(count) || count > getRemaining())
+            return false;
+        value.resize(count);
+        return read(value.data(), count);
+    }
+
+    size_t getRemaining() const { return buffer.size() - offset; }
+
+private:
+    gsl::span<const uint8_t> buffer;
+    size_t offset{ 0 };
+};
+
+template<typename T>
+static void WriteArray(std::vector<uint8_t>& output, const std::vector<T>& values) {
+    Vector::Append(output, static_cast<uint32_t>(values.size()));
+    Vector::Append(output, values);
+}
+
+static void WriteString(std::vector<uint8_t>& output, const std::string& value) {
+    Vector::Append(output, static_cast<uint32_t>(value.size()));
+    output.insert(output.end(), value.begin(), value.end());
+}
+
+// FNV-1a
+static uint64_t HashBytes(gsl::span<const uint8_t> bytes, uint64_t hash = 14695981039346656037ULL) {
+    for (auto byte : bytes) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t HashFile(const fs::path& filepath) {
+    uint64_t hash = 0;
+    FileSystem::ReadBytes(filepath, [&hash](gsl::span<const uint8_t> buffer) {
+        hash = HashBytes(buffer);
+    });
+    return hash;
+}
+
+static uint64_t HashLayout(const Vertex::Layout& layout) {
+    uint64_t hash = HashBytes({});
+    for (const auto& component : layout) {
+        auto value = static_cast<uint32_t>(component);
+        hash = HashBytes({ reinterpret_cast<const uint8_t*>(&value), sizeof(value) }, hash);
+    }
+    return hash;
+}
+
+static std::pair<uint64_t, int64_t> GetSourceStamp(const fs::path& filepath) {
+    std::error_code sizeError, timeError;
+    auto size = fs::file_size(filepath, sizeError);
+    auto time = fs::last_write_time(filepath, timeError);
+    return { sizeError ? 0 : static_cast<uint64_t>(size), timeError ? 0 : static_cast<int64_t>(time.time_since_epoch().count()) };
+}
+
 Model::Model(uuids::uuid uuid, bool load) : uuid{uuid} {
     if (load)
         loadFromFile();
 }
 
+Model::Model(std::string_view name, std::vector<std::unique_ptr<Mesh>>&& meshes) : loaded{true}, internal{true} {
+    setState(AssetState::Ready);
+    root.name = name;
+    root.meshes = std::move(meshes);
+
+    for (const auto& [index, mesh] : enumerate(root.meshes)) {
+        mesh->index = static_cast<uint32_t>(index);
+        meshesLoaded.push_back(mesh.get());
+    }
+}
+
 void Model::loadFromFile() {
     if (loaded) {
         FE_LOG_DEBUG("Model: '{}' already was loaded", path);
         return;
     }
 
+    if (!decode()) {
+        setState(AssetState::Failed);
+        return;
+    }
+
+    UploadBatch batch;
+    upload(batch);
+    batch.submit();
+    batch.wait();
+
+    setState(AssetState::Ready);
+}
+
+bool Model::decode() {
     auto op = AssetRegistry::Get()->getDatabase()->getValue(uuid);
     if (!op.has_value()) {
         FE_LOG_ERROR("Model: [{}] is not valid", uuid);
-        return;
+        return false;
     }
-    path = std::move(*op);
 
-    fs::path filepath{ Engine::Get()->getApp()->getProjectSettings().projectRoot / path }; // get full path
+    decoded = std::make_unique<DecodedScene>();
+    decoded->path = std::move(*op);
+
+    fs::path filepath{ Engine::Get()->getApp()->getProjectSettings().projectRoot / decoded->path }; // get full path
+
+    // Cooked scene is already in the final vertex layout, so Assimp only runs when the source changed
+    fs::path cookedPath{ filepath };
+    cookedPath += ".mesh";
+
+    if (readCooked(cookedPath, filepath))
+        return true;
 
     uint32_t flags = aiProcess_Triangulate;
     if (Layout.contains(Vertex::Component::Normal)) {
@@ -63,20 +203,184 @@ void Model::loadFromFile() {
     const aiScene* scene = import.ReadFile(filepath.string(), flags);
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         FE_LOG_ERROR("Failed to load model at: '{}' - {}", filepath, import.GetErrorString());
-        return;
+        decoded.reset();
+        return false;
     }
 
     //directory = modelPath.parent_path();
 
     aiVector3D position; aiQuaternion orientation; aiVector3D scale;
     scene->mRootNode->mTransformation.Decompose(scale, orientation, position);
-    root = { scene->mRootNode->mName.C_Str(), vec3_cast(position), quat_cast(orientation), vec3_cast(scale) };
+    decoded->root = { scene->mRootNode->mName.C_Str(), vec3_cast(position), quat_cast(orientation), vec3_cast(scale) };
+
+    // Hierarchy is walked first, then the meshes are converted in parallel
+    processNode(scene, scene->mRootNode, decoded->root);
+
+    ThreadPool::Get()->parallelFor(decoded->meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            convertMesh(scene, decoded->meshes[i]);
+        }
+    });
+
+    writeCooked(cookedPath, filepath);
+
+    return true;
+}
+
+void Model::upload(UploadBatch& batch) {
+    if (loaded || !decoded)
+        return;
+
+    path = std::move(decoded->path);
+    root = std::move(decoded->root);
 
-    processNode(scene, scene->mRootNode, root);
+    for (auto& [mesh, bounds, vertices, indices] : decoded->meshes) {
+        mesh->setVertices(vertices, Layout.getStride(), bounds, batch);
+        mesh->setIndices(indices, batch);
+        meshesLoaded.push_back(mesh);
+        memorySize += vertices.size() + indices.size() * sizeof(uint32_t);
+
+        if (retention == AssetRetention::Keep) {
+            mesh->retainGeometry(std::move(vertices), std::move(indices));
+            memorySize += mesh->getGeometrySize();
+        }
+    }
+
+    decoded.reset();
 
     loaded = true;
 }
 
+void Model::setRetention(AssetRetention value) {
+    if (retention == value)
+        return;
+
+    retention = value;
+
+    // Not loaded models apply the policy on the upload
+    for (auto mesh : meshesLoaded) {
+        memorySize -= mesh->getGeometrySize();
+        if (retention == AssetRetention::Keep)
+            mesh->retainGeometry(mesh->getVertices(Layout.getStride()), mesh->getIndices<uint32_t>());
+        else
+            mesh->releaseGeometry();
+        memorySize += mesh->getGeometrySize();
+    }
+}
+
+bool Model::readCooked(const fs::path& cookedPath, const fs::path& filepath) {
+    if (!FileSystem::IsExists(cookedPath))
+        return false;
+
+    bool result = false;
+    bool stampChanged = false;
+    CookedHeader header;
+
+    FileSystem::ReadBytes(cookedPath, [&](gsl::span<const uint8_t> buffer) {
+        CookedReader reader{buffer};
+        if (!reader.read(header) || header.magic != CookedMagic || header.version != CookedVersion || header.layoutHash != HashLayout(Layout))
+            return;
+
+        // Without the source the cooked scene is used as it is
+        if (FileSystem::IsExists(filepath)) {
+            auto [sourceSize, sourceTime] = GetSourceStamp(filepath);
+            if (header.sourceSize != sourceSize)
+                return;
+            if (header.sourceTime != sourceTime) {
+                // Write time also changes on checkouts and copies, so the content decides
+                if (header.sourceHash != HashFile(filepath))
+                    return;
+                header.sourceTime = sourceTime;
+                stampChanged = true;
+            }
+        }
+
+        std::function<bool(SceneObject&)> readObject = [&](SceneObject& object) {
+            uint32_t meshCount;
+            if (!reader.read(object.name) || !reader.read(object.position) || !reader.read(object.orientation) || !reader.read(object.scale) || !reader.read(meshCount))
+                return false;
+
+            for (uint32_t i = 0; i < meshCount; ++i) {
+                uint32_t index;
+                glm::vec3 min, max;
+                DecodedMesh decodedMesh;
+                if (!reader.read(index) || !reader.read(min) || !reader.read(max) || !reader.read(decodedMesh.vertices) || !reader.read(decodedMesh.indices))
+                    return false;
+
+                auto& mesh = object.meshes.emplace_back(std::make_unique<Mesh>(index));
+                decodedMesh.mesh = mesh.get();
+                decodedMesh.bounds = AABB{min, max};
+                decoded->meshes.push_back(std::move(decodedMesh));
+            }
+
+            uint32_t childCount;
+            if (!reader.read(childCount) || childCount > reader.getRemaining())
+                return false;
+
+            object.children.resize(childCount);
+            for (auto& child : object.children) {
+                if (!readObject(child))
+                    return false;
+            }
+            return true;
+        };
+
+        result = readObject(decoded->root);
+    });
+
+    if (!result) {
+        decoded->root = {};
+        decoded->meshes.clear();
+        return false;
+    }
+
+    if (stampChanged) {
+        std::fstream file{ cookedPath, std::ios::binary | std::ios::in | std::ios::out };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(CookedHeader));
+    }
+
+    return true;
+}
+
+void Model::writeCooked(const fs::path& cookedPath, const fs::path& filepath) const {
+    std::unordered_map<const Mesh*, const DecodedMesh*> meshes;
+    for (const auto& decodedMesh : decoded->meshes) {
+        meshes.emplace(decodedMesh.mesh, &decodedMesh);
+    }
+
+    auto [sourceSize, sourceTime] = GetSourceStamp(filepath);
+    CookedHeader header{ CookedMagic, CookedVersion, HashLayout(Layout), sourceSize, sourceTime, HashFile(filepath) };
+
+    std::vector<uint8_t> output;
+    Vector::Append(output, header);
+
+    std::function<void(const SceneObject&)> writeObject = [&](const SceneObject& object) {
+        WriteString(output, object.name);
+        Vector::Append(output, object.position);
+        Vector::Append(output, object.orientation);
+        Vector::Append(output, object.scale);
+
+        Vector::Append(output, static_cast<uint32_t>(object.meshes.size()));
+        for (const auto& mesh : object.meshes) {
+            const auto& decodedMesh = *meshes[mesh.get()];
+            Vector::Append(output, mesh->getIndex());
+            Vector::Append(output, decodedMesh.bounds.getMin());
+            Vector::Append(output, decodedMesh.bounds.getMax());
+            WriteArray(output, decodedMesh.vertices);
+            WriteArray(output, decodedMesh.indices);
+        }
+
+        Vector::Append(output, static_cast<uint32_t>(object.children.size()));
+        for (const auto& child : object.children) {
+            writeObject(child);
+        }
+    };
+    writeObject(decoded->root);
+
+    if (FileSystem::WriteBytes(cookedPath, output))
+        FE_LOG_DEBUG("Model: '{}' cooked into '{}'", filepath, cookedPath);
+}
+
 void Model::processNode(const aiScene* scene, const aiNode* node, SceneObject& targetParent) {
     SceneObject* parent;
 
@@ -103,59 +407,60 @@ void Model::processNode(const aiScene* scene, const aiNode* node, SceneObject& t
 
 void Model::processMeshes(const aiScene* scene, const aiNode* node, SceneObject& parent) {
     for (uint32_t i = 0; i < node->mNumMeshes; ++i) {
-        std::vector<uint8_t> vertices;
-        std::vector<uint32_t> indices;
-        uint32_t index = node->mMeshes[i];
-        {
-            const aiMesh* mesh = scene->mMeshes[index];
-            vertices.reserve(mesh->mNumVertices * Layout.getStride());
-            indices.reserve(mesh->mNumFaces * 3);
-
-            for (uint32_t j = 0; j < mesh->mNumVertices; ++j) {
-                appendVertex(vertices, scene, mesh, j);
-            }
+        // Buffers are created by the upload on the main thread
+        auto& mesh = parent.meshes.emplace_back(std::make_unique<Mesh>(node->mMeshes[i]));
+        decoded->meshes.push_back({ mesh.get() });
+    }
+}
 
-            for (uint32_t j = 0; j < mesh->mNumFaces; ++j) {
-                const aiFace& face = mesh->mFaces[j];
-                if (face.mNumIndices != 3)
-                    continue;
-                for (uint32_t k = 0; k < face.mNumIndices; ++k) {
-                    indices.push_back(face.mIndices[k]);
-                }
-            }
+void Model::convertMesh(const aiScene* scene, DecodedMesh& decodedMesh) {
+    auto& vertices = decodedMesh.vertices;
+    auto& indices = decodedMesh.indices;
+
+    const aiMesh* mesh = scene->mMeshes[decodedMesh.mesh->getIndex()];
+    vertices.reserve(mesh->mNumVertices * Layout.getStride());
+    indices.reserve(mesh->mNumFaces * 3);
+
+    for (uint32_t j = 0; j < mesh->mNumVertices; ++j) {
+        appendVertex(vertices, scene, mesh, j);
+    }
 
-            /*if (mesh->mMaterialIndex >= 0) {
-                const aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+    for (uint32_t j = 0; j < mesh->mNumFaces; ++j) {
+        const aiFace& face = mesh->mFaces[j];
+        if (face.mNumIndices != 3)
+            continue;
+        for (uint32_t k = 0; k < face.mNumIndices; ++k) {
+            indices.push_back(face.mIndices[k]);
+        }
+    }
 
-                auto diffuseMaps = loadTextures(material, aiTextureType_DIFFUSE);
-                textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+    /*if (mesh->mMaterialIndex >= 0) {
+        const aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
-                auto specularMaps = loadTextures(material, aiTextureType_SPECULAR);
-                textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+        auto diffuseMaps = loadTextures(material, aiTextureType_DIFFUSE);
+        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
 
-                auto normalMaps = loadTextures(material, aiTextureType_HEIGHT);
-                textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
+        auto specularMaps = loadTextures(material, aiTextureType_SPECULAR);
+        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
 
-                auto heightMaps = loadTextures(material, aiTextureType_AMBIENT);
-                textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
+        auto normalMaps = loadTextures(material, aiTextureType_HEIGHT);
+        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
 
-                if (textures.empty()) {
-                    aiColor3D color;
-                    material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+        auto heightMaps = loadTextures(material, aiTextureType_AMBIENT);
+        textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
-                    auto r = static_cast<uint8_t>(color.r * 255);
-                    auto g = static_cast<uint8_t>(color.g * 255);
-                    auto b = static_cast<uint8_t>(color.b * 255);
-                    textures.push_back(std::make_shared<Image>(r, g, b));
-                }
-            }*/
+        if (textures.empty()) {
+            aiColor3D color;
+            material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
+
+            auto r = static_cast<uint8_t>(color.r * 255);
+            auto g = static_cast<uint8_t>(color.g * 255);
+            auto b = static_cast<uint8_t>(color.b * 255);
+            textures.push_back(std::make_shared<Image>(r, g, b));
         }
+    }*/
 
-        auto& mesh = parent.meshes.emplace_back(std::make_unique<Mesh>(index));
-        mesh->setVertices(vertices, Layout.getStride());
-        mesh->setIndices(indices);
-        meshesLoaded.push_back(mesh.get());
-    }
+    decodedMesh.bounds = Mesh::ComputeBoundingBox(vertices, Layout.getStride());
 }
 
 /*std::vector<std::shared_ptr<Texture2d>> Model::loadTextures(const aiMaterial* material, int type) {
@@ -32,6 +32,12 @@ namespace fe {
         // aiProcess_Triangulate by default
         Model() = default;
         explicit Model(uuids::uuid uuid, bool load = false);
+        /**
+         * Creates an internal model from generated meshes, it is not backed by a file.
+         * @param name The model name.
+         * @param meshes The meshes, vertices follow the model layout.
+         */
+        Model(std::string_view name, std::vector<std::unique_ptr<Mesh>>&& meshes);
         ~Model() override = default;
 
         uuids::uuid getUuid() const override { return uuid; }
@@ -40,23 +46,68 @@ namespace fe {
         const fs::path& getPath() const override { return path; }
         bool isLoaded() const override { return loaded; }
         bool isInternal() const override { return internal; }
+        uint64_t getMemorySize() const override { return memorySize; }
 
         const SceneObject& getRoot() const { return root; }
         const Mesh* getMesh(uint32_t index) const { return index < meshesLoaded.size() ? meshesLoaded[index] : nullptr; }
 
+        /**
+         * Sets if the meshes keep their geometry in RAM, a loaded model copies the geometry back from the GPU once.
+         * @param retention The retention policy.
+         */
+        void setRetention(AssetRetention retention) override;
+        AssetRetention getRetention() const override { return retention; }
+
+        static const Vertex::Layout& GetLayout() { return Layout; }
+
         operator bool() const { return !root.name.empty(); }
 
         void load() override { loadFromFile(); };
         void unload() override { };
 
+        bool decode() override;
+        void upload(UploadBatch& batch) override;
+
     private:
         // TODO: May be load from shader ?
         static Vertex::Layout Layout;
 
+        /**
+         * Scene built by {@link Model#decode}, its meshes wait for the upload of their buffers.
+         */
+        struct DecodedMesh {
+            Mesh* mesh;
+            AABB bounds;
+            std::vector<uint8_t> vertices;
+            std::vector<uint32_t> indices;
+        };
+        struct DecodedScene {
+            fs::path path;
+            SceneObject root;
+            std::vector<DecodedMesh> meshes;
+        };
+
         void loadFromFile();
 
+        /**
+         * Reads the cooked scene which is stored next to the source, it is used while the source content did not change.
+         * @param cookedPath The path of the cooked file.
+         * @param filepath The path of the source file.
+         * @return If the cooked scene was read.
+         */
+        bool readCooked(const fs::path& cookedPath, const fs::path& filepath);
+        void writeCooked(const fs::path& cookedPath, const fs::path& filepath) const;
+
         void processNode(const aiScene* scene, const aiNode* node, SceneObject& parent);
         void processMeshes(const aiScene* scene, const aiNode* node, SceneObject& parent);
+
+        /**
+         * Converts the Assimp mesh of a decoded mesh into the model layout, meshes are converted in parallel on the thread pool.
+         * @param scene The Assimp scene.
+         * @param decodedMesh The decoded mesh, its index selects the Assimp mesh.
+         */
+        void convertMesh(const aiScene* scene, DecodedMesh& decodedMesh);
+
         //void processLight(const aiScene* scene, const aiNode* node, const aiLight* light);
         //void processCamera(const aiScene* scene, const aiNode* node, const aiCamera* camera);
 
@@ -65,11 +116,15 @@ namespace fe {
 
         //static aiScene GenerateScene(const Mesh& mesh);
 
+        std::unique_ptr<DecodedScene> decoded;
+
         SceneObject root;
-        std::vector<const Mesh*> meshesLoaded;
+        std::vector<Mesh*> meshesLoaded;
         //std::unordered_map<fs::path, const Texture2d*> texturesLoaded;
         fs::path path;
         uuids::uuid uuid;
+        uint64_t memorySize{ 0 };
+        AssetRetention retention{ AssetRetention::GpuOnly };
         bool loaded{ false };
         bool internal{ false };
     };
@@ -7,22 +7,29 @@
 
 namespace fe {
     struct MeshComponent {
-        std::shared_ptr<Model> model;
+        AssetHandle<Model> model;
         uint32_t index;
 
-        const Mesh* get() const { return model && *model ? model->getMesh(index) : nullptr; }
+        /**
+         * Gets the mesh, models are loaded asynchronously, so it stays null until the model is ready.
+         * @return The mesh or nullptr.
+         */
+        const Mesh* get() const {
+            auto asset = model.get();
+            return asset && asset->isReady() ? asset->getMesh(index) : nullptr;
+        }
 
         template<typename Archive>
         void load(Archive& archive) {
             uuids::uuid uuid;
             archive(cereal::make_nvp("model", uuid));
-            model = AssetRegistry::Get()->load<Model>(uuid);
+            model = AssetRegistry::Get()->resolve<Model>(uuid);
             archive(cereal::make_nvp("index", index));
         }
 
         template<typename Archive>
         void save(Archive& archive) const {
-            archive(cereal::make_nvp("model", model && *model ? model->getUuid() : uuids::uuid{}));
+            archive(cereal::make_nvp("model", model.getUuid()));
             archive(cereal::make_nvp("index", index));
         }
     };
@@ -6,18 +6,18 @@
 
 namespace fe {
     struct SkyboxComponent {
-        std::shared_ptr<TextureCube> texture;
+        AssetHandle<TextureCube> texture;
 
         template<typename Archive>
         void load(Archive& archive) {
             uuids::uuid uuid;
             archive(cereal::make_nvp("texture", uuid));
-            texture = AssetRegistry::Get()->load<TextureCube>(uuid);
+            texture = AssetRegistry::Get()->resolve<TextureCube>(uuid);
         }
 
         template<typename Archive>
         void save(Archive& archive) const {
-            archive(cereal::make_nvp("texture", texture ? texture->getUuid() : uuids::uuid{}));
+            archive(cereal::make_nvp("texture", texture.getUuid()));
         }
     };
 }
\ No newline at end of file
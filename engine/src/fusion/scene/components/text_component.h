@@ -1,11 +1,13 @@
 #pragma once
 
+#include "fusion/assets/asset_registry.h"
+
 #include "fusion/text/font.h"
 
 namespace fe {
     struct TextComponent {
         std::string text;
-        std::shared_ptr<Font> font;
+        AssetHandle<Font> font;
         glm::vec4 color{ 1.0f };
         float kerning{ 0.0f };
         float lineSpacing{ 0.0f };
@@ -15,7 +17,7 @@ namespace fe {
             archive(cereal::make_nvp("text", text));
             uuids::uuid uuid;
             archive(cereal::make_nvp("font", uuid));
-            font = AssetRegistry::Get()->load<Font>(uuid);
+            font = AssetRegistry::Get()->resolve<Font>(uuid);
             archive(cereal::make_nvp("color", color));
             archive(cereal::make_nvp("kerning", kerning));
             archive(cereal::make_nvp("lineSpacing", lineSpacing));
@@ -23,9 +25,8 @@ namespace fe {
 
         template<typename Archive>
         void save(Archive& archive) const {
-            uuids::uuid uuid;
             archive(cereal::make_nvp("text", text));
-            archive(cereal::make_nvp("font", font ? font->getUuid() : uuids::uuid{}));
+            archive(cereal::make_nvp("font", font.getUuid()));
             archive(cereal::make_nvp("color", color));
             archive(cereal::make_nvp("kerning", kerning));
             archive(cereal::make_nvp("lineSpacing", lineSpacing));
@@ -241,8 +241,10 @@ void Scene::importMesh(fs::path filepath) {
         return;
     }
 
-    auto model = AssetRegistry::Get()->load<Model>(*uuid);
-    if (model == nullptr || !model->isLoaded()) {
+    // Hierarchy is built from the model, so it has to be loaded right away
+    auto handle = AssetRegistry::Get()->resolve<Model>(*uuid);
+    auto model = handle.getShared();
+    if (model == nullptr || !AssetRegistry::Get()->wait(model)) {
         FE_LOG_ERROR("Cannot load model");
         return;
     }
@@ -255,7 +257,7 @@ void Scene::importMesh(fs::path filepath) {
     if (root.children.size() == 1) {
         auto& main = root.children.front();
         if (main.meshes.size() == 1 && main.children.empty())
-            registry.emplace<MeshComponent>(entity, model, main.meshes.front()->getIndex());
+            registry.emplace<MeshComponent>(entity, handle, main.meshes.front()->getIndex());
     } else {
         std::function<void(const SceneObject&)> createObject = [&](const SceneObject& object) {
             for (const auto& child : object.children) {
@@ -263,12 +265,12 @@ void Scene::importMesh(fs::path filepath) {
                 registry.emplace<TransformComponent>(childEntity, child.position, child.orientation, child.scale);
 
                 if (child.meshes.size() == 1) {
-                    registry.emplace<MeshComponent>(childEntity, model, child.meshes.front()->getIndex());
+                    registry.emplace<MeshComponent>(childEntity, handle, child.meshes.front()->getIndex());
                 } else {
                     for (const auto& mesh: child.meshes) {
                         auto meshChildEntity = createEntity(child.name + " " + std::to_string(mesh->getIndex()));
                         registry.emplace<TransformComponent>(meshChildEntity);
-                        registry.emplace<MeshComponent>(meshChildEntity, model, mesh->getIndex());
+                        registry.emplace<MeshComponent>(meshChildEntity, handle, mesh->getIndex());
                         hierarchySystem->assignChild(childEntity, meshChildEntity);
                     }
                 }
@@ -1,5 +1,8 @@
 #include "hierarchy_system.h"
 
+#include "fusion/core/frame_timings.h"
+#include "fusion/core/perf_counters.h"
+
 using namespace fe;
 
 HierarchySystem::HierarchySystem(entt::registry& registry) : System{registry} {
@@ -16,11 +19,17 @@ void HierarchySystem::onPlay() {
 }
 
 void HierarchySystem::onUpdate() {
+    FUSION_PROFILE_FUNCTION();
+    ScopedFrameTiming timing{FrameTimings::Phase::Hierarchy};
+
     auto nonHierarchyView = registry.view<TransformComponent>(entt::exclude<HierarchyComponent>);
 
+    int64_t updates = 0;
     for (const auto& [entity, transform] : nonHierarchyView.each()) {
         transform.setWorldMatrix(glm::mat4{1.0f});
+        ++updates;
     }
+    PerfCounters::Add(PerfCounters::Counter::TransformUpdates, updates);
 
     auto hierarchyView = registry.view<TransformComponent, HierarchyComponent>();
     for (const auto& [entity, transform, hierarchy] : hierarchyView.each()) {
@@ -58,6 +67,7 @@ void HierarchySystem::onDisabled() {
 void HierarchySystem::update(entt::entity entity) {
     if (auto hierarchy = registry.try_get<HierarchyComponent>(entity)) {
         if (auto transform = registry.try_get<TransformComponent>(entity)) {
+            PerfCounters::Add(PerfCounters::Counter::TransformUpdates);
             if (hierarchy->parent != entt::null) {
                 auto parentTransform = registry.try_get<TransformComponent>(hierarchy->parent);
                 if (parentTransform) {
@@ -43,10 +43,11 @@ static std::unordered_map<std::string, ScriptFieldType> ScriptFieldTypeMap = {
 namespace Utils {
     static MonoAssembly* LoadMonoAssembly(const fs::path& assemblyPath, bool loadPDB = false) {
         // NOTE: We can't use this image for anything other than loading the assembly because this image doesn't have a reference to the assembly
-        MonoImageOpenStatus status;
+        MonoImageOpenStatus status = MONO_IMAGE_ERROR_ERRNO;
         MonoImage* image = nullptr;
 
         // TODO: fix possible leak
+        // Image copies the data, so the assembly is read straight from the mapped file
         FileSystem::ReadBytes(assemblyPath, [&](gsl::span<const uint8_t> buffer) {
             image = mono_image_open_from_data_full((char*) buffer.data(), buffer.size(), 1, &status, 0);
         });
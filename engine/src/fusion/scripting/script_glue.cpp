@@ -6,6 +6,7 @@
 #include "fusion/scene/components.h"
 #include "fusion/scene/scene.h"
 #include "fusion/input/input.h"
+#include "fusion/core/perf_counters.h"
 
 #include <mono/metadata/object.h>
 #include <mono/metadata/reflection.h>
@@ -149,6 +150,12 @@ static bool Input_IsKeyDown(Key key) {
     return input->getKeyDown(key);
 }
 
+static int64_t Performance_GetCounter(PerfCounters::Counter counter) {
+    if (counter >= PerfCounters::Counter::Count)
+        return 0;
+    return PerfCounters::Get(counter);
+}
+
 template<typename... Component>
 static void RegisterComponent() {
     ([]() {
@@ -193,6 +200,8 @@ void ScriptGlue::RegisterFunctions() {
     ADD_INTERNAL_CALL(TransformComponent_SetScale);
 
     ADD_INTERNAL_CALL(Input_IsKeyDown);
+
+    ADD_INTERNAL_CALL(Performance_GetCounter);
 }
 
 #endif
\ No newline at end of file
@@ -5,8 +5,8 @@
 #include "fusion/graphics/buffers/buffer.h"
 #include "fusion/graphics/textures/texture_cube.h"
 #include "fusion/devices/device_manager.h"
-#include "fusion/scene/scene_manager.h"
-#include "fusion/scene/components.h"
+#include "fusion/graphics/graphics.h"
+#include "fusion/graphics/render_snapshot.h"
 
 using namespace fe;
 
@@ -72,16 +72,16 @@ SkyboxSubrender::~SkyboxSubrender() {
 }
 
 void SkyboxSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
-    auto scene = SceneManager::Get()->getScene();
-    if (!scene)
+    const auto& snapshot = Graphics::Get()->getSnapshot();
+    if (!snapshot.hasScene())
         return;
 
-    auto camera = overrideCamera ? overrideCamera : scene->getCamera();
+    auto camera = overrideCamera ? overrideCamera : snapshot.getCamera();
     if (!camera)
         return;
 
-    auto skybox = scene->getComponent<SkyboxComponent>();
-    if (!skybox || !skybox->texture)
+    auto skybox = snapshot.getSkybox();
+    if (!skybox)
         return;
 
     // Updates uniform
@@ -89,7 +89,7 @@ void SkyboxSubrender::onRender(const CommandBuffer& commandBuffer, const Camera*
     pushObject.push("view", glm::mat4{glm::mat3{camera->getViewMatrix()}});
 
     // Updates descriptors
-    descriptorSet.push("skyboxSampler", skybox->texture.get());
+    descriptorSet.push("skyboxSampler", skybox);
     descriptorSet.push("PushObject", pushObject);
 
     if (!descriptorSet.update(pipeline))
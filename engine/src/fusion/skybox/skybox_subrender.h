@@ -14,6 +14,8 @@ namespace fe {
         ~SkyboxSubrender() override;
 
     private:
+        bool isThreadSafe() const override { return true; }
+
         void onUpdate() override {};
         void onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) override;
 
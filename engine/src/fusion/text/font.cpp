@@ -2,6 +2,7 @@
 #include "msdf.h"
 
 #include "fusion/core/engine.h"
+#include "fusion/filesystem/file_system.h"
 #include "fusion/assets/asset_registry.h"
 #include "fusion/graphics/textures/texture2d.h"
 
@@ -77,19 +78,6 @@ void Font::loadFromFile() {
     auto debugStart = DateTime::Now();
 #endif
 
-    /*msdfgen::FontHandle* font = nullptr;
-    FileSystem::ReadBytes(filepath, [&ft, &font](gsl::span<const uint8_t> buffer) {
-        font = msdfgen::loadFontData(ft, buffer.data(), static_cast<int>(buffer.size()));
-    });*/
-    msdfgen::FontHandle* font = msdfgen::loadFont(ft, filepath.string().c_str());
-
-    if (!font)
-        throw std::runtime_error("Font is empty");
-
-#if FUSION_DEBUG
-    FE_LOG_DEBUG("Font '{}' loaded in {}ms", filepath, (DateTime::Now() - debugStart).asMilliseconds<float>());
-#endif
-
     using CharsetRange = std::pair<uint32_t, uint32_t>;
 
     // From imgui_draw.cpp
@@ -103,9 +91,30 @@ void Font::loadFromFile() {
             charset.add(c);
     }
 
-    double fontScale = 1.0;
-    data->fontGeometry = msdf_atlas::FontGeometry(&data->glyphs);
-    int glyphsLoaded = data->fontGeometry.loadCharset(font, fontScale, charset);
+    // Face reads the outlines from the file data, so glyphs are loaded before the data is released
+    bool fontLoaded = false;
+    int glyphsLoaded = 0;
+    FileSystem::ReadBytes(filepath, [&](gsl::span<const uint8_t> buffer) {
+        msdfgen::FontHandle* font = msdfgen::loadFontData(ft, buffer.data(), static_cast<int>(buffer.size()));
+        if (!font)
+            return;
+
+        double fontScale = 1.0;
+        data->fontGeometry = msdf_atlas::FontGeometry(&data->glyphs);
+        glyphsLoaded = data->fontGeometry.loadCharset(font, fontScale, charset);
+        msdfgen::destroyFont(font);
+        fontLoaded = true;
+    });
+
+    if (!fontLoaded) {
+        msdfgen::deinitializeFreetype(ft);
+        throw std::runtime_error("Font is empty");
+    }
+
+#if FUSION_DEBUG
+    FE_LOG_DEBUG("Font '{}' loaded in {}ms", filepath, (DateTime::Now() - debugStart).asMilliseconds<float>());
+#endif
+
     FE_LOG_INFO("Loaded {} glyphs from font (out of {})", glyphsLoaded, charset.size());
 
     double emSize = 40.0;
@@ -146,8 +155,9 @@ void Font::loadFromFile() {
     }
 
     atlasTexture = CreateAndCacheAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>(data->glyphs, width, height);
+    if (atlasTexture)
+        atlasTexture->getBindlessIndex();
 
-    msdfgen::destroyFont(font);
     msdfgen::deinitializeFreetype(ft);
 
     loaded = true;
@@ -2,9 +2,9 @@
 #include "msdf.h"
 #include "font.h"
 
+#include "fusion/graphics/graphics.h"
 #include "fusion/graphics/commands/command_buffer.h"
-#include "fusion/scene/scene_manager.h"
-#include "fusion/scene/components.h"
+#include "fusion/graphics/render_snapshot.h"
 
 using namespace fe;
 
@@ -21,19 +21,18 @@ TextSubrender::TextSubrender(Pipeline::Stage pipelineStage)
                VK_CULL_MODE_FRONT_BIT,
                VK_FRONT_FACE_CLOCKWISE}
     , descriptorSet{pipeline} {
+    texturesHandle = pipeline.getShader().getDescriptorHandle("textures");
 }
 
 void TextSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) {
-    auto scene = SceneManager::Get()->getScene();
-    if (!scene)
+    const auto& snapshot = Graphics::Get()->getSnapshot();
+    if (!snapshot.hasScene())
         return;
 
-    auto camera = overrideCamera ? overrideCamera : scene->getCamera();
+    auto camera = overrideCamera ? overrideCamera : snapshot.getCamera();
     if (!camera)
         return;
 
-    auto& registry = scene->getRegistry();
-
     // Update uniforms
     pushObject.push("projection", camera->getProjectionMatrix());
     pushObject.push("view", camera->getViewMatrix());
@@ -42,16 +41,8 @@ void TextSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* o
     descriptorSet.push("PushObject", pushObject);
     //descriptorSet.push("samplerFont", fontAtlas.get());
 
-    bindlessDescriptors.clear();
-
-    auto view = registry.view<TextComponent>();
-
-    float id = 0.0f;
-    for (const auto& [entity, text]: view.each()) {
-        if (text.font) if (bindlessDescriptors.emplace(text.font->getAtlasTexture(), id).second) ++id;
-    }
-
-    descriptorSet.push("textures", bindlessDescriptors.keys());
+    // Font atlases keep their slots in the global table, so the array is only written when the table changes
+    descriptorSet.push(texturesHandle, snapshot.getBindlessTable());
 
     if (!descriptorSet.update(pipeline))
         return;
@@ -64,18 +55,27 @@ void TextSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* o
     vertexBuffer.clear();
     indexBuffer.clear();
 
-    auto group = registry.group<TextComponent>(entt::get<TransformComponent>);
+    //const auto& frustum = camera->getFrustum();
+    const auto& eyePoint = camera->getEyePoint();
 
-    group.sort([&registry](const entt::entity a, const entt::entity b) {
-        return registry.get<TextComponent>(a).font < registry.get<TextComponent>(b).font;
-    });
+    // Glyphs are blended, so texts are built back to front
+    const auto& texts = snapshot.getTexts();
+    renderQueue.clear();
 
-    //const auto& frustum = camera->getFrustum();
+    for (const auto& [i, draw] : enumerate(texts)) {
+        const auto& font = draw.font;
+        auto depth = glm::distance2(eyePoint, draw.position);
+        auto slot = draw.atlasIndex + 1;
+        renderQueue.push(RenderQueue::TranslucentKey(0, 0, static_cast<uint32_t>(slot), RenderQueue::PointerId(font), depth), static_cast<uint32_t>(i));
+    }
+
+    renderQueue.sort();
 
-    for (const auto& [entity, text, transform] : group.each()) {
-        const auto& font = text.font;
-        if (!font)
-            continue;
+    for (const auto& item : renderQueue) {
+        const auto& text = texts[item.payload].text;
+        const auto& worldMatrix = texts[item.payload].worldMatrix;
+        const auto& font = texts[item.payload].font;
+        auto texture = static_cast<float>(texts[item.payload].atlasIndex);
 
         const auto& fontGeometry = font->getMSDFData()->fontGeometry;
         const auto& metrics = fontGeometry.getMetrics();
@@ -149,9 +149,7 @@ void TextSubrender::onRender(const CommandBuffer& commandBuffer, const Camera* o
             indexBuffer.push_back(firstIndex + 3);
 
             uint32_t color = glm::rgbaColor(text.color);
-            float texture = bindlessDescriptors[fontAtlas];
 
-            const auto& worldMatrix = transform.getWorldMatrix();
             vertexBuffer.emplace_back(worldMatrix * glm::vec4{quadMin, 0.0f, 1.0f}, color, glm::vec3{texCoordMin, texture});
             vertexBuffer.emplace_back(worldMatrix * glm::vec4{quadMin.x, quadMax.y, 0.0f, 1.0f}, color, glm::vec3{texCoordMin.x, texCoordMax.y, texture});
             vertexBuffer.emplace_back(worldMatrix * glm::vec4{quadMax, 0.0f, 1.0f}, color, glm::vec3{texCoordMax, texture});
@@ -7,6 +7,7 @@
 #include "fusion/graphics/descriptors/descriptors_handler.h"
 #include "fusion/graphics/buffers/storage_handler.h"
 #include "fusion/graphics/utils/indexed_draw_object.h"
+#include "fusion/graphics/utils/render_queue.h"
 
 namespace fe {
     struct TextVertex {
@@ -33,6 +34,8 @@ namespace fe {
         ~TextSubrender() override = default;
 
     private:
+        bool isThreadSafe() const override { return true; }
+
         void onUpdate() override {};
         void onRender(const CommandBuffer& commandBuffer, const Camera* overrideCamera) override;
 
@@ -45,6 +48,8 @@ namespace fe {
         std::vector<TextVertex> vertexBuffer;
         std::vector<uint32_t> indexBuffer;
 
-        fst::unordered_split_flatmap<const Descriptor*, float> bindlessDescriptors;
+        Shader::DescriptorHandle texturesHandle;
+
+        RenderQueue renderQueue;
     };
 }
\ No newline at end of file
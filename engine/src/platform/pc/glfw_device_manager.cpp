@@ -4,6 +4,8 @@
 #include "glfw_joystick.h"
 #include "glfw_cursor.h"
 
+#include "fusion/core/engine.h"
+
 #include <GLFW/glfw3.h>
 
 using namespace fe::glfw;
@@ -12,12 +14,20 @@ DeviceManager::DeviceManager() : fe::DeviceManager{} {
     // Set the error error callback
     glfwSetErrorCallback(ErrorCallback);
 
+    bool headless = fe::Engine::Get()->getCommandLineParser().isSet("headless");
+
+#if GLFW_VERSION_MINOR >= 4
+    // Headless rendering does not need a display server
+    if (headless)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+
     // Initialize the GLFW library
     if (glfwInit() == GLFW_FALSE)
         throw std::runtime_error("GLFW failed to initialize");
 
-    // Checks Vulkan support on GLFW
-    if (glfwVulkanSupported() == GLFW_FALSE)
+    // Checks Vulkan support on GLFW, surfaces are not created in headless mode
+    if (!headless && glfwVulkanSupported() == GLFW_FALSE)
         throw std::runtime_error("GLFW failed to find Vulkan support");
 
     // Set the monitor callback
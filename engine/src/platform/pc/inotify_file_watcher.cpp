@@ -0,0 +1,167 @@
+#include "inotify_file_watcher.h"
+
+#if FUSION_PLATFORM_LINUX
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace fe::pc;
+
+static constexpr uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+InotifyFileWatcher::InotifyFileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay)
+    : fe::FileWatcher{std::move(watchPath), std::move(changeCallback), std::move(exts), delay} {
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd == -1) {
+        FE_LOG_WARNING("inotify is not available: {}", std::strerror(errno));
+        return;
+    }
+
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd == -1 || !addWatches(watchDirectory)) {
+        if (wakeFd != -1)
+            close(wakeFd);
+        close(inotifyFd);
+        wakeFd = inotifyFd = -1;
+    }
+}
+
+InotifyFileWatcher::~InotifyFileWatcher() {
+    if (inotifyFd == -1)
+        return;
+
+    if (thread.joinable()) {
+        uint64_t value = 1;
+        write(wakeFd, &value, sizeof(value));
+        thread.join();
+    }
+
+    close(wakeFd);
+    close(inotifyFd);
+}
+
+void InotifyFileWatcher::start() {
+    thread = std::thread{&InotifyFileWatcher::onWork, this};
+}
+
+void InotifyFileWatcher::onWork() {
+    FUSION_PROFILE_SETTHREADNAME("File Watcher");
+
+    pollfd descriptors[2] = {
+        { inotifyFd, POLLIN, 0 },
+        { wakeFd, POLLIN, 0 }
+    };
+    alignas(inotify_event) char buffer[64 * 1024];
+
+    while (true) {
+        if (poll(descriptors, 2, -1) == -1) {
+            if (errno == EINTR)
+                continue;
+            FE_LOG_ERROR("inotify poll failed: {}", std::strerror(errno));
+            return;
+        }
+
+        if (descriptors[1].revents != 0)
+            return;
+
+        // Events of one read are merged, so a file written many times is compared once
+        std::set<fs::path> files;
+        std::set<fs::path> createdDirectories;
+        std::set<fs::path> removedDirectories;
+        bool overflow = false;
+
+        ssize_t size;
+        while ((size = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* it = buffer; it < buffer + size;) {
+                auto event = reinterpret_cast<const inotify_event*>(it);
+                it += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    overflow = true;
+                    continue;
+                }
+
+                if (event->mask & IN_IGNORED) {
+                    watches.erase(event->wd);
+                    continue;
+                }
+
+                auto watch = watches.find(event->wd);
+                if (watch == watches.end() || event->len == 0)
+                    continue;
+
+                auto path = watch->second / event->name;
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        createdDirectories.insert(std::move(path));
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                        removedDirectories.insert(std::move(path));
+                } else {
+                    files.insert(std::move(path));
+                }
+            }
+        }
+
+        if (overflow) {
+            FE_LOG_WARNING("inotify queue overflowed, rescanning '{}'", watchDirectory);
+            addWatches(watchDirectory);
+            rescan();
+            continue;
+        }
+
+        for (const auto& directory : removedDirectories) {
+            removeWatches(directory);
+            refreshDirectory(directory);
+        }
+
+        // Files can be created before the watch of a new directory is added, so its tree is compared as well
+        for (const auto& directory : createdDirectories) {
+            addWatches(directory);
+            refreshDirectory(directory);
+        }
+
+        for (const auto& path : files) {
+            refresh(path);
+        }
+    }
+}
+
+bool InotifyFileWatcher::addWatches(const fs::path& directory) {
+    auto addWatch = [this](const fs::path& path) {
+        auto wd = inotify_add_watch(inotifyFd, path.c_str(), WatchMask);
+        if (wd == -1) {
+            if (errno == ENOSPC) {
+                FE_LOG_WARNING("inotify watch limit reached, raise fs.inotify.max_user_watches to watch '{}'", path);
+                return false;
+            }
+            // Directory was removed meanwhile
+            return true;
+        }
+        watches[wd] = path;
+        return true;
+    };
+
+    if (!addWatch(directory))
+        return false;
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it{directory, error}, end; !error && it != end; it.increment(error)) {
+        std::error_code directoryError;
+        if (it->is_directory(directoryError) && !it->is_symlink(directoryError) && !addWatch(it->path()))
+            return false;
+    }
+    return true;
+}
+
+void InotifyFileWatcher::removeWatches(const fs::path& directory) {
+    for (auto it = watches.begin(); it != watches.end();) {
+        if (it->second == directory || IsInside(it->second, directory)) {
+            inotify_rm_watch(inotifyFd, it->first);
+            it = watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+#endif
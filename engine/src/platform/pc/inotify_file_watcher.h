@@ -0,0 +1,48 @@
+#pragma once
+
+#include "fusion/filesystem/file_watcher.h"
+
+#if FUSION_PLATFORM_LINUX
+namespace fe::pc {
+    /**
+     * @brief Watches the tree through inotify, every directory gets an own watch which are added and removed as directories
+     * come and go. Lost events after a queue overflow are recovered by a rescan of the tree.
+     */
+    class FUSION_API InotifyFileWatcher final : public fe::FileWatcher {
+    public:
+        /**
+         * Creates the instance and watches the tree, check {@link isValid} as the limit of watches can be reached.
+         */
+        InotifyFileWatcher(fs::path watchPath, FileCallback changeCallback, std::set<std::string> exts, DateTime delay);
+        ~InotifyFileWatcher() override;
+
+        bool isValid() const { return inotifyFd != -1; }
+
+        const char* getName() const override { return "inotify"; }
+
+    protected:
+        void start() override;
+
+    private:
+        void onWork();
+
+        /**
+         * Adds watches for the directory and all of its subdirectories.
+         * @param directory The path of the directory.
+         * @return False if the limit of watches was reached.
+         */
+        bool addWatches(const fs::path& directory);
+
+        /**
+         * Removes the watches of the directory and all of its subdirectories.
+         * @param directory The path of the directory.
+         */
+        void removeWatches(const fs::path& directory);
+
+        int inotifyFd{ -1 };
+        int wakeFd{ -1 }; /// Event which stops the thread.
+        std::unordered_map<int, fs::path> watches; /// Watched directories by the watch descriptor.
+        std::thread thread;
+    };
+}
+#endif
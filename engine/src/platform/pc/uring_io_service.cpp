@@ -0,0 +1,242 @@
+#include "uring_io_service.h"
+
+#if FUSION_PLATFORM_LINUX
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace fe::pc;
+
+struct UringIoService::Operation {
+    IoRequest request;
+    int fd{ -1 };
+    std::vector<uint8_t> buffer;
+    uint64_t done{ 0 }; /// Bytes read so far, reads can be short.
+    iovec vector{};
+};
+
+// liburing is not vendored, the ring is driven through the raw system calls
+static int SetupRing(uint32_t entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int EnterRing(int ringFd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+template<typename T>
+static T* RingPointer(void* ring, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+UringIoService::UringIoService(uint32_t entries) : fe::IoService{} {
+    io_uring_params params = {};
+    ringFd = SetupRing(entries, &params);
+    if (ringFd < 0) {
+        FE_LOG_WARNING("io_uring is not available: {}", std::strerror(errno));
+        ringFd = -1;
+        return;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    cqRing = singleMap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMap == MAP_FAILED) {
+        FE_LOG_WARNING("io_uring could not be mapped: {}", std::strerror(errno));
+        if (sqRing != MAP_FAILED)
+            munmap(sqRing, sqRingSize);
+        if (!singleMap && cqRing != MAP_FAILED)
+            munmap(cqRing, cqRingSize);
+        if (sqesMap != MAP_FAILED)
+            munmap(sqesMap, sqesSize);
+        sqRing = cqRing = nullptr;
+        close(ringFd);
+        ringFd = -1;
+        return;
+    }
+
+    sqes = static_cast<io_uring_sqe*>(sqesMap);
+    sqHead = RingPointer<uint32_t>(sqRing, params.sq_off.head);
+    sqTail = RingPointer<uint32_t>(sqRing, params.sq_off.tail);
+    sqArray = RingPointer<uint32_t>(sqRing, params.sq_off.array);
+    sqMask = *RingPointer<uint32_t>(sqRing, params.sq_off.ring_mask);
+    cqHead = RingPointer<uint32_t>(cqRing, params.cq_off.head);
+    cqTail = RingPointer<uint32_t>(cqRing, params.cq_off.tail);
+    cqes = RingPointer<io_uring_cqe>(cqRing, params.cq_off.cqes);
+    cqMask = *RingPointer<uint32_t>(cqRing, params.cq_off.ring_mask);
+    // Completion ring is at least as large, so it cannot overflow while reads are limited to this
+    entryCount = params.sq_entries;
+
+    thread = std::thread{&UringIoService::onWork, this};
+}
+
+UringIoService::~UringIoService() {
+    if (ringFd == -1)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_one();
+    thread.join();
+
+    munmap(sqes, sqesSize);
+    if (cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    munmap(sqRing, sqRingSize);
+    close(ringFd);
+}
+
+void UringIoService::submit(std::vector<IoRequest>&& requests) {
+    begin(requests.size());
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (auto& request : requests) {
+            queue.push(std::move(request));
+        }
+    }
+    condition.notify_one();
+}
+
+void UringIoService::onWork() {
+    FUSION_PROFILE_SETTHREADNAME("I/O");
+
+    while (true) {
+        std::vector<IoRequest> requests;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            // Thread sleeps in the kernel instead while reads are in flight
+            if (inFlight == 0)
+                condition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty() && inFlight == 0)
+                return;
+
+            while (!queue.empty() && inFlight + requests.size() < entryCount) {
+                requests.push_back(std::move(queue.front()));
+                queue.pop();
+            }
+        }
+
+        for (auto& request : requests) {
+            start(std::move(request));
+        }
+
+        if (inFlight == 0)
+            continue;
+
+        auto result = EnterRing(ringFd, unsubmitted, 1, IORING_ENTER_GETEVENTS);
+        if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            FE_LOG_ERROR("io_uring enter failed: {}", std::strerror(errno));
+        } else if (result >= 0) {
+            unsubmitted -= static_cast<uint32_t>(result);
+        }
+
+        reap();
+    }
+}
+
+void UringIoService::start(IoRequest&& request) {
+    auto operation = std::make_unique<Operation>();
+    operation->request = std::move(request);
+
+    operation->fd = open(operation->request.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (operation->fd == -1) {
+        finish(std::move(operation), errno);
+        return;
+    }
+
+    auto size = operation->request.size;
+    if (size == 0) {
+        struct stat info = {};
+        if (fstat(operation->fd, &info) != 0) {
+            finish(std::move(operation), errno);
+            return;
+        }
+        auto fileSize = static_cast<uint64_t>(info.st_size);
+        size = fileSize - std::min(operation->request.offset, fileSize);
+    }
+
+    operation->buffer.resize(static_cast<size_t>(size));
+    if (size == 0) {
+        finish(std::move(operation), 0);
+        return;
+    }
+
+    prepare(std::move(operation));
+}
+
+void UringIoService::prepare(std::unique_ptr<Operation>&& operation) {
+    operation->vector.iov_base = operation->buffer.data() + operation->done;
+    operation->vector.iov_len = operation->buffer.size() - operation->done;
+
+    // Only this thread writes the tail, the kernel moves the head
+    auto tail = *sqTail;
+    auto index = tail & sqMask;
+    auto& sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(io_uring_sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = operation->fd;
+    sqe.addr = reinterpret_cast<uint64_t>(&operation->vector);
+    sqe.len = 1;
+    sqe.off = operation->request.offset + operation->done;
+    sqe.user_data = reinterpret_cast<uint64_t>(operation.release());
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    ++inFlight;
+    ++unsubmitted;
+}
+
+void UringIoService::reap() {
+    auto head = __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+    auto tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+    std::vector<std::pair<std::unique_ptr<Operation>, int>> completed;
+    for (; head != tail; ++head) {
+        const auto& cqe = cqes[head & cqMask];
+        completed.emplace_back(reinterpret_cast<Operation*>(cqe.user_data), cqe.res);
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+    for (auto& [operation, res] : completed) {
+        --inFlight;
+        if (res < 0) {
+            finish(std::move(operation), -res);
+        } else if (res == 0) {
+            // End of the file was reached before the requested size
+            operation->buffer.resize(static_cast<size_t>(operation->done));
+            finish(std::move(operation), 0);
+        } else {
+            operation->done += static_cast<uint64_t>(res);
+            if (operation->done < operation->buffer.size())
+                prepare(std::move(operation));
+            else
+                finish(std::move(operation), 0);
+        }
+    }
+}
+
+void UringIoService::finish(std::unique_ptr<Operation>&& operation, int error) {
+    if (operation->fd != -1)
+        close(operation->fd);
+
+    IoResult result;
+    result.error = error;
+    if (error == 0)
+        result.data = std::move(operation->buffer);
+    complete(operation->request, std::move(result));
+}
+#endif
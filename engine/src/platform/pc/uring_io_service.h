@@ -0,0 +1,84 @@
+#pragma once
+
+#include "fusion/filesystem/io_service.h"
+
+#if FUSION_PLATFORM_LINUX
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace fe::pc {
+    /**
+     * @brief Reads files through an io_uring owned by a dedicated thread, all queued requests are submitted with one system call
+     * and the thread only sleeps in the kernel while reads are in flight.
+     */
+    class FUSION_API UringIoService final : public fe::IoService {
+    public:
+        /**
+         * Creates the ring, check {@link isValid} as kernels can lack or forbid io_uring.
+         * @param entries The maximum number of reads in flight.
+         */
+        explicit UringIoService(uint32_t entries = 256);
+        ~UringIoService() override;
+
+        bool isValid() const { return ringFd != -1; }
+
+        void submit(std::vector<IoRequest>&& requests) override;
+
+        const char* getName() const override { return "io_uring"; }
+
+    private:
+        struct Operation;
+
+        void onWork();
+
+        /**
+         * Opens the file of the request and queues its first read.
+         * @param request The request to start.
+         */
+        void start(IoRequest&& request);
+
+        /**
+         * Queues the read of the remaining part of an operation into the submission ring.
+         * @param operation The operation to read.
+         */
+        void prepare(std::unique_ptr<Operation>&& operation);
+
+        /**
+         * Handles the finished reads of the completion ring.
+         */
+        void reap();
+
+        void finish(std::unique_ptr<Operation>&& operation, int error);
+
+        int ringFd{ -1 };
+        void* sqRing{ nullptr };
+        void* cqRing{ nullptr };
+        size_t sqRingSize{ 0 };
+        size_t cqRingSize{ 0 };
+        io_uring_sqe* sqes{ nullptr };
+        size_t sqesSize{ 0 };
+        uint32_t* sqHead{ nullptr };
+        uint32_t* sqTail{ nullptr };
+        uint32_t* sqArray{ nullptr };
+        uint32_t sqMask{ 0 };
+        uint32_t* cqHead{ nullptr };
+        uint32_t* cqTail{ nullptr };
+        io_uring_cqe* cqes{ nullptr };
+        uint32_t cqMask{ 0 };
+        uint32_t entryCount{ 0 };
+
+        uint32_t inFlight{ 0 }; /// Reads owned by the kernel, only touched by the thread.
+        uint32_t unsubmitted{ 0 }; /// Entries written to the ring since the last enter.
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::queue<IoRequest> queue;
+        bool stopping{ false };
+    };
+}
+#endif
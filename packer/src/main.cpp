@@ -0,0 +1,46 @@
+#include "fusion/filesystem/pack_file.h"
+
+int main(int args, char** argv) {
+    using namespace fe;
+
+    auto logger = Log::Init();
+
+    // fusion-packer <output> <input>... [--level=<0-12>]
+    std::vector<std::string_view> inputs;
+    fs::path output;
+    int level = 9;
+
+    for (int i = 1; i < args; ++i) {
+        std::string_view argument{ argv[i] };
+        if (argument.rfind("--level=", 0) == 0) {
+            level = std::atoi(argv[i] + 8);
+        } else if (output.empty()) {
+            output = argument;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+
+    if (output.empty() || inputs.empty()) {
+        std::cout << "Usage: fusion-packer <output> <input>... [--level=<0-12>]\n"
+                     "Directories are packed with their name, so 'assets' is mounted as 'assets' next to the pack.\n"
+                     "Level 0 stores every file uncompressed.\n";
+        return EXIT_FAILURE;
+    }
+
+    PackBuilder builder{level};
+    for (const auto& input : inputs) {
+        fs::path path{ input };
+        if (fs::is_directory(path))
+            builder.addDirectory(path);
+        else
+            builder.addFile(path, path.filename().generic_string());
+    }
+
+    if (builder.getFileCount() == 0) {
+        FE_LOG_ERROR("Nothing to pack");
+        return EXIT_FAILURE;
+    }
+
+    return builder.write(output) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
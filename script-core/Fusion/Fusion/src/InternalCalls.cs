@@ -34,5 +34,10 @@ namespace Fusion
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static bool Input_IsKeyDown(KeyCode keycode);
 		#endregion
+
+		#region Performance
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static long Performance_GetCounter(PerfCounter counter);
+		#endregion
 	}
 }
@@ -0,0 +1,27 @@
+﻿namespace Fusion
+{
+	public enum PerfCounter : byte
+	{
+		DrawCalls,
+		Triangles,
+		PipelineBinds,
+		DescriptorWrites,
+		BufferUploads,
+		UploadedBytes,
+		RenderPasses,
+		SecondaryBuffers,
+		CulledObjects,
+		TransformUpdates,
+		AssetLoads,
+		FileReads,
+		FileReadBytes
+	}
+
+	public class Performance
+	{
+		public static long GetCounter(PerfCounter counter)
+		{
+			return InternalCalls.Performance_GetCounter(counter);
+		}
+	}
+}